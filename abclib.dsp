@@ -2035,6 +2035,10 @@ SOURCE=.\src\sat\bmc\bmcBmc3.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\sat\bmc\bmcBmc3Mt.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\sat\bmc\bmcBmcAnd.c
 # End Source File
 # Begin Source File
@@ -3751,6 +3755,10 @@ SOURCE=.\src\map\scl\sclSize.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\map\scl\sclSizeMt.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\map\scl\sclSize.h
 # End Source File
 # Begin Source File
@@ -3759,6 +3767,10 @@ SOURCE=.\src\map\scl\sclTime.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\map\scl\sclTimeMt.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\map\scl\sclUpsize.c
 # End Source File
 # Begin Source File
@@ -4099,6 +4111,14 @@ SOURCE=.\src\misc\util\utilBridge.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\misc\util\utilCache.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\misc\util\utilCache.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\misc\util\utilCex.c
 # End Source File
 # Begin Source File
@@ -4151,6 +4171,14 @@ SOURCE=.\src\misc\util\utilSignal.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\misc\util\utilSimd.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\misc\util\utilSimd.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\misc\util\utilSort.c
 # End Source File
 # Begin Source File
@@ -5043,6 +5071,10 @@ SOURCE=.\src\aig\gia\giaHash.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\aig\gia\giaHashMt.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\aig\gia\giaIf.c
 # End Source File
 # Begin Source File
@@ -5627,6 +5659,10 @@ SOURCE=.\src\proof\cec\cecPat.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\proof\cec\cecPmc.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\proof\cec\cecSat.c
 # End Source File
 # Begin Source File
@@ -5991,6 +6027,10 @@ SOURCE=.\src\proof\pdr\pdrMan.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\proof\pdr\pdrMt.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\proof\pdr\pdrSat.c
 # End Source File
 # Begin Source File
@@ -21,12 +21,28 @@
 
 #include "gia.h"
 #include "misc/tim/tim.h"
+#include "misc/zlib/zlib.h"
 #include "base/main/main.h"
+#include "misc/util/utilCache.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
 
 ABC_NAMESPACE_IMPL_START
 
 #define XAIG_VERBOSE 0
 
+#define GIA_AIGER_PROC_MAX   64          // the max number of threads used by the writer
+#define GIA_AIGER_CHUNK_MIN  (1 << 16)   // the min number of nodes encoded by one thread
+#define GIA_AIGER_BLOCK      (1 << 22)   // the size of a compressed block
+
 ////////////////////////////////////////////////////////////////////////
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
@@ -173,7 +189,7 @@ Vec_Str_t * Gia_AigerWriteLiterals( Vec_Int_t * vLits )
   SeeAlso     []
 
 ***********************************************************************/
-Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fGiaSimple, int fSkipStrash, int fCheck )
+Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, size_t nFileSize, int fGiaSimple, int fSkipStrash, int fCheck )
 {
     Gia_Man_t * pNew, * pTemp;
     Vec_Ptr_t * vNamesIn = NULL, * vNamesOut = NULL, * vNamesRegIn = NULL, * vNamesRegOut = NULL, * vNamesNode = NULL;
@@ -1003,6 +1019,89 @@ Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fGiaSi
     return pNew;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Loads the AIGER file into memory.]
+
+  Description [Plain files are mapped into memory (privately, because the 
+  reader patches the symbol table in place), so that the pages are paged 
+  in while the AND section is decoded and no second copy of the file is 
+  made. Gzipped files are decompressed into a buffer allocated once using 
+  the uncompressed size recorded in the gzip trailer. Returns the size of 
+  the contents in pnSize and sets pfMapped if the buffer is a mapping.]
+  
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+char * Gia_AigerLoadFileGz( char * pFileName, size_t * pnSize )
+{
+    gzFile pFile;
+    FILE * pFileRaw;
+    unsigned char Trailer[4];
+    char * pContents;
+    size_t nAlloc = 0, nSize = 0;
+    int nRead;
+    // the last four bytes contain the uncompressed size modulo 2^32
+    pFileRaw = fopen( pFileName, "rb" );
+    if ( pFileRaw == NULL )
+    {
+        printf( "Gia_AigerLoadFileGz(): The file is unavailable (absent or open).\n" );
+        return NULL;
+    }
+    if ( fseek( pFileRaw, -4, SEEK_END ) == 0 && fread( Trailer, 1, 4, pFileRaw ) == 4 )
+        nAlloc = (size_t)Trailer[0] | ((size_t)Trailer[1] << 8) | ((size_t)Trailer[2] << 16) | ((size_t)Trailer[3] << 24);
+    fclose( pFileRaw );
+    // one more byte lets the read hitting the end of the file stay within the buffer
+    nAlloc++;
+    if ( nAlloc < (1 << 16) )
+        nAlloc = (1 << 16);
+    pFile = gzopen( pFileName, "rb" );
+    if ( pFile == NULL )
+    {
+        printf( "Gia_AigerLoadFileGz(): Cannot open the file.\n" );
+        return NULL;
+    }
+    pContents = ABC_ALLOC( char, nAlloc );
+    while ( 1 )
+    {
+        if ( nSize == nAlloc ) // the trailer underestimates files over 4GB and files with several members
+        {
+            nAlloc *= 2;
+            pContents = ABC_REALLOC( char, pContents, nAlloc );
+        }
+        nRead = gzread( pFile, pContents + nSize, (unsigned)(nAlloc - nSize < (1 << 30) ? nAlloc - nSize : (1 << 30)) );
+        if ( nRead <= 0 )
+            break;
+        nSize += nRead;
+    }
+    gzclose( pFile );
+    if ( nRead < 0 )
+    {
+        printf( "Gia_AigerLoadFileGz(): Decompression has failed.\n" );
+        ABC_FREE( pContents );
+        return NULL;
+    }
+    *pnSize = nSize;
+    return pContents;
+}
+char * Gia_AigerLoadFile( char * pFileName, size_t * pnSize, int * pfMapped )
+{
+    char * pContents;
+    *pfMapped = 0;
+    if ( strlen(pFileName) > 3 && !strcmp(pFileName + strlen(pFileName) - 3, ".gz") )
+        return Gia_AigerLoadFileGz( pFileName, pnSize );
+    pContents = Util_CacheLoadFile( pFileName, pnSize, pfMapped );
+    if ( pContents == NULL )
+        printf( "Gia_AigerLoadFile(): The file is unavailable (absent, open, or empty).\n" );
+    return pContents;
+}
+void Gia_AigerUnloadFile( char * pContents, size_t nSize, int fMapped )
+{
+    Util_CacheUnloadFile( pContents, nSize, fMapped );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Reads the AIG in the binary AIGER format.]
@@ -1016,22 +1115,19 @@ Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fGiaSi
 ***********************************************************************/
 Gia_Man_t * Gia_AigerRead( char * pFileName, int fGiaSimple, int fSkipStrash, int fCheck )
 {
-    FILE * pFile;
     Gia_Man_t * pNew;
     char * pName, * pContents;
-    int nFileSize;
-    int RetValue;
+    size_t nFileSize = 0;
+    int fMapped = 0;
 
-    // read the file into the buffer
+    // load the file into memory
     Gia_FileFixName( pFileName );
-    nFileSize = Gia_FileSize( pFileName );
-    pFile = fopen( pFileName, "rb" );
-    pContents = ABC_ALLOC( char, nFileSize );
-    RetValue = fread( pContents, nFileSize, 1, pFile );
-    fclose( pFile );
+    pContents = Gia_AigerLoadFile( pFileName, &nFileSize, &fMapped );
+    if ( pContents == NULL )
+        return NULL;
 
     pNew = Gia_AigerReadFromMemory( pContents, nFileSize, fGiaSimple, fSkipStrash, fCheck );
-    ABC_FREE( pContents );
+    Gia_AigerUnloadFile( pContents, nFileSize, fMapped );
     if ( pNew )
     {
         ABC_FREE( pNew->pName );
@@ -1206,11 +1302,293 @@ Vec_Str_t * Gia_AigerWriteIntoMemoryStrPart( Gia_Man_t * p, Vec_Int_t * vCis, Ve
     return vBuffer;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Output stream of the AIGER writer.]
+
+  Description [Without compression, the data is written into the file.
+  With compression, the data is collected in blocks, one per thread.
+  When all blocks are full, they are compressed by separate threads into
+  independent gzip members, which are written into the file in the original
+  order. A sequence of members is a valid gzip file, which is decompressed 
+  by gzip, zlib, and the AIGER reader as one stream.]
+  
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+typedef struct Gia_AigerBlock_t_ Gia_AigerBlock_t;
+struct Gia_AigerBlock_t_
+{
+    unsigned char *  pIn;            // block to compress
+    size_t           nIn;            // block size
+    unsigned char *  pOut;           // compressed block
+    size_t           nOut;           // compressed size
+    size_t           nOutMax;        // compressed buffer size
+    int              fFailed;        // compression has failed
+};
+typedef struct Gia_AigerOut_t_ Gia_AigerOut_t;
+struct Gia_AigerOut_t_
+{
+    FILE *           pFile;          // output file
+    int              fCompress;      // compression is used
+    int              nProcs;         // the number of threads
+    int              nBlocks;        // the number of full blocks
+    int              fError;         // writing or compression has failed
+    Gia_AigerBlock_t Blocks[GIA_AIGER_PROC_MAX];
+};
+
+int Gia_AigerCompressBlock( Gia_AigerBlock_t * pBlock )
+{
+    z_stream Stream;
+    size_t nBound;
+    memset( &Stream, 0, sizeof(z_stream) );
+    if ( deflateInit2( &Stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY ) != Z_OK )
+        return 0;
+    nBound = (size_t)deflateBound( &Stream, (uLong)pBlock->nIn ) + 64;
+    if ( pBlock->nOutMax < nBound )
+    {
+        pBlock->nOutMax = nBound;
+        pBlock->pOut = ABC_REALLOC( unsigned char, pBlock->pOut, pBlock->nOutMax );
+    }
+    Stream.next_in   = pBlock->pIn;
+    Stream.avail_in  = (uInt)pBlock->nIn;
+    Stream.next_out  = pBlock->pOut;
+    Stream.avail_out = (uInt)pBlock->nOutMax;
+    if ( deflate( &Stream, Z_FINISH ) != Z_STREAM_END )
+    {
+        deflateEnd( &Stream );
+        return 0;
+    }
+    pBlock->nOut = pBlock->nOutMax - Stream.avail_out;
+    deflateEnd( &Stream );
+    return 1;
+}
+#ifdef ABC_USE_PTHREADS
+void * Gia_AigerCompressThread( void * pArg )
+{
+    Gia_AigerBlock_t * pBlock = (Gia_AigerBlock_t *)pArg;
+    pBlock->fFailed = !Gia_AigerCompressBlock( pBlock );
+    pthread_exit( NULL );
+    return NULL;
+}
+#endif
+void Gia_AigerOutFlush( Gia_AigerOut_t * p )
+{
+    int k, nBlocks = p->nBlocks + (p->Blocks[p->nBlocks].nIn > 0);
+    if ( nBlocks == 0 )
+        return;
+#ifdef ABC_USE_PTHREADS
+    if ( nBlocks > 1 )
+    {
+        pthread_t WorkerThread[GIA_AIGER_PROC_MAX];
+        for ( k = 0; k < nBlocks; k++ )
+        {
+            int status = pthread_create( WorkerThread + k, NULL, Gia_AigerCompressThread, (void *)(p->Blocks + k) );
+            assert( status == 0 );
+        }
+        for ( k = 0; k < nBlocks; k++ )
+            pthread_join( WorkerThread[k], NULL );
+    }
+    else
+#endif
+    for ( k = 0; k < nBlocks; k++ )
+        p->Blocks[k].fFailed = !Gia_AigerCompressBlock( p->Blocks + k );
+    for ( k = 0; k < nBlocks; k++ )
+    {
+        if ( p->Blocks[k].fFailed )
+            p->fError = 1;
+        else if ( !p->fError && fwrite( p->Blocks[k].pOut, 1, p->Blocks[k].nOut, p->pFile ) != p->Blocks[k].nOut )
+            p->fError = 1;
+        p->Blocks[k].nIn = 0;
+    }
+    p->nBlocks = 0;
+}
+Gia_AigerOut_t * Gia_AigerOutStart( char * pFileName, int fCompress, int nProcs )
+{
+    Gia_AigerOut_t * p;
+    FILE * pFile = fopen( pFileName, "wb" );
+    if ( pFile == NULL )
+        return NULL;
+    p = ABC_CALLOC( Gia_AigerOut_t, 1 );
+    p->pFile     = pFile;
+    p->fCompress = fCompress;
+    p->nProcs    = Abc_MaxInt( 1, Abc_MinInt(nProcs, GIA_AIGER_PROC_MAX) );
+    return p;
+}
+void Gia_AigerOutWrite( Gia_AigerOut_t * p, void * pData, size_t nSize )
+{
+    unsigned char * pChars = (unsigned char *)pData;
+    size_t nCopy;
+    if ( !p->fCompress )
+    {
+        if ( fwrite( pChars, 1, nSize, p->pFile ) != nSize )
+            p->fError = 1;
+        return;
+    }
+    while ( nSize > 0 )
+    {
+        Gia_AigerBlock_t * pBlock = p->Blocks + p->nBlocks;
+        if ( pBlock->pIn == NULL )
+            pBlock->pIn = ABC_ALLOC( unsigned char, GIA_AIGER_BLOCK );
+        nCopy = GIA_AIGER_BLOCK - pBlock->nIn;
+        if ( nCopy > nSize )
+            nCopy = nSize;
+        memcpy( pBlock->pIn + pBlock->nIn, pChars, nCopy );
+        pBlock->nIn += nCopy;
+        pChars += nCopy;
+        nSize -= nCopy;
+        if ( pBlock->nIn < GIA_AIGER_BLOCK )
+            continue;
+        if ( ++p->nBlocks == p->nProcs )
+            Gia_AigerOutFlush( p );
+    }
+}
+void Gia_AigerOutPrintF( Gia_AigerOut_t * p, const char * pFormat, ... )
+{
+    char Buffer[1000], * pBuffer = Buffer;
+    int nSize;
+    va_list args;
+    va_start( args, pFormat );
+    nSize = vsnprintf( Buffer, sizeof(Buffer), pFormat, args );
+    va_end( args );
+    if ( nSize >= (int)sizeof(Buffer) )
+    {
+        pBuffer = ABC_ALLOC( char, nSize + 1 );
+        va_start( args, pFormat );
+        vsnprintf( pBuffer, nSize + 1, pFormat, args );
+        va_end( args );
+    }
+    if ( nSize > 0 )
+        Gia_AigerOutWrite( p, pBuffer, nSize );
+    if ( pBuffer != Buffer )
+        ABC_FREE( pBuffer );
+}
+void Gia_AigerOutWriteSize( Gia_AigerOut_t * p, int nSize )
+{
+    unsigned char Buffer[5];
+    Gia_AigerWriteInt( Buffer, nSize );
+    Gia_AigerOutWrite( p, Buffer, 4 );
+}
+int Gia_AigerOutStop( Gia_AigerOut_t * p )
+{
+    int k, RetValue;
+    if ( p->fCompress )
+        Gia_AigerOutFlush( p );
+    if ( fclose( p->pFile ) != 0 )
+        p->fError = 1;
+    for ( k = 0; k < GIA_AIGER_PROC_MAX; k++ )
+    {
+        ABC_FREE( p->Blocks[k].pIn );
+        ABC_FREE( p->Blocks[k].pOut );
+    }
+    RetValue = !p->fError;
+    ABC_FREE( p );
+    return RetValue;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Encodes the AND section of the normalized AIG.]
+
+  Description [The delta encoding of each node depends only on its own 
+  literals, so the object range is split into chunks encoded by separate 
+  threads into private buffers, which are written in the original order.
+  Each node takes at most 10 bytes, so the buffers never overflow.]
+  
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+typedef struct Gia_AigerThData_t_ Gia_AigerThData_t;
+struct Gia_AigerThData_t_
+{
+    Gia_Man_t *      p;              // AIG to encode
+    int              iStart;         // first object
+    int              iStop;          // last object + 1
+    unsigned char *  pOut;           // output buffer
+    size_t           nOut;           // output size
+    size_t           nOutMax;        // output buffer size
+};
+
+size_t Gia_AigerWriteAndsRange( Gia_Man_t * p, int iStart, int iStop, unsigned char * pBuffer )
+{
+    Gia_Obj_t * pObj;
+    size_t Pos = 0;
+    unsigned uLit0, uLit1, uLit;
+    int i;
+    for ( i = iStart; i < iStop; i++ )
+    {
+        pObj = Gia_ManObj( p, i );
+        if ( !Gia_ObjIsAnd(pObj) )
+            continue;
+        uLit  = Abc_Var2Lit( i, 0 );
+        uLit0 = Gia_ObjFaninLit0( pObj, i );
+        uLit1 = Gia_ObjFaninLit1( pObj, i );
+        assert( p->fGiaSimple || Gia_ManBufNum(p) || uLit0 < uLit1 );
+        // the offset is added to the pointer, because the chunk may exceed 2GB
+        Pos += Gia_AigerWriteUnsignedBuffer( pBuffer + Pos, 0, uLit  - uLit1 );
+        Pos += Gia_AigerWriteUnsignedBuffer( pBuffer + Pos, 0, uLit1 - uLit0 );
+    }
+    return Pos;
+}
+#ifdef ABC_USE_PTHREADS
+void * Gia_AigerWriteAndsThread( void * pArg )
+{
+    Gia_AigerThData_t * pThData = (Gia_AigerThData_t *)pArg;
+    pThData->nOut = Gia_AigerWriteAndsRange( pThData->p, pThData->iStart, pThData->iStop, pThData->pOut );
+    pthread_exit( NULL );
+    return NULL;
+}
+#endif
+void Gia_AigerWriteAnds( Gia_Man_t * p, Gia_AigerOut_t * pOut, int nProcs )
+{
+    Gia_AigerThData_t ThData[GIA_AIGER_PROC_MAX];
+    int k, iFirst = 1 + Gia_ManCiNum(p), nChunk;
+    nProcs = Abc_MinInt( nProcs, GIA_AIGER_PROC_MAX );
+    if ( nProcs < 2 || Gia_ManAndNum(p) < GIA_AIGER_CHUNK_MIN * nProcs )
+        nProcs = 1;
+    nChunk = (Gia_ManAndNum(p) + nProcs - 1) / nProcs;
+    for ( k = 0; k < nProcs; k++ )
+    {
+        ThData[k].p       = p;
+        ThData[k].iStart  = Abc_MinInt( iFirst + k * nChunk, iFirst + Gia_ManAndNum(p) );
+        ThData[k].iStop   = Abc_MinInt( iFirst + (k + 1) * nChunk, iFirst + Gia_ManAndNum(p) );
+        ThData[k].nOutMax = (size_t)10 * (ThData[k].iStop - ThData[k].iStart) + 16;
+        ThData[k].pOut    = ABC_ALLOC( unsigned char, ThData[k].nOutMax );
+    }
+#ifdef ABC_USE_PTHREADS
+    if ( nProcs > 1 )
+    {
+        pthread_t WorkerThread[GIA_AIGER_PROC_MAX];
+        for ( k = 0; k < nProcs; k++ )
+        {
+            int status = pthread_create( WorkerThread + k, NULL, Gia_AigerWriteAndsThread, (void *)(ThData + k) );
+            assert( status == 0 );
+        }
+        for ( k = 0; k < nProcs; k++ )
+            pthread_join( WorkerThread[k], NULL );
+    }
+    else
+#endif
+    for ( k = 0; k < nProcs; k++ )
+        ThData[k].nOut = Gia_AigerWriteAndsRange( p, ThData[k].iStart, ThData[k].iStop, ThData[k].pOut );
+    for ( k = 0; k < nProcs; k++ )
+    {
+        assert( ThData[k].nOut <= ThData[k].nOutMax );
+        Gia_AigerOutWrite( pOut, ThData[k].pOut, ThData[k].nOut );
+        ABC_FREE( ThData[k].pOut );
+    }
+}
+
 /**Function*************************************************************
 
   Synopsis    [Writes the AIG in the binary AIGER format.]
 
-  Description []
+  Description [If the file name ends with ".gz", the output is compressed. 
+  The AND section and the compression use up to nProcs threads.]
   
   SideEffects []
 
@@ -1218,15 +1596,17 @@ Vec_Str_t * Gia_AigerWriteIntoMemoryStrPart( Gia_Man_t * p, Vec_Int_t * vCis, Ve
 
 ***********************************************************************/
 void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int fCompact, int fWriteNewLine )
+{
+    Gia_AigerWriteMt( pInit, pFileName, fWriteSymbols, fCompact, fWriteNewLine, 1 );
+}
+void Gia_AigerWriteMt( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int fCompact, int fWriteNewLine, int nProcs )
 {
     int fVerbose = XAIG_VERBOSE;
-    FILE * pFile;
+    Gia_AigerOut_t * pOut;
     Gia_Man_t * p;
     Gia_Obj_t * pObj;
     Vec_Str_t * vStrExt;
-    int i, nBufferSize, Pos;
-    unsigned char * pBuffer;
-    unsigned uLit0, uLit1, uLit;
+    int i, fCompress = strlen(pFileName) > 3 && !strcmp(pFileName + strlen(pFileName) - 3, ".gz");
     assert( pInit->nXors == 0 && pInit->nMuxes == 0 );
 
     if ( Gia_ManCoNum(pInit) == 0 )
@@ -1236,8 +1616,8 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
     }
 
     // start the output stream
-    pFile = fopen( pFileName, "wb" );
-    if ( pFile == NULL )
+    pOut = Gia_AigerOutStart( pFileName, fCompress, nProcs );
+    if ( pOut == NULL )
     {
         fprintf( stdout, "Gia_AigerWrite(): Cannot open the output file \"%s\".\n", pFileName );
         return;
@@ -1257,7 +1637,7 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
         p = pInit;
 
     // write the header "M I L O A" where M = I + L + A
-    fprintf( pFile, "aig%s %u %u %u %u %u", 
+    Gia_AigerOutPrintF( pOut, "aig%s %u %u %u %u %u", 
         fCompact? "2" : "",
         Gia_ManCiNum(p) + Gia_ManAndNum(p), 
         Gia_ManPiNum(p),
@@ -1266,55 +1646,31 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
         Gia_ManAndNum(p) );
     // write the extended header "B C J F"
     if ( Gia_ManConstrNum(p) )
-        fprintf( pFile, " %u %u", Gia_ManPoNum(p) - Gia_ManConstrNum(p), Gia_ManConstrNum(p) );
-    fprintf( pFile, "\n" ); 
+        Gia_AigerOutPrintF( pOut, " %u %u", Gia_ManPoNum(p) - Gia_ManConstrNum(p), Gia_ManConstrNum(p) );
+    Gia_AigerOutPrintF( pOut, "\n" ); 
 
     Gia_ManInvertConstraints( p );
     if ( !fCompact ) 
     {
         // write latch drivers
         Gia_ManForEachRi( p, pObj, i )
-            fprintf( pFile, "%u\n", Gia_ObjFaninLit0p(p, pObj) );
+            Gia_AigerOutPrintF( pOut, "%u\n", Gia_ObjFaninLit0p(p, pObj) );
         // write PO drivers
         Gia_ManForEachPo( p, pObj, i )
-            fprintf( pFile, "%u\n", Gia_ObjFaninLit0p(p, pObj) );
+            Gia_AigerOutPrintF( pOut, "%u\n", Gia_ObjFaninLit0p(p, pObj) );
     }
     else
     {
         Vec_Int_t * vLits = Gia_AigerCollectLiterals( p );
         Vec_Str_t * vBinary = Gia_AigerWriteLiterals( vLits );
-        fwrite( Vec_StrArray(vBinary), 1, Vec_StrSize(vBinary), pFile );
+        Gia_AigerOutWrite( pOut, Vec_StrArray(vBinary), Vec_StrSize(vBinary) );
         Vec_StrFree( vBinary );
         Vec_IntFree( vLits );
     }
     Gia_ManInvertConstraints( p );
 
-    // write the nodes into the buffer
-    Pos = 0;
-    nBufferSize = 8 * Gia_ManAndNum(p) + 100; // skeptically assuming 3 chars per one AIG edge
-    pBuffer = ABC_ALLOC( unsigned char, nBufferSize );
-    Gia_ManForEachAnd( p, pObj, i )
-    {
-        uLit  = Abc_Var2Lit( i, 0 );
-        uLit0 = Gia_ObjFaninLit0( pObj, i );
-        uLit1 = Gia_ObjFaninLit1( pObj, i );
-        assert( p->fGiaSimple || Gia_ManBufNum(p) || uLit0 < uLit1 );
-        Pos = Gia_AigerWriteUnsignedBuffer( pBuffer, Pos, uLit  - uLit1 );
-        Pos = Gia_AigerWriteUnsignedBuffer( pBuffer, Pos, uLit1 - uLit0 );
-        if ( Pos > nBufferSize - 10 )
-        {
-            printf( "Gia_AigerWrite(): AIGER generation has failed because the allocated buffer is too small.\n" );
-            fclose( pFile );
-            if ( p != pInit )
-                Gia_ManStop( p );
-            return;
-        }
-    }
-    assert( Pos < nBufferSize );
-
-    // write the buffer
-    fwrite( pBuffer, 1, Pos, pFile );
-    ABC_FREE( pBuffer );
+    // write the nodes
+    Gia_AigerWriteAnds( p, pOut, nProcs );
 
     // write the symbol table
     if ( p->vNamesIn && p->vNamesOut )
@@ -1323,13 +1679,13 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
         assert( Vec_PtrSize(p->vNamesOut) == Gia_ManCoNum(p) );
         // write PIs
         Gia_ManForEachPi( p, pObj, i )
-            fprintf( pFile, "i%d %s\n", i, (char *)Vec_PtrEntry(p->vNamesIn, i) );
+            Gia_AigerOutPrintF( pOut, "i%d %s\n", i, (char *)Vec_PtrEntry(p->vNamesIn, i) );
         // write latches
         Gia_ManForEachRo( p, pObj, i )
-            fprintf( pFile, "l%d %s\n", i, (char *)Vec_PtrEntry(p->vNamesIn, Gia_ManPiNum(p) + i) );
+            Gia_AigerOutPrintF( pOut, "l%d %s\n", i, (char *)Vec_PtrEntry(p->vNamesIn, Gia_ManPiNum(p) + i) );
         // write POs
         Gia_ManForEachPo( p, pObj, i )
-            fprintf( pFile, "o%d %s\n", i, (char *)Vec_PtrEntry(p->vNamesOut, i) );
+            Gia_AigerOutPrintF( pOut, "o%d %s\n", i, (char *)Vec_PtrEntry(p->vNamesOut, i) );
     }
     if ( p->vNamesNode && Vec_PtrSize(p->vNamesNode) != Gia_ManObjNum(p) )
         Abc_Print( 0, "The size of the node name array does not match the number of objects. Names are not written.\n" );
@@ -1337,38 +1693,38 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
     {
         Gia_ManForEachAnd( p, pObj, i )
             if ( Vec_PtrEntry(p->vNamesNode, i) )
-                fprintf( pFile, "n%d %s\n", i, (char *)Vec_PtrEntry(p->vNamesNode, i) );
+                Gia_AigerOutPrintF( pOut, "n%d %s\n", i, (char *)Vec_PtrEntry(p->vNamesNode, i) );
     }
 
     // write the comment
     if ( fWriteNewLine ) 
-        fprintf( pFile, "c\n" );
+        Gia_AigerOutPrintF( pOut, "c\n" );
     else
-        fprintf( pFile, "c" );
+        Gia_AigerOutPrintF( pOut, "c" );
 
     // write additional AIG
     if ( p->pAigExtra )
     {
-        fprintf( pFile, "a" );
+        Gia_AigerOutPrintF( pOut, "a" );
         vStrExt = Gia_AigerWriteIntoMemoryStr( p->pAigExtra );
-        Gia_FileWriteBufferSize( pFile, Vec_StrSize(vStrExt) );
-        fwrite( Vec_StrArray(vStrExt), 1, Vec_StrSize(vStrExt), pFile );
+        Gia_AigerOutWriteSize( pOut, Vec_StrSize(vStrExt) );
+        Gia_AigerOutWrite( pOut, Vec_StrArray(vStrExt), Vec_StrSize(vStrExt) );
         Vec_StrFree( vStrExt );
         if ( fVerbose ) printf( "Finished writing extension \"a\".\n" );
     }
     // write constraints
     if ( p->nConstrs )
     {
-        fprintf( pFile, "c" );
-        Gia_FileWriteBufferSize( pFile, 4 );
-        Gia_FileWriteBufferSize( pFile, p->nConstrs );
+        Gia_AigerOutPrintF( pOut, "c" );
+        Gia_AigerOutWriteSize( pOut, 4 );
+        Gia_AigerOutWriteSize( pOut, p->nConstrs );
     }
     // write timing information
     if ( p->nAnd2Delay )
     {
-        fprintf( pFile, "d" );
-        Gia_FileWriteBufferSize( pFile, 4 );
-        Gia_FileWriteBufferSize( pFile, p->nAnd2Delay );
+        Gia_AigerOutPrintF( pOut, "d" );
+        Gia_AigerOutWriteSize( pOut, 4 );
+        Gia_AigerOutWriteSize( pOut, p->nAnd2Delay );
     }
     if ( p->pManTime )
     {
@@ -1376,18 +1732,18 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
         pTimes = Tim_ManGetArrTimes( (Tim_Man_t *)p->pManTime );
         if ( pTimes )
         {
-            fprintf( pFile, "i" );
-            Gia_FileWriteBufferSize( pFile, 4*Tim_ManPiNum((Tim_Man_t *)p->pManTime) );
-            fwrite( pTimes, 1, 4*Tim_ManPiNum((Tim_Man_t *)p->pManTime), pFile );
+            Gia_AigerOutPrintF( pOut, "i" );
+            Gia_AigerOutWriteSize( pOut, 4*Tim_ManPiNum((Tim_Man_t *)p->pManTime) );
+            Gia_AigerOutWrite( pOut, pTimes, 4*Tim_ManPiNum((Tim_Man_t *)p->pManTime) );
             ABC_FREE( pTimes );
             if ( fVerbose ) printf( "Finished writing extension \"i\".\n" );
         }
         pTimes = Tim_ManGetReqTimes( (Tim_Man_t *)p->pManTime );
         if ( pTimes )
         {
-            fprintf( pFile, "o" );
-            Gia_FileWriteBufferSize( pFile, 4*Tim_ManPoNum((Tim_Man_t *)p->pManTime) );
-            fwrite( pTimes, 1, 4*Tim_ManPoNum((Tim_Man_t *)p->pManTime), pFile );
+            Gia_AigerOutPrintF( pOut, "o" );
+            Gia_AigerOutWriteSize( pOut, 4*Tim_ManPoNum((Tim_Man_t *)p->pManTime) );
+            Gia_AigerOutWrite( pOut, pTimes, 4*Tim_ManPoNum((Tim_Man_t *)p->pManTime) );
             ABC_FREE( pTimes );
             if ( fVerbose ) printf( "Finished writing extension \"o\".\n" );
         }
@@ -1396,35 +1752,35 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
     if ( p->pReprs && p->pNexts )
     {
         extern Vec_Str_t * Gia_WriteEquivClasses( Gia_Man_t * p );
-        fprintf( pFile, "e" );
+        Gia_AigerOutPrintF( pOut, "e" );
         vStrExt = Gia_WriteEquivClasses( p );
-        Gia_FileWriteBufferSize( pFile, Vec_StrSize(vStrExt) );
-        fwrite( Vec_StrArray(vStrExt), 1, Vec_StrSize(vStrExt), pFile );
+        Gia_AigerOutWriteSize( pOut, Vec_StrSize(vStrExt) );
+        Gia_AigerOutWrite( pOut, Vec_StrArray(vStrExt), Vec_StrSize(vStrExt) );
         Vec_StrFree( vStrExt );
     }
     // write flop classes
     if ( p->vFlopClasses )
     {
-        fprintf( pFile, "f" );
-        Gia_FileWriteBufferSize( pFile, 4*Gia_ManRegNum(p) );
+        Gia_AigerOutPrintF( pOut, "f" );
+        Gia_AigerOutWriteSize( pOut, 4*Gia_ManRegNum(p) );
         assert( Vec_IntSize(p->vFlopClasses) == Gia_ManRegNum(p) );
-        fwrite( Vec_IntArray(p->vFlopClasses), 1, 4*Gia_ManRegNum(p), pFile );
+        Gia_AigerOutWrite( pOut, Vec_IntArray(p->vFlopClasses), 4*Gia_ManRegNum(p) );
     }
     // write gate classes
     if ( p->vGateClasses )
     {
-        fprintf( pFile, "g" );
-        Gia_FileWriteBufferSize( pFile, 4*Gia_ManObjNum(p) );
+        Gia_AigerOutPrintF( pOut, "g" );
+        Gia_AigerOutWriteSize( pOut, 4*Gia_ManObjNum(p) );
         assert( Vec_IntSize(p->vGateClasses) == Gia_ManObjNum(p) );
-        fwrite( Vec_IntArray(p->vGateClasses), 1, 4*Gia_ManObjNum(p), pFile );
+        Gia_AigerOutWrite( pOut, Vec_IntArray(p->vGateClasses), 4*Gia_ManObjNum(p) );
     }
     // write hierarchy info
     if ( p->pManTime )
     {
-        fprintf( pFile, "h" );
+        Gia_AigerOutPrintF( pOut, "h" );
         vStrExt = Tim_ManSave( (Tim_Man_t *)p->pManTime, 1 );
-        Gia_FileWriteBufferSize( pFile, Vec_StrSize(vStrExt) );
-        fwrite( Vec_StrArray(vStrExt), 1, Vec_StrSize(vStrExt), pFile );
+        Gia_AigerOutWriteSize( pOut, Vec_StrSize(vStrExt) );
+        Gia_AigerOutWrite( pOut, Vec_StrArray(vStrExt), Vec_StrSize(vStrExt) );
         Vec_StrFree( vStrExt );
         if ( fVerbose ) printf( "Finished writing extension \"h\".\n" );
     }
@@ -1432,10 +1788,10 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
     if ( p->vPacking )
     {
         extern Vec_Str_t * Gia_WritePacking( Vec_Int_t * vPacking );
-        fprintf( pFile, "k" );
+        Gia_AigerOutPrintF( pOut, "k" );
         vStrExt = Gia_WritePacking( p->vPacking );
-        Gia_FileWriteBufferSize( pFile, Vec_StrSize(vStrExt) );
-        fwrite( Vec_StrArray(vStrExt), 1, Vec_StrSize(vStrExt), pFile );
+        Gia_AigerOutWriteSize( pOut, Vec_StrSize(vStrExt) );
+        Gia_AigerOutWrite( pOut, Vec_StrArray(vStrExt), Vec_StrSize(vStrExt) );
         Vec_StrFree( vStrExt );
         if ( fVerbose ) printf( "Finished writing extension \"k\".\n" );
     }
@@ -1444,11 +1800,11 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
     {
         Vec_Int_t * vPairs = Gia_ManEdgeToArray( p );
         int i;
-        fprintf( pFile, "w" );
-        Gia_FileWriteBufferSize( pFile, 4*(Vec_IntSize(vPairs)+1) );
-        Gia_FileWriteBufferSize( pFile, Vec_IntSize(vPairs)/2 );
+        Gia_AigerOutPrintF( pOut, "w" );
+        Gia_AigerOutWriteSize( pOut, 4*(Vec_IntSize(vPairs)+1) );
+        Gia_AigerOutWriteSize( pOut, Vec_IntSize(vPairs)/2 );
         for ( i = 0; i < Vec_IntSize(vPairs); i++ )
-            Gia_FileWriteBufferSize( pFile, Vec_IntEntry(vPairs, i) );
+            Gia_AigerOutWriteSize( pOut, Vec_IntEntry(vPairs, i) );
         Vec_IntFree( vPairs );
     }
     // write mapping
@@ -1457,109 +1813,110 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
         extern Vec_Str_t * Gia_AigerWriteMapping( Gia_Man_t * p );
         extern Vec_Str_t * Gia_AigerWriteMappingSimple( Gia_Man_t * p );
         extern Vec_Str_t * Gia_AigerWriteMappingDoc( Gia_Man_t * p );
-        fprintf( pFile, "m" );
+        Gia_AigerOutPrintF( pOut, "m" );
         vStrExt = Gia_AigerWriteMappingDoc( p );
-        Gia_FileWriteBufferSize( pFile, Vec_StrSize(vStrExt) );
-        fwrite( Vec_StrArray(vStrExt), 1, Vec_StrSize(vStrExt), pFile );
+        Gia_AigerOutWriteSize( pOut, Vec_StrSize(vStrExt) );
+        Gia_AigerOutWrite( pOut, Vec_StrArray(vStrExt), Vec_StrSize(vStrExt) );
         Vec_StrFree( vStrExt );
         if ( fVerbose ) printf( "Finished writing extension \"m\".\n" );
     }
     // write placement
     if ( p->pPlacement )
     {
-        fprintf( pFile, "p" );
-        Gia_FileWriteBufferSize( pFile, 4*Gia_ManObjNum(p) );
-        fwrite( p->pPlacement, 1, 4*Gia_ManObjNum(p), pFile );
+        Gia_AigerOutPrintF( pOut, "p" );
+        Gia_AigerOutWriteSize( pOut, 4*Gia_ManObjNum(p) );
+        Gia_AigerOutWrite( pOut, p->pPlacement, 4*Gia_ManObjNum(p) );
     }
     // write register classes
     if ( p->vRegClasses )
     {
         int i;
-        fprintf( pFile, "r" );
-        Gia_FileWriteBufferSize( pFile, 4*(Vec_IntSize(p->vRegClasses)+1) );
-        Gia_FileWriteBufferSize( pFile, Vec_IntSize(p->vRegClasses) );
+        Gia_AigerOutPrintF( pOut, "r" );
+        Gia_AigerOutWriteSize( pOut, 4*(Vec_IntSize(p->vRegClasses)+1) );
+        Gia_AigerOutWriteSize( pOut, Vec_IntSize(p->vRegClasses) );
         for ( i = 0; i < Vec_IntSize(p->vRegClasses); i++ )
-            Gia_FileWriteBufferSize( pFile, Vec_IntEntry(p->vRegClasses, i) );
+            Gia_AigerOutWriteSize( pOut, Vec_IntEntry(p->vRegClasses, i) );
     }
     // write register inits
     if ( p->vRegInits )
     {
         int i;
-        fprintf( pFile, "s" );
-        Gia_FileWriteBufferSize( pFile, 4*(Vec_IntSize(p->vRegInits)+1) );
-        Gia_FileWriteBufferSize( pFile, Vec_IntSize(p->vRegInits) );
+        Gia_AigerOutPrintF( pOut, "s" );
+        Gia_AigerOutWriteSize( pOut, 4*(Vec_IntSize(p->vRegInits)+1) );
+        Gia_AigerOutWriteSize( pOut, Vec_IntSize(p->vRegInits) );
         for ( i = 0; i < Vec_IntSize(p->vRegInits); i++ )
-            Gia_FileWriteBufferSize( pFile, Vec_IntEntry(p->vRegInits, i) );
+            Gia_AigerOutWriteSize( pOut, Vec_IntEntry(p->vRegInits, i) );
     }
     // write configuration data
     if ( p->vConfigs )
     {
-        fprintf( pFile, "b" );
+        Gia_AigerOutPrintF( pOut, "b" );
         assert( p->pCellStr != NULL );
-        Gia_FileWriteBufferSize( pFile, 4*Vec_IntSize(p->vConfigs) + strlen(p->pCellStr) + 1 );
-        fwrite( p->pCellStr, 1, strlen(p->pCellStr) + 1, pFile );
-//        fwrite( Vec_IntArray(p->vConfigs), 1, 4*Vec_IntSize(p->vConfigs), pFile );
+        Gia_AigerOutWriteSize( pOut, 4*Vec_IntSize(p->vConfigs) + strlen(p->pCellStr) + 1 );
+        Gia_AigerOutWrite( pOut, p->pCellStr, strlen(p->pCellStr) + 1 );
+//        Gia_AigerOutWrite( pOut, Vec_IntArray(p->vConfigs), 4*Vec_IntSize(p->vConfigs) );
         for ( i = 0; i < Vec_IntSize(p->vConfigs); i++ )
-            Gia_FileWriteBufferSize( pFile, Vec_IntEntry(p->vConfigs, i) );
+            Gia_AigerOutWriteSize( pOut, Vec_IntEntry(p->vConfigs, i) );
     }
     // write choices
     if ( Gia_ManHasChoices(p) )
     {
         int i, nPairs = 0;
-        fprintf( pFile, "q" );
+        Gia_AigerOutPrintF( pOut, "q" );
         for ( i = 0; i < Gia_ManObjNum(p); i++ )
             nPairs += (Gia_ObjSibl(p, i) > 0);
-        Gia_FileWriteBufferSize( pFile, 4*(nPairs * 2 + 1) );
-        Gia_FileWriteBufferSize( pFile, nPairs );
+        Gia_AigerOutWriteSize( pOut, 4*(nPairs * 2 + 1) );
+        Gia_AigerOutWriteSize( pOut, nPairs );
         for ( i = 0; i < Gia_ManObjNum(p); i++ )
             if ( Gia_ObjSibl(p, i) )
             {
                 assert( i > Gia_ObjSibl(p, i) );
-                Gia_FileWriteBufferSize( pFile, i );
-                Gia_FileWriteBufferSize( pFile, Gia_ObjSibl(p, i) );
+                Gia_AigerOutWriteSize( pOut, i );
+                Gia_AigerOutWriteSize( pOut, Gia_ObjSibl(p, i) );
             }
         if ( fVerbose ) printf( "Finished writing extension \"q\".\n" );
     }
     // write switching activity
     if ( p->pSwitching )
     {
-        fprintf( pFile, "u" );
-        Gia_FileWriteBufferSize( pFile, Gia_ManObjNum(p) );
-        fwrite( p->pSwitching, 1, Gia_ManObjNum(p), pFile );
+        Gia_AigerOutPrintF( pOut, "u" );
+        Gia_AigerOutWriteSize( pOut, Gia_ManObjNum(p) );
+        Gia_AigerOutWrite( pOut, p->pSwitching, Gia_ManObjNum(p) );
     }
 /*
     // write timing information
     if ( p->pManTime )
     {
-        fprintf( pFile, "t" );
+        Gia_AigerOutPrintF( pOut, "t" );
         vStrExt = Tim_ManSave( (Tim_Man_t *)p->pManTime, 0 );
-        Gia_FileWriteBufferSize( pFile, Vec_StrSize(vStrExt) );
-        fwrite( Vec_StrArray(vStrExt), 1, Vec_StrSize(vStrExt), pFile );
+        Gia_AigerOutWriteSize( pOut, Vec_StrSize(vStrExt) );
+        Gia_AigerOutWrite( pOut, Vec_StrArray(vStrExt), Vec_StrSize(vStrExt) );
         Vec_StrFree( vStrExt );
     }
 */
     // write object classes
     if ( p->vObjClasses )
     {
-        fprintf( pFile, "v" );
-        Gia_FileWriteBufferSize( pFile, 4*Gia_ManObjNum(p) );
+        Gia_AigerOutPrintF( pOut, "v" );
+        Gia_AigerOutWriteSize( pOut, 4*Gia_ManObjNum(p) );
         assert( Vec_IntSize(p->vObjClasses) == Gia_ManObjNum(p) );
-        fwrite( Vec_IntArray(p->vObjClasses), 1, 4*Gia_ManObjNum(p), pFile );
+        Gia_AigerOutWrite( pOut, Vec_IntArray(p->vObjClasses), 4*Gia_ManObjNum(p) );
     }
     // write name
     if ( p->pName )
     {
-        fprintf( pFile, "n" );
-        Gia_FileWriteBufferSize( pFile, strlen(p->pName)+1 );
-        fwrite( p->pName, 1, strlen(p->pName), pFile );
-        fprintf( pFile, "%c", '\0' );
+        Gia_AigerOutPrintF( pOut, "n" );
+        Gia_AigerOutWriteSize( pOut, strlen(p->pName)+1 );
+        Gia_AigerOutWrite( pOut, p->pName, strlen(p->pName) );
+        Gia_AigerOutPrintF( pOut, "%c", '\0' );
     }
     // write comments
     if ( fWriteNewLine )
-        fprintf( pFile, "c\n" );
-    fprintf( pFile, "\nThis file was produced by the GIA package in ABC on %s\n", Gia_TimeStamp() );
-    fprintf( pFile, "For information about AIGER format, refer to %s\n", "http://fmv.jku.at/aiger" );
-    fclose( pFile );
+        Gia_AigerOutPrintF( pOut, "c\n" );
+    Gia_AigerOutPrintF( pOut, "\nThis file was produced by the GIA package in ABC on %s\n", Gia_TimeStamp() );
+    Gia_AigerOutPrintF( pOut, "For information about AIGER format, refer to %s\n", "http://fmv.jku.at/aiger" );
+    if ( !Gia_AigerOutStop( pOut ) )
+        fprintf( stdout, "Gia_AigerWrite(): Writing the output file \"%s\" has failed.\n", pFileName );
     if ( p != pInit )
     {
         Gia_ManTransferTiming( pInit, p );
@@ -0,0 +1,376 @@
+/**CFile****************************************************************
+
+  FileName    [giaHashMt.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Scalable AIG package.]
+
+  Synopsis    [Concurrent structural hashing.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: giaHashMt.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include "gia.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+#define GIA_HASH_MT_LOCKS 1024  // the number of bucket locks (power of 2)
+#define PAR_THR_MAX        100
+
+// concurrent strashing uses the regular hash table of the manager
+// (vHTable/vHash), whose buckets are protected by a fixed number of
+// locks; new objects are allocated by atomically incrementing the
+// object counter in the storage reserved in advance, so that 'pObjs'
+// is never reallocated while the threads are running
+
+struct Gia_HashMt_t_
+{
+    Gia_Man_t *      p;              // the manager
+    int              nObjsMax;       // reserved object storage
+    volatile int     nObjs;          // the number of allocated objects
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_t  Locks[GIA_HASH_MT_LOCKS]; // bucket locks
+    pthread_mutex_t  LockAlloc;      // allocation lock (used without atomics)
+#endif
+};
+
+typedef struct Gia_DupMtThData_t_
+{
+    Gia_HashMt_t *   pHash;          // concurrent hash table
+    Gia_Man_t *      p;              // the old manager
+    int              iStart;         // the first CO to process
+    int              iStop;          // the last CO to process (exclusive)
+} Gia_DupMtThData_t;
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+#ifdef ABC_USE_PTHREADS
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the place where this node is stored (or should be stored).]
+
+  Description [Same as Gia_ManHashOne() in giaHash.c.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Gia_ManHashMtOne( int iLit0, int iLit1, int TableSize )
+{
+    unsigned Key = (unsigned)(-1 * 2011); // the same key as Gia_ManHashOne() with iLitC = -1
+    Key += Abc_Lit2Var(iLit0) * 7937;
+    Key += Abc_Lit2Var(iLit1) * 2971;
+    Key += Abc_LitIsCompl(iLit0) * 911;
+    Key += Abc_LitIsCompl(iLit1) * 353;
+    return (int)(Key % TableSize);
+}
+static inline int Gia_ManHashMtAllocId( Gia_HashMt_t * pHash )
+{
+    int iObj;
+#if defined(__GNUC__)
+    iObj = __sync_fetch_and_add( &pHash->nObjs, 1 );
+#else
+    pthread_mutex_lock( &pHash->LockAlloc );
+    iObj = pHash->nObjs++;
+    pthread_mutex_unlock( &pHash->LockAlloc );
+#endif
+    if ( iObj >= pHash->nObjsMax )
+        printf( "Reserved storage of concurrent strashing (%d objects) is exceeded. Quitting...\n", pHash->nObjsMax ), exit(1);
+    return iObj;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starts and stops concurrent strashing.]
+
+  Description [Reserves storage for nObjsMax objects. The manager should
+  not have the hash table and should not have MUXes, fanouts, etc.
+  Only Gia_ManHashAndMt() can be used to add objects to the manager
+  until Gia_ManHashMtStop() is called. After that, the manager has the
+  regular hash table, which can be stopped using Gia_ManHashStop().]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_HashMt_t * Gia_ManHashMtStart( Gia_Man_t * p, int nObjsMax )
+{
+    Gia_HashMt_t * pHash;
+    int i, nObjsAlloc = Abc_MaxInt( p->nObjsAlloc, nObjsMax );
+    assert( Vec_IntSize(&p->vHTable) == 0 );
+    assert( p->pMuxes == NULL && p->pFanData == NULL && !p->fSweeper && !p->fBuiltInSim && !p->fGiaSimple );
+    if ( nObjsAlloc > p->nObjsAlloc )
+    {
+        p->pObjs = ABC_REALLOC( Gia_Obj_t, p->pObjs, nObjsAlloc );
+        memset( p->pObjs + p->nObjsAlloc, 0, sizeof(Gia_Obj_t) * (nObjsAlloc - p->nObjsAlloc) );
+        p->nObjsAlloc = nObjsAlloc;
+    }
+    Vec_IntFill( &p->vHTable, Abc_PrimeCudd( nObjsAlloc ), 0 );
+    Vec_IntFill( &p->vHash, nObjsAlloc, 0 );
+    pHash = ABC_CALLOC( Gia_HashMt_t, 1 );
+    pHash->p        = p;
+    pHash->nObjsMax = nObjsAlloc;
+    pHash->nObjs    = p->nObjs;
+    for ( i = 0; i < GIA_HASH_MT_LOCKS; i++ )
+        pthread_mutex_init( pHash->Locks + i, NULL );
+    pthread_mutex_init( &pHash->LockAlloc, NULL );
+    return pHash;
+}
+void Gia_ManHashMtStop( Gia_HashMt_t * pHash )
+{
+    Gia_Man_t * p = pHash->p;
+    int i;
+    p->nObjs = pHash->nObjs;
+    Vec_IntShrink( &p->vHash, p->nObjs );
+    for ( i = 0; i < GIA_HASH_MT_LOCKS; i++ )
+        pthread_mutex_destroy( pHash->Locks + i );
+    pthread_mutex_destroy( &pHash->LockAlloc );
+    ABC_FREE( pHash );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Thread-safe version of Gia_ManHashAnd().]
+
+  Description [Can be called concurrently by several threads. The node
+  is created while holding the lock of its bucket, so another thread
+  looking for the same node either finds it completely constructed
+  or creates it after the lock is released.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Gia_ManHashAndMt( Gia_HashMt_t * pHash, int iLit0, int iLit1 )
+{
+    Gia_Man_t * p = pHash->p;
+    pthread_mutex_t * pLock;
+    Gia_Obj_t * pObj;
+    int iThis, iKey, * pPlace;
+    if ( iLit0 < 2 )
+        return iLit0 ? iLit1 : 0;
+    if ( iLit1 < 2 )
+        return iLit1 ? iLit0 : 0;
+    if ( iLit0 == iLit1 )
+        return iLit1;
+    if ( iLit0 == Abc_LitNot(iLit1) )
+        return 0;
+    if ( iLit0 > iLit1 )
+        iLit0 ^= iLit1, iLit1 ^= iLit0, iLit0 ^= iLit1;
+    iKey  = Gia_ManHashMtOne( iLit0, iLit1, Vec_IntSize(&p->vHTable) );
+    pLock = pHash->Locks + (iKey & (GIA_HASH_MT_LOCKS-1));
+    pthread_mutex_lock( pLock );
+    pPlace = Vec_IntEntryP( &p->vHTable, iKey );
+    for ( ; (iThis = *pPlace); pPlace = Vec_IntEntryP(&p->vHash, iThis) )
+    {
+        Gia_Obj_t * pThis = p->pObjs + iThis; // p->nObjs is not updated while threads are running
+        if ( Gia_ObjFaninLit0(pThis, iThis) == iLit0 && Gia_ObjFaninLit1(pThis, iThis) == iLit1 )
+            break;
+    }
+    if ( iThis == 0 )
+    {
+        // the fanins were created before this node, so the IDs remain topologically sorted
+        iThis = Gia_ManHashMtAllocId( pHash );
+        assert( Abc_Lit2Var(iLit0) < iThis && Abc_Lit2Var(iLit1) < iThis );
+        pObj = p->pObjs + iThis;
+        pObj->iDiff0  = (unsigned)(iThis - Abc_Lit2Var(iLit0));
+        pObj->fCompl0 = (unsigned)(Abc_LitIsCompl(iLit0));
+        pObj->iDiff1  = (unsigned)(iThis - Abc_Lit2Var(iLit1));
+        pObj->fCompl1 = (unsigned)(Abc_LitIsCompl(iLit1));
+        *pPlace = iThis;
+    }
+    pthread_mutex_unlock( pLock );
+    return Abc_Var2Lit( iThis, 0 );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Duplicates the AIG using concurrent strashing.]
+
+  Description [The COs are divided into contiguous groups processed by
+  different threads. The copy of an old node is recorded in its Value
+  only after the new node is complete. If two threads reach the same
+  node concurrently, both compute the same literal, because the fanin
+  literals are unique and strashing is canonical. The resulting AIG is
+  the same as the one produced by Gia_ManRehash().]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Gia_ManDupMt_rec( Gia_HashMt_t * pHash, Gia_Man_t * p, int iObj )
+{
+    Gia_Obj_t * pObj = Gia_ManObj( p, iObj );
+    volatile unsigned * pValue = &pObj->Value;
+    int iLit0, iLit1;
+    if ( *pValue != ~0 )
+        return *pValue;
+    assert( Gia_ObjIsAnd(pObj) );
+    iLit0 = Gia_ManDupMt_rec( pHash, p, Gia_ObjFaninId0(pObj, iObj) );
+    iLit1 = Gia_ManDupMt_rec( pHash, p, Gia_ObjFaninId1(pObj, iObj) );
+    iLit0 = Abc_LitNotCond( iLit0, Gia_ObjFaninC0(pObj) );
+    iLit1 = Abc_LitNotCond( iLit1, Gia_ObjFaninC1(pObj) );
+    return (*pValue = Gia_ManHashAndMt( pHash, iLit0, iLit1 ));
+}
+void * Gia_ManDupMtWorkerThread( void * pArg )
+{
+    Gia_DupMtThData_t * pThData = (Gia_DupMtThData_t *)pArg;
+    Gia_Obj_t * pObj; int i;
+    for ( i = pThData->iStart; i < pThData->iStop; i++ )
+    {
+        pObj = Gia_ManCo( pThData->p, i );
+        Gia_ManDupMt_rec( pThData->pHash, pThData->p, Gia_ObjFaninId0p(pThData->p, pObj) );
+    }
+    return NULL;
+}
+Gia_Man_t * Gia_ManRehashMtReorder( Gia_Man_t * pNew, Gia_Man_t * p )
+{
+    // the new nodes are created in the order of the first old nodes mapped
+    // into them, as in Gia_ManRehash(), and the unused ones are skipped,
+    // as in Gia_ManCleanup(), so the order does not depend on the threads
+    Gia_Man_t * pRes;
+    Gia_Obj_t * pObj, * pObjNew;
+    int i;
+    Gia_ManCombMarkUsed( pNew );
+    Gia_ManFillValue( pNew );
+    pRes = Gia_ManStart( Gia_ManObjNum(pNew) );
+    pRes->pName = Abc_UtilStrsav( pNew->pName );
+    pRes->pSpec = Abc_UtilStrsav( pNew->pSpec );
+    Gia_ManConst0(pNew)->Value = 0;
+    Gia_ManForEachObj1( p, pObj, i )
+    {
+        if ( Gia_ObjIsAnd(pObj) )
+        {
+            pObjNew = Gia_ManObj( pNew, Abc_Lit2Var(pObj->Value) );
+            if ( Gia_ObjIsAnd(pObjNew) && !pObjNew->fMark0 && pObjNew->Value == ~0 )
+                pObjNew->Value = Gia_ManAppendAnd( pRes, Gia_ObjFanin0Copy(pObjNew), Gia_ObjFanin1Copy(pObjNew) );
+        }
+        else if ( Gia_ObjIsCi(pObj) )
+        {
+            pObjNew = Gia_ManCi( pNew, Gia_ObjCioId(pObj) );
+            pObjNew->Value = Gia_ManAppendCi( pRes );
+        }
+        else if ( Gia_ObjIsCo(pObj) )
+        {
+            pObjNew = Gia_ManCo( pNew, Gia_ObjCioId(pObj) );
+            pObjNew->Value = Gia_ManAppendCo( pRes, Gia_ObjFanin0Copy(pObjNew) );
+        }
+    }
+    Gia_ManCleanMark0( pNew );
+    Gia_ManSetRegNum( pRes, Gia_ManRegNum(pNew) );
+    return pRes;
+}
+Gia_Man_t * Gia_ManRehashMt( Gia_Man_t * p, int nProcs, int fVerbose )
+{
+    Gia_DupMtThData_t ThData[PAR_THR_MAX];
+    pthread_t WorkerThread[PAR_THR_MAX];
+    Gia_HashMt_t * pHash;
+    Gia_Man_t * pNew, * pTemp;
+    Gia_Obj_t * pObj;
+    int i, status, nCos = Gia_ManCoNum(p);
+    abctime clk = Abc_Clock();
+    if ( nProcs < 2 || nCos < 2 || p->pMuxes )
+        return Gia_ManRehash( p, 0 );
+    nProcs = Abc_MinInt( Abc_MinInt(nProcs, nCos), PAR_THR_MAX );
+    pNew = Gia_ManStart( Gia_ManObjNum(p) );
+    pNew->pName = Abc_UtilStrsav( p->pName );
+    pNew->pSpec = Abc_UtilStrsav( p->pSpec );
+    Gia_ManFillValue( p );
+    Gia_ManConst0(p)->Value = 0;
+    Gia_ManForEachCi( p, pObj, i )
+        pObj->Value = Gia_ManAppendCi( pNew );
+    // each old AND node is duplicated at most once
+    pHash = Gia_ManHashMtStart( pNew, Gia_ManObjNum(pNew) + Gia_ManAndNum(p) + 1 );
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].pHash  = pHash;
+        ThData[i].p      = p;
+        ThData[i].iStart = (int)((word)nCos * i / nProcs);
+        ThData[i].iStop  = (int)((word)nCos * (i+1) / nProcs);
+        status = pthread_create( WorkerThread + i, NULL, Gia_ManDupMtWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
+    }
+    for ( i = 0; i < nProcs; i++ )
+    {
+        status = pthread_join( WorkerThread[i], NULL );  assert( status == 0 );
+    }
+    // the nodes not reachable from the COs are added too, because they
+    // may come first in the order of the nodes mapped into the same node
+    Gia_ManForEachAnd( p, pObj, i )
+        if ( pObj->Value == ~0 )
+            Gia_ManDupMt_rec( pHash, p, i );
+    Gia_ManHashMtStop( pHash );
+    Gia_ManForEachCo( p, pObj, i )
+        pObj->Value = Gia_ManAppendCo( pNew, Gia_ObjFanin0Copy(pObj) );
+    Gia_ManHashStop( pNew );
+    Gia_ManSetRegNum( pNew, Gia_ManRegNum(p) );
+    pNew = Gia_ManRehashMtReorder( pTemp = pNew, p );
+    Gia_ManStop( pTemp );
+    if ( fVerbose )
+    {
+        printf( "Concurrent strashing with %d threads: %d -> %d nodes.  ", nProcs, Gia_ManAndNum(p), Gia_ManAndNum(pNew) );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    }
+    return pNew;
+}
+
+#else // pthreads are not used
+
+Gia_HashMt_t * Gia_ManHashMtStart( Gia_Man_t * p, int nObjsMax )
+{
+    Gia_HashMt_t * pHash = ABC_CALLOC( Gia_HashMt_t, 1 );
+    pHash->p = p;
+    Gia_ManHashAlloc( p );
+    return pHash;
+}
+void Gia_ManHashMtStop( Gia_HashMt_t * pHash )
+{
+    ABC_FREE( pHash );
+}
+int Gia_ManHashAndMt( Gia_HashMt_t * pHash, int iLit0, int iLit1 )
+{
+    return Gia_ManHashAnd( pHash->p, iLit0, iLit1 );
+}
+Gia_Man_t * Gia_ManRehashMt( Gia_Man_t * p, int nProcs, int fVerbose )
+{
+    return Gia_ManRehash( p, 0 );
+}
+
+#endif // pthreads are used
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
+
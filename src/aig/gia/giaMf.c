@@ -26,6 +26,16 @@
 #include "opt/dau/dau.h"
 #include "bool/kit/kit.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 ////////////////////////////////////////////////////////////////////////
@@ -38,6 +48,7 @@ ABC_NAMESPACE_IMPL_START
 #define MF_NO_LEAF    31
 #define MF_TT_WORDS  ((MF_LEAF_MAX > 6) ? 1 << (MF_LEAF_MAX-6) : 1)
 #define MF_NO_FUNC    134217727     // (1<<27)-1
+#define MF_PROC_MAX   64
 #define MF_EPSILON 0.005
 
 typedef struct Mf_Cut_t_ Mf_Cut_t; 
@@ -729,16 +740,22 @@ static inline int Mf_ManPrepareCuts( Mf_Cut_t * pCuts, Mf_Man_t * p, int iObj, i
     }
     return Mf_CutCreateUnit( pCuts, iObj );
 }
-static inline int Mf_ManSaveCuts( Mf_Man_t * p, Mf_Cut_t ** pCuts, int nCuts )
+static inline int Mf_ManAllocCutSet( Mf_Man_t * p, int nInts )
 {
-    int i, * pPlace, iCur, nInts = 1;
-    for ( i = 0; i < nCuts; i++ )
-        nInts += pCuts[i]->nLeaves + 1;
+    int iCur;
     if ( (p->iCur & 0xFFFF) + nInts > 0xFFFF )
         p->iCur = ((p->iCur >> 16) + 1) << 16;
     if ( Vec_PtrSize(&p->vPages) == (p->iCur >> 16) )
         Vec_PtrPush( &p->vPages, ABC_ALLOC(int, (1<<16)) );
     iCur = p->iCur; p->iCur += nInts;
+    return iCur;
+}
+static inline int Mf_ManSaveCuts( Mf_Man_t * p, Mf_Cut_t ** pCuts, int nCuts )
+{
+    int i, * pPlace, iCur, nInts = 1;
+    for ( i = 0; i < nCuts; i++ )
+        nInts += pCuts[i]->nLeaves + 1;
+    iCur = Mf_ManAllocCutSet( p, nInts );
     pPlace = Mf_ManCutSet( p, iCur );
     *pPlace++ = nCuts;
     for ( i = 0; i < nCuts; i++ )
@@ -1023,9 +1040,9 @@ static inline void Mf_CutParams( Mf_Man_t * p, Mf_Cut_t * pCut, float FlowRefs )
     pCut->Delay += (int)(nLeaves > 1);
     pCut->Flow = (pCut->Flow + Mf_CutArea(p, nLeaves, pCut->iFunc)) / FlowRefs;
 }
-void Mf_ObjMergeOrder( Mf_Man_t * p, int iObj )
+int Mf_ObjMergeOrderInt( Mf_Man_t * p, int iObj, Mf_Cut_t * pCuts, Mf_Cut_t ** pCutsR, double * CutCount )
 {
-    Mf_Cut_t pCuts0[MF_CUT_MAX], pCuts1[MF_CUT_MAX], pCuts[MF_CUT_MAX], * pCutsR[MF_CUT_MAX];
+    Mf_Cut_t pCuts0[MF_CUT_MAX], pCuts1[MF_CUT_MAX];
     Gia_Obj_t * pObj = Gia_ManObj(p->pGia, iObj);
     Mf_Obj_t * pBest = Mf_ManObj(p, iObj);
     int nLutSize = p->pPars->nLutSize;
@@ -1061,19 +1078,19 @@ void Mf_ObjMergeOrder( Mf_Man_t * p, int iObj )
         int nCuts2  = Mf_ManPrepareCuts(pCuts2, p, Gia_ObjFaninId2(p->pGia, iObj), 1);
         int fComp2  = Gia_ObjFaninC2(p->pGia, pObj);
         Mf_Cut_t * pCut2, * pCut2Lim = pCuts2 + nCuts2;
-        p->CutCount[0] += nCuts0 * nCuts1 * nCuts2;
+        CutCount[0] += nCuts0 * nCuts1 * nCuts2;
         for ( pCut0 = pCuts0; pCut0 < pCut0Lim; pCut0++ )
         for ( pCut1 = pCuts1; pCut1 < pCut1Lim; pCut1++ )
         for ( pCut2 = pCuts2; pCut2 < pCut2Lim; pCut2++ )
         {
             if ( Mf_CutCountBits(pCut0->Sign | pCut1->Sign | pCut2->Sign) > nLutSize )
                 continue;
-            p->CutCount[1]++; 
+            CutCount[1]++; 
             if ( !Mf_CutMergeOrderMux(pCut0, pCut1, pCut2, pCutsR[nCutsR], nLutSize) )
                 continue;
             if ( Mf_SetLastCutIsContained(pCutsR, nCutsR) )
                 continue;
-            p->CutCount[2]++;
+            CutCount[2]++;
             if ( p->pPars->fCutMin && Mf_CutComputeTruthMux(p, pCut0, pCut1, pCut2, fComp0, fComp1, fComp2, pCutsR[nCutsR]) )
                 pCutsR[nCutsR]->Sign = Mf_CutGetSign(pCutsR[nCutsR]->pLeaves, pCutsR[nCutsR]->nLeaves);
             Mf_CutParams( p, pCutsR[nCutsR], pBest->nFlowRefs );
@@ -1083,18 +1100,18 @@ void Mf_ObjMergeOrder( Mf_Man_t * p, int iObj )
     else
     {
         int fIsXor = Gia_ObjIsXor(pObj);
-        p->CutCount[0] += nCuts0 * nCuts1;
+        CutCount[0] += nCuts0 * nCuts1;
         for ( pCut0 = pCuts0; pCut0 < pCut0Lim; pCut0++ )
         for ( pCut1 = pCuts1; pCut1 < pCut1Lim; pCut1++ )
         {
             if ( (int)(pCut0->nLeaves + pCut1->nLeaves) > nLutSize && Mf_CutCountBits(pCut0->Sign | pCut1->Sign) > nLutSize )
                 continue;
-            p->CutCount[1]++; 
+            CutCount[1]++; 
             if ( !Mf_CutMergeOrder(pCut0, pCut1, pCutsR[nCutsR], nLutSize) )
                 continue;
             if ( Mf_SetLastCutIsContained(pCutsR, nCutsR) )
                 continue;
-            p->CutCount[2]++;
+            CutCount[2]++;
             if ( p->pPars->fCutMin && Mf_CutComputeTruth(p, pCut0, pCut1, fComp0, fComp1, pCutsR[nCutsR], fIsXor) )
                 pCutsR[nCutsR]->Sign = Mf_CutGetSign(pCutsR[nCutsR]->pLeaves, pCutsR[nCutsR]->nLeaves);
             Mf_CutParams( p, pCutsR[nCutsR], pBest->nFlowRefs );
@@ -1111,15 +1128,21 @@ void Mf_ObjMergeOrder( Mf_Man_t * p, int iObj )
             Mf_CutPrint( p, pCutsR[i] );
         printf( "\n" );
     } 
-    // store the cutset
+    // store the best cut
     pBest->Flow = pCutsR[0]->Flow;
     pBest->Delay = pCutsR[0]->Delay;
-    pBest->iCutSet = Mf_ManSaveCuts( p, pCutsR, nCutsR );
     // verify
     assert( nCutsR > 0 && nCutsR < nCutNum );
 //    assert( Mf_SetCheckArray(pCutsR, nCutsR) );
+    CutCount[3] += nCutsR;
+    return nCutsR;
+}
+void Mf_ObjMergeOrder( Mf_Man_t * p, int iObj )
+{
+    Mf_Cut_t pCuts[MF_CUT_MAX], * pCutsR[MF_CUT_MAX];
+    int nCutsR = Mf_ObjMergeOrderInt( p, iObj, pCuts, pCutsR, p->CutCount );
+    Mf_ManObj(p, iObj)->iCutSet = Mf_ManSaveCuts( p, pCutsR, nCutsR );
     p->nCutCounts[pCutsR[0]->nLeaves]++;
-    p->CutCount[3] += nCutsR;
 }
  
 
@@ -1427,6 +1450,188 @@ void Mf_ManFree( Mf_Man_t * p )
     ABC_FREE( p );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Computes cuts using several threads.]
+
+  Description [The nodes are grouped by logic level. Because the nodes
+  on the same level do not depend on each other (the level of a choice 
+  node is above that of its sibling), they are divided among
+  the threads, which compute the cuts into their own buffers. After all
+  threads finish the level, the main thread copies the cut sets into
+  the cut memory pages in the order of the nodes on the level. The cut
+  sets are the same as those computed by the sequential version, so the
+  resulting mapping does not depend on the number of threads. Cut
+  minimization is not supported because the truth table storage is
+  shared.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Wec_t * Mf_ManCollectLevels( Mf_Man_t * p )
+{
+    Vec_Wec_t * vLevels = Vec_WecAlloc( 100 );
+    Vec_Int_t * vLevel = Vec_IntStart( Gia_ManObjNum(p->pGia) );
+    Gia_Obj_t * pObj; int i, Level;
+    Gia_ManForEachAnd( p->pGia, pObj, i )
+    {
+        Level = Abc_MaxInt( Vec_IntEntry(vLevel, Gia_ObjFaninId0(pObj, i)), Vec_IntEntry(vLevel, Gia_ObjFaninId1(pObj, i)) );
+        if ( Gia_ObjIsMuxId(p->pGia, i) )
+            Level = Abc_MaxInt( Level, Vec_IntEntry(vLevel, Gia_ObjFaninId2(p->pGia, i)) );
+        // the cuts of the choice node are merged with those of its sibling
+        if ( Gia_ObjSibl(p->pGia, i) )
+            Level = Abc_MaxInt( Level, Vec_IntEntry(vLevel, Gia_ObjSibl(p->pGia, i)) );
+        Vec_IntWriteEntry( vLevel, i, Level + 1 );
+        Vec_WecPush( vLevels, Level, i );
+    }
+    Vec_IntFree( vLevel );
+    return vLevels;
+}
+static inline int Mf_ManSaveCutList( Mf_Man_t * p, int * pList, int nInts )
+{
+    int iCur = Mf_ManAllocCutSet( p, nInts );
+    memcpy( Mf_ManCutSet(p, iCur), pList, sizeof(int) * nInts );
+    return iCur;
+}
+
+#ifndef ABC_USE_PTHREADS
+
+void Mf_ManComputeCutsMt( Mf_Man_t * p )
+{
+    int i;
+    Gia_ManForEachAndId( p->pGia, i )
+        Mf_ObjMergeOrder( p, i );
+}
+
+#else // pthreads are used
+
+typedef struct Mf_ThData_t_
+{
+    Mf_Man_t *   p;              // mapping manager
+    Vec_Int_t *  vNodes;         // nodes on the current level
+    volatile int iStart;         // the first node to process
+    volatile int iStop;          // the last node to process (exclusive)
+    Vec_Int_t    vCutSets;       // cut sets of the nodes in the range
+    double       CutCount[4];    // cut counts
+    int          nCutCounts[MF_LEAF_MAX+1];
+    volatile int fWorking;       // the thread is busy
+} Mf_ThData_t;
+
+void Mf_ManSaveCutsBuffer( Vec_Int_t * vCutSets, Mf_Cut_t ** pCuts, int nCuts )
+{
+    int i;
+    Vec_IntPush( vCutSets, nCuts );
+    for ( i = 0; i < nCuts; i++ )
+    {
+        Vec_IntPush( vCutSets, Mf_CutSetBoth(pCuts[i]->nLeaves, pCuts[i]->iFunc) );
+        Vec_IntPushArray( vCutSets, pCuts[i]->pLeaves, pCuts[i]->nLeaves );
+    }
+}
+void * Mf_WorkerThread( void * pArg )
+{
+    Mf_ThData_t * pThData = (Mf_ThData_t *)pArg;
+    volatile int * pPlace = &pThData->fWorking;
+    Mf_Cut_t pCuts[MF_CUT_MAX], * pCutsR[MF_CUT_MAX];
+    int i, iObj, nCutsR;
+    while ( 1 )
+    {
+        while ( *pPlace == 0 );
+        assert( pThData->fWorking );
+        if ( pThData->iStart == -1 )
+        {
+            pthread_exit( NULL );
+            assert( 0 );
+            return NULL;
+        }
+        Vec_IntClear( &pThData->vCutSets );
+        for ( i = pThData->iStart; i < pThData->iStop; i++ )
+        {
+            iObj = Vec_IntEntry( pThData->vNodes, i );
+            nCutsR = Mf_ObjMergeOrderInt( pThData->p, iObj, pCuts, pCutsR, pThData->CutCount );
+            Mf_ManSaveCutsBuffer( &pThData->vCutSets, pCutsR, nCutsR );
+            pThData->nCutCounts[pCutsR[0]->nLeaves]++;
+        }
+        pThData->fWorking = 0;
+    }
+    assert( 0 );
+    return NULL;
+}
+void Mf_ManComputeCutsMt( Mf_Man_t * p )
+{
+    Mf_ThData_t ThData[MF_PROC_MAX];
+    pthread_t WorkerThread[MF_PROC_MAX];
+    Vec_Wec_t * vLevels = Mf_ManCollectLevels( p );
+    Vec_Int_t * vNodes;
+    int nProcs = Abc_MinInt( p->pPars->nProcNum, MF_PROC_MAX );
+    int i, k, n, iObj, nInts = 0, * pList, status;
+    // start the threads
+    memset( ThData, 0, sizeof(Mf_ThData_t) * nProcs );
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].p        = p;
+        ThData[i].iStart   = -1;
+        ThData[i].fWorking = 0;
+        status = pthread_create( WorkerThread + i, NULL, Mf_WorkerThread, (void *)(ThData + i) );  assert( status == 0 );
+    }
+    Vec_WecForEachLevel( vLevels, vNodes, k )
+    {
+        // small levels are not worth the synchronization
+        if ( Vec_IntSize(vNodes) < 16 * nProcs )
+        {
+            Vec_IntForEachEntry( vNodes, iObj, i )
+                Mf_ObjMergeOrder( p, iObj );
+            continue;
+        }
+        for ( i = 0; i < nProcs; i++ )
+        {
+            ThData[i].vNodes   = vNodes;
+            ThData[i].iStart   = (int)((word)Vec_IntSize(vNodes) * i / nProcs);
+            ThData[i].iStop    = (int)((word)Vec_IntSize(vNodes) * (i+1) / nProcs);
+            ThData[i].fWorking = 1;
+        }
+        // wait till threads finish
+        for ( i = 0; i < nProcs; i++ )
+            if ( ThData[i].fWorking )
+                i = -1;
+        // save the cut sets in the order of nodes
+        for ( i = 0; i < nProcs; i++ )
+        {
+            pList = Vec_IntArray( &ThData[i].vCutSets );
+            for ( n = ThData[i].iStart; n < ThData[i].iStop; n++, pList += nInts )
+            {
+                int * pCut, c;
+                nInts = 1;
+                Mf_SetForEachCut( pList, pCut, c )
+                    nInts += Mf_CutSize(pCut) + 1;
+                iObj = Vec_IntEntry( vNodes, n );
+                Mf_ManObj(p, iObj)->iCutSet = Mf_ManSaveCutList( p, pList, nInts );
+            }
+            assert( pList == Vec_IntLimit(&ThData[i].vCutSets) );
+        }
+    }
+    // stop the threads
+    for ( i = 0; i < nProcs; i++ )
+    {
+        assert( !ThData[i].fWorking );
+        ThData[i].iStart   = -1;
+        ThData[i].fWorking = 1;
+    }
+    for ( i = 0; i < nProcs; i++ )
+    {
+        status = pthread_join( WorkerThread[i], NULL );  assert( status == 0 );
+        for ( k = 0; k < 4; k++ )
+            p->CutCount[k] += ThData[i].CutCount[k];
+        for ( k = 0; k <= MF_LEAF_MAX; k++ )
+            p->nCutCounts[k] += ThData[i].nCutCounts[k];
+        ABC_FREE( ThData[i].vCutSets.pArray );
+    }
+    Vec_WecFree( vLevels );
+}
+
+#endif // pthreads are used
+
 /**Function*************************************************************
 
   Synopsis    []
@@ -1462,6 +1667,7 @@ void Mf_ManSetDefaultPars( Jf_Par_t * pPars )
     pPars->fVeryVerbose =  0;
     pPars->nLutSizeMax  =  MF_LEAF_MAX;
     pPars->nCutNumMax   =  MF_CUT_MAX;
+    pPars->nProcNumMax  =  MF_PROC_MAX;
 }
 void Mf_ManPrintStats( Mf_Man_t * p, char * pTitle )
 {
@@ -1531,8 +1737,13 @@ void Mf_ManPrintQuit( Mf_Man_t * p, Gia_Man_t * pNew )
 void Mf_ManComputeCuts( Mf_Man_t * p )
 {
     int i;
-    Gia_ManForEachAndId( p->pGia, i )
-        Mf_ObjMergeOrder( p, i );
+    if ( p->pPars->nProcNum > 1 && !p->pPars->fCutMin )
+        Mf_ManComputeCutsMt( p );
+    else
+    {
+        Gia_ManForEachAndId( p->pGia, i )
+            Mf_ObjMergeOrder( p, i );
+    }
     Mf_ManSetMapRefs( p );
     Mf_ManPrintStats( p, (char *)(p->fUseEla ? "Ela  " : (p->Iter ? "Area " : "Delay")) );
 }
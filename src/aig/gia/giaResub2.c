@@ -1266,16 +1266,20 @@ Gia_Man_t * Gia_RsbDeriveGiaFromWindows( Gia_Man_t * p, Vec_Int_t * vWin, Vec_In
     Gia_Man_t * pNew; 
     Gia_Obj_t * pObj;
     int i;
-    pNew = Gia_ManStart( Gia_ManObjNum(p) );
+    pNew = Gia_ManStart( 1 + Vec_IntSize(vIns) + Vec_IntSize(vWin) + Vec_IntSize(vOuts) );
     pNew->pName = Abc_UtilStrsav( p->pName );
     pNew->pSpec = Abc_UtilStrsav( p->pSpec );
     Gia_ManHashAlloc( pNew );
-    Gia_ManFillValue( p );
+    // only the window objects are reset, to keep this linear in the window size
+    Gia_ManForEachObjVec( vWin, p, pObj, i )
+        pObj->Value = ~0;
     Gia_ManConst0(p)->Value = 0;
     Gia_ManForEachObjVec( vIns, p, pObj, i )
         pObj->Value = Gia_ManAppendCi( pNew );
     Gia_ManForEachObjVec( vWin, p, pObj, i )
-        if ( !~pObj->Value )
+        if ( !~pObj->Value && Gia_ObjIsXor(pObj) )
+            pObj->Value = Gia_ManHashXor( pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+        else if ( !~pObj->Value )
             pObj->Value = Gia_ManHashAnd( pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
     Gia_ManForEachObjVec( vOuts, p, pObj, i )
         Gia_ManAppendCo( pNew, pObj->Value );
@@ -20,19 +20,105 @@
 
 #include "gia.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 ////////////////////////////////////////////////////////////////////////
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define RSB_PROC_MAX 64
+
+typedef struct Gia_RsbThData_t_ Gia_RsbThData_t;
+struct Gia_RsbThData_t_
+{
+    Vec_Ptr_t *    vGiaIns;   // window AIGs
+    Vec_Ptr_t *    vGiaOuts;  // resubstituted window AIGs
+    int            iThread;   // the index of this thread
+    int            nThreads;  // the number of threads
+};
+
+extern int         Gia_RsbWindowCompute( Gia_Man_t * p, int iObj, int nInputsMax, int nLevelsMax, Vec_Wec_t * vLevels, Vec_Int_t * vPaths, Vec_Int_t ** pvWin, Vec_Int_t ** pvIns );
+extern Vec_Int_t * Gia_RsbFindOutputs( Gia_Man_t * p, Vec_Int_t * vWin, Vec_Int_t * vIns, Vec_Int_t * vRefs );
+extern Gia_Man_t * Gia_RsbDeriveGiaFromWindows( Gia_Man_t * p, Vec_Int_t * vWin, Vec_Int_t * vIns, Vec_Int_t * vOuts );
+extern Gia_Man_t * Gia_ManResub2Test( Gia_Man_t * p );
+extern int         Gia_ManVerifyTwoTruths( Gia_Man_t * p1, Gia_Man_t * p2 );
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
 
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Collects non-overlapping windows.]
+
+  Description [Windows are computed for the nodes in the topological order.
+  A window is accepted if none of its internal nodes belongs to a window 
+  accepted before. Returns the window nodes, inputs and outputs.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Gia_RsbCollectWindows( Gia_Man_t * p, int nWinCount, int nCutSize, int nLevelsMax, Vec_Wec_t * vWins, Vec_Wec_t * vInss, Vec_Wec_t * vOutss )
+{
+    Vec_Wec_t * vLevels = Vec_WecStart( Gia_ManLevelNum(p)+1 );
+    Vec_Int_t * vPaths  = Vec_IntStart( Gia_ManObjNum(p) );
+    Vec_Int_t * vRefs   = Vec_IntStart( Gia_ManObjNum(p) );
+    Vec_Int_t * vUsed   = Vec_IntStart( Gia_ManObjNum(p) );
+    Vec_Int_t * vWin, * vIns, * vOuts;
+    Gia_Obj_t * pObj;
+    int i, k, iObj;
+    Gia_ManStaticFanoutStart( p );
+    Gia_ManForEachAnd( p, pObj, i )
+    {
+        if ( nWinCount && Vec_WecSize(vWins) == nWinCount )
+            break;
+        if ( Vec_IntEntry(vUsed, i) )
+            continue;
+        if ( !Gia_RsbWindowCompute( p, i, nCutSize, nLevelsMax, vLevels, vPaths, &vWin, &vIns ) )
+            continue;
+        Vec_IntForEachEntry( vWin, iObj, k )
+            if ( Vec_IntEntry(vUsed, iObj) && Vec_IntFind(vIns, iObj) == -1 )
+                break;
+        if ( k < Vec_IntSize(vWin) )
+        {
+            Vec_IntFree( vWin );
+            Vec_IntFree( vIns );
+            continue;
+        }
+        Vec_IntForEachEntry( vWin, iObj, k )
+            if ( Vec_IntFind(vIns, iObj) == -1 )
+                Vec_IntWriteEntry( vUsed, iObj, 1 );
+        vOuts = Gia_RsbFindOutputs( p, vWin, vIns, vRefs );
+        Vec_IntAppend( Vec_WecPushLevel(vWins),  vWin );
+        Vec_IntAppend( Vec_WecPushLevel(vInss),  vIns );
+        Vec_IntAppend( Vec_WecPushLevel(vOutss), vOuts );
+        Vec_IntFree( vWin );
+        Vec_IntFree( vIns );
+        Vec_IntFree( vOuts );
+    }
+    Gia_ManStaticFanoutStop( p );
+    Vec_WecFree( vLevels );
+    Vec_IntFree( vPaths );
+    Vec_IntFree( vRefs );
+    Vec_IntFree( vUsed );
+    return Vec_WecSize(vWins);
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs resubstitution of the windows using threads.]
 
   Description []
                
@@ -41,10 +127,254 @@ ABC_NAMESPACE_IMPL_START
   SeeAlso     []
 
 ***********************************************************************/
-Gia_Man_t * Gia_ManPerformNewResub( Gia_Man_t * p, int nWinCount, int nCutSize, int nProcs, int fVerbose )
+void * Gia_RsbWorkerThread( void * pArg )
 {
+    Gia_RsbThData_t * pThData = (Gia_RsbThData_t *)pArg;
+    Gia_Man_t * pIn; int i;
+    Vec_PtrForEachEntry( Gia_Man_t *, pThData->vGiaIns, pIn, i )
+        if ( i % pThData->nThreads == pThData->iThread )
+            Vec_PtrWriteEntry( pThData->vGiaOuts, i, Gia_ManResub2Test(pIn) );
     return NULL;
 }
+void Gia_RsbPerformWindows( Vec_Ptr_t * vGiaIns, Vec_Ptr_t * vGiaOuts, int nProcs )
+{
+    Gia_RsbThData_t ThData[RSB_PROC_MAX];
+    int i;
+    nProcs = Abc_MaxInt( 1, Abc_MinInt(nProcs, RSB_PROC_MAX) );
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].vGiaIns  = vGiaIns;
+        ThData[i].vGiaOuts = vGiaOuts;
+        ThData[i].iThread  = i;
+        ThData[i].nThreads = nProcs;
+    }
+#ifdef ABC_USE_PTHREADS
+    if ( nProcs > 1 )
+    {
+        pthread_t WorkerThread[RSB_PROC_MAX];
+        int status;
+        for ( i = 0; i < nProcs; i++ )
+        {
+            status = pthread_create( WorkerThread + i, NULL, Gia_RsbWorkerThread, (void *)(ThData + i) );
+            assert( status == 0 );
+        }
+        for ( i = 0; i < nProcs; i++ )
+        {
+            status = pthread_join( WorkerThread[i], NULL );
+            assert( status == 0 );
+        }
+        return;
+    }
+#endif
+    for ( i = 0; i < nProcs; i++ )
+        Gia_RsbWorkerThread( (void *)(ThData + i) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Checks that the window can be committed.]
+
+  Description [The new window should have fewer nodes and compute the 
+  same functions. Each output of the new window should depend only on 
+  the inputs it depended on before. Otherwise, the new output may depend 
+  on a node in the fanout of the old one through another window, which 
+  would create a combinational loop.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Gia_RsbWindowSupps( Gia_Man_t * p, Vec_Int_t * vSupps )
+{
+    Gia_Obj_t * pObj; int i;
+    assert( Gia_ManCiNum(p) <= 32 );
+    Vec_IntFill( vSupps, Gia_ManObjNum(p), 0 );
+    Gia_ManForEachCi( p, pObj, i )
+        Vec_IntWriteEntry( vSupps, Gia_ObjId(p, pObj), 1 << i );
+    Gia_ManForEachAnd( p, pObj, i )
+        Vec_IntWriteEntry( vSupps, i, Vec_IntEntry(vSupps, Gia_ObjFaninId0(pObj, i)) | Vec_IntEntry(vSupps, Gia_ObjFaninId1(pObj, i)) );
+    Gia_ManForEachCo( p, pObj, i )
+        Vec_IntWriteEntry( vSupps, Gia_ObjId(p, pObj), Vec_IntEntry(vSupps, Gia_ObjFaninId0p(p, pObj)) );
+}
+int Gia_RsbWindowCanCommit( Gia_Man_t * pIn, Gia_Man_t * pOut, Vec_Int_t * vSupps, Vec_Int_t * vSupps2 )
+{
+    Gia_Obj_t * pObj; int i;
+    if ( Gia_ManAndNum(pOut) >= Gia_ManAndNum(pIn) )
+        return 0;
+    if ( Gia_ManCiNum(pIn) > 6 || !Gia_ManVerifyTwoTruths(pIn, pOut) )
+        return 0;
+    Gia_RsbWindowSupps( pIn,  vSupps );
+    Gia_RsbWindowSupps( pOut, vSupps2 );
+    Gia_ManForEachCo( pIn, pObj, i )
+    {
+        int Supp  = Vec_IntEntry( vSupps,  Gia_ObjId(pIn, pObj) );
+        int Supp2 = Vec_IntEntry( vSupps2, Gia_ObjId(pOut, Gia_ManCo(pOut, i)) );
+        if ( Supp2 & ~Supp )
+            return 0;
+    }
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the AIG with the committed windows.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Gia_RsbCommitOutput_rec( Gia_Man_t * pNew, Gia_Man_t * pWin, Gia_Obj_t * pObj )
+{
+    if ( ~pObj->Value )
+        return pObj->Value;
+    assert( Gia_ObjIsAnd(pObj) );
+    Gia_RsbCommitOutput_rec( pNew, pWin, Gia_ObjFanin0(pObj) );
+    Gia_RsbCommitOutput_rec( pNew, pWin, Gia_ObjFanin1(pObj) );
+    if ( Gia_ObjIsXor(pObj) )
+        return pObj->Value = Gia_ManHashXor( pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+    return pObj->Value = Gia_ManHashAnd( pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+}
+int Gia_RsbCommitOutput( Gia_Man_t * pNew, Gia_Man_t * p, Gia_Man_t * pWin, Vec_Int_t * vIns, int iOut )
+{
+    Gia_Obj_t * pObj; int i;
+    // the inputs in the support of this output are already constructed
+    Gia_ManForEachCi( pWin, pObj, i )
+        pObj->Value = Gia_ManObj( p, Vec_IntEntry(vIns, i) )->Value;
+    pObj = Gia_ManCo( pWin, iOut );
+    Gia_RsbCommitOutput_rec( pNew, pWin, Gia_ObjFanin0(pObj) );
+    return Gia_ObjFanin0Copy( pObj );
+}
+Gia_Man_t * Gia_RsbCommitWindows( Gia_Man_t * p, Vec_Wec_t * vWins, Vec_Wec_t * vInss, Vec_Wec_t * vOutss, Vec_Ptr_t * vGiaOuts, Vec_Int_t * vCommit )
+{
+    Gia_Man_t * pNew, * pTemp, * pWin;
+    Vec_Int_t * vWinIds = Vec_IntStartFull( Gia_ManObjNum(p) );
+    Vec_Int_t * vOutIds = Vec_IntStartFull( Gia_ManObjNum(p) );
+    Vec_Int_t * vWin, * vOuts;
+    Gia_Obj_t * pObj;
+    int i, k, iObj, w;
+    // mark the internal nodes and the outputs of the committed windows
+    Vec_IntForEachEntry( vCommit, w, i )
+    {
+        vWin  = Vec_WecEntry( vWins, w );
+        vOuts = Vec_WecEntry( vOutss, w );
+        Vec_IntForEachEntry( vWin, iObj, k )
+            if ( Vec_IntFind(Vec_WecEntry(vInss, w), iObj) == -1 )
+                Vec_IntWriteEntry( vWinIds, iObj, w );
+        Vec_IntForEachEntry( vOuts, iObj, k )
+            Vec_IntWriteEntry( vOutIds, iObj, k );
+        pWin = (Gia_Man_t *)Vec_PtrEntry( vGiaOuts, w );
+        Gia_ManFillValue( pWin );
+        Gia_ManConst0(pWin)->Value = 0;
+    }
+    // construct the new AIG
+    pNew = Gia_ManStart( Gia_ManObjNum(p) );
+    pNew->pName = Abc_UtilStrsav( p->pName );
+    pNew->pSpec = Abc_UtilStrsav( p->pSpec );
+    Gia_ManHashAlloc( pNew );
+    Gia_ManFillValue( p );
+    Gia_ManConst0(p)->Value = 0;
+    Gia_ManForEachCi( p, pObj, i )
+        pObj->Value = Gia_ManAppendCi( pNew );
+    Gia_ManForEachAnd( p, pObj, i )
+    {
+        w = Vec_IntEntry( vWinIds, i );
+        if ( w == -1 && Gia_ObjIsXor(pObj) )
+            pObj->Value = Gia_ManHashXor( pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+        else if ( w == -1 )
+            pObj->Value = Gia_ManHashAnd( pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+        else if ( Vec_IntEntry(vOutIds, i) >= 0 )
+            pObj->Value = Gia_RsbCommitOutput( pNew, p, (Gia_Man_t *)Vec_PtrEntry(vGiaOuts, w), Vec_WecEntry(vInss, w), Vec_IntEntry(vOutIds, i) );
+    }
+    Gia_ManForEachCo( p, pObj, i )
+        pObj->Value = Gia_ManAppendCo( pNew, Gia_ObjFanin0Copy(pObj) );
+    Gia_ManHashStop( pNew );
+    Gia_ManSetRegNum( pNew, Gia_ManRegNum(p) );
+    Vec_IntFree( vWinIds );
+    Vec_IntFree( vOutIds );
+    pNew = Gia_ManCleanup( pTemp = pNew );
+    Gia_ManStop( pTemp );
+    return pNew;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Windowed resubstitution.]
+
+  Description [Collects non-overlapping windows with at most nCutSize 
+  inputs (up to nWinCount windows, if nWinCount is not 0), performs 
+  resubstitution of the windows on nProcs threads, and commits the 
+  improved windows one at a time after re-checking them. The windows 
+  do not include the control inputs of MUXes, so an AIG with MUXes 
+  is expanded into ANDs first.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Man_t * Gia_ManPerformNewResub( Gia_Man_t * p, int nWinCount, int nCutSize, int nProcs, int fVerbose )
+{
+    int nLevelsMax = 8;
+    Gia_Man_t * pNew, * pIn, * pOut, * pNoMux = NULL;
+    Vec_Wec_t * vWins  = Vec_WecAlloc( 1000 );
+    Vec_Wec_t * vInss  = Vec_WecAlloc( 1000 );
+    Vec_Wec_t * vOutss = Vec_WecAlloc( 1000 );
+    Vec_Int_t * vCommit = Vec_IntAlloc( 1000 );
+    Vec_Int_t * vSupps  = Vec_IntAlloc( 1000 );
+    Vec_Int_t * vSupps2 = Vec_IntAlloc( 1000 );
+    Vec_Ptr_t * vGiaIns, * vGiaOuts;
+    int i, nGain = 0;
+    abctime clkWin, clkRes, clkCom, clk = Abc_Clock();
+    nCutSize = Abc_MinInt( nCutSize, 6 );
+    if ( p->pMuxes )
+        p = pNoMux = Gia_ManDupNoMuxes( p, 0 );
+    // collect the windows
+    Gia_RsbCollectWindows( p, nWinCount, nCutSize, nLevelsMax, vWins, vInss, vOutss );
+    vGiaIns  = Vec_PtrAlloc( Vec_WecSize(vWins) );
+    vGiaOuts = Vec_PtrStart( Vec_WecSize(vWins) );
+    for ( i = 0; i < Vec_WecSize(vWins); i++ )
+        Vec_PtrPush( vGiaIns, Gia_RsbDeriveGiaFromWindows(p, Vec_WecEntry(vWins, i), Vec_WecEntry(vInss, i), Vec_WecEntry(vOutss, i)) );
+    clkWin = Abc_Clock() - clk; clk = Abc_Clock();
+    // resubstitute the windows
+    Gia_RsbPerformWindows( vGiaIns, vGiaOuts, nProcs );
+    clkRes = Abc_Clock() - clk; clk = Abc_Clock();
+    // commit the improved windows
+    Vec_PtrForEachEntryTwo( Gia_Man_t *, vGiaIns, Gia_Man_t *, vGiaOuts, pIn, pOut, i )
+        if ( Gia_RsbWindowCanCommit(pIn, pOut, vSupps, vSupps2) )
+        {
+            Vec_IntPush( vCommit, i );
+            nGain += Gia_ManAndNum(pIn) - Gia_ManAndNum(pOut);
+        }
+    pNew = Gia_RsbCommitWindows( p, vWins, vInss, vOutss, vGiaOuts, vCommit );
+    clkCom = Abc_Clock() - clk;
+    if ( fVerbose )
+    {
+        printf( "Windows = %d.  Committed = %d.  Window gain = %d.  Nodes: %d -> %d.  Threads = %d.\n", 
+            Vec_WecSize(vWins), Vec_IntSize(vCommit), nGain, Gia_ManAndNum(p), Gia_ManAndNum(pNew), nProcs );
+        Abc_PrintTime( 1, "Windowing  ", clkWin );
+        Abc_PrintTime( 1, "Resub      ", clkRes );
+        Abc_PrintTime( 1, "Commit     ", clkCom );
+    }
+    Vec_PtrForEachEntry( Gia_Man_t *, vGiaIns, pIn, i )
+        Gia_ManStop( pIn );
+    Vec_PtrForEachEntry( Gia_Man_t *, vGiaOuts, pOut, i )
+        Gia_ManStop( pOut );
+    Vec_PtrFree( vGiaIns );
+    Vec_PtrFree( vGiaOuts );
+    Vec_WecFree( vWins );
+    Vec_WecFree( vInss );
+    Vec_WecFree( vOutss );
+    Vec_IntFree( vCommit );
+    Vec_IntFree( vSupps );
+    Vec_IntFree( vSupps2 );
+    if ( pNoMux )
+        Gia_ManStop( pNoMux );
+    return pNew;
+}
 
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
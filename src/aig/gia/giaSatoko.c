@@ -22,6 +22,7 @@
 #include "sat/cnf/cnf.h"
 #include "misc/extra/extra.h"
 #include "sat/satoko/satoko.h"
+#include "sat/bmc/bmcSat.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -264,6 +265,73 @@ void Gia_ManSatokoCall( Gia_Man_t * p, satoko_opts_t * opts, int fSplit, int fIn
     Gia_ManSatokoCallOne( p, opts, -1 );
 }    
 
+/**Function*************************************************************
+
+  Synopsis    [Compares Satoko with the other solvers on the same CNF.]
+
+  Description [Solves the CNF of the miter using Satoko, sat_solver and
+  Glucose2 with the same conflict limit and prints the status, the number
+  of conflicts and propagations, and the propagation rate of each solver.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Gia_ManSatokoBenchReport( char * pName, int status, long nConfs, long nProps, abctime clk )
+{
+    Abc_Print( 1, "%-10s : ", pName );
+    if ( status == 0 )
+        Abc_Print( 1, "UNDECIDED      " );
+    else if ( status == 1 )
+        Abc_Print( 1, "SATISFIABLE    " );
+    else
+        Abc_Print( 1, "UNSATISFIABLE  " );
+    Abc_Print( 1, "Conf =%9ld  ", nConfs );
+    Abc_Print( 1, "Prop =%11ld  Rate =%7.2f Mprop/sec  ", nProps, clk ? 1.0 * nProps * CLOCKS_PER_SEC / clk / 1000000 : 0.0 );
+    Abc_PrintTime( 1, "Time", clk );
+}
+void Gia_ManSatokoBench( Gia_Man_t * p, satoko_opts_t * opts )
+{
+    Cnf_Dat_t * pCnf = (Cnf_Dat_t *)Mf_ManGenerateCnf( p, 8, 0, 1, 0, 0 );
+    satoko_t * pSatoko;
+    Bmc_Sat_t * pSat;
+    abctime clk;
+    int i, Type, status;
+    Abc_Print( 1, "CNF has %d variables, %d clauses, and %d literals.\n", pCnf->nVars, pCnf->nClauses, pCnf->nLiterals );
+    // Satoko
+    clk = Abc_Clock();
+    pSatoko = Gia_ManSatokoInit( pCnf, opts );
+    status = pSatoko ? satoko_simplify(pSatoko) : SATOKO_ERR;
+    if ( status == SATOKO_OK )
+        status = satoko_solve( pSatoko );
+    else
+        status = SATOKO_UNSAT;
+    Gia_ManSatokoBenchReport( "satoko", status == SATOKO_SAT ? 1 : status == SATOKO_UNSAT ? -1 : 0, 
+        pSatoko ? satoko_stats(pSatoko)->n_conflicts : 0, pSatoko ? satoko_stats(pSatoko)->n_propagations : 0, Abc_Clock() - clk );
+    if ( pSatoko )
+        satoko_destroy( pSatoko );
+    // other solvers through the uniform interface
+    for ( Type = BMC_SAT_BSAT; Type < BMC_SAT_NONE; Type++ )
+    {
+        if ( Type == BMC_SAT_SATOKO )
+            continue;
+        clk = Abc_Clock();
+        pSat = Bmc_SatStart( (Bmc_SatType_t)Type );
+        Bmc_SatSetNVars( pSat, pCnf->nVars );
+        Bmc_SatSetConfLimit( pSat, (ABC_INT64_T)opts->conf_limit );
+        status = 0;
+        for ( i = 0; i < pCnf->nClauses; i++ )
+            if ( !Bmc_SatAddClause( pSat, pCnf->pClauses[i], pCnf->pClauses[i+1]-pCnf->pClauses[i] ) )
+                status = -1;
+        if ( status == 0 )
+            status = Bmc_SatSolve( pSat, NULL, 0 );
+        Gia_ManSatokoBenchReport( Bmc_SatTypeName((Bmc_SatType_t)Type), status, (long)Bmc_SatConfNum(pSat), (long)Bmc_SatPropNum(pSat), Abc_Clock() - clk );
+        Bmc_SatStop( pSat );
+    }
+    Cnf_DataFree( pCnf );
+}
+
 
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
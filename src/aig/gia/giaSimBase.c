@@ -21,7 +21,7 @@
 #include "gia.h"
 #include "misc/util/utilTruth.h"
 #include "misc/extra/extra.h"
-//#include <immintrin.h>
+#include "misc/util/utilSimd.h"
 #include "aig/miniaig/miniaig.h"
 
 ABC_NAMESPACE_IMPL_START
@@ -99,7 +99,21 @@ static inline void Gia_ManSimPatSimAnd( Gia_Man_t * p, int i, Gia_Obj_t * pObj,
     word * pSims0 = pSims + nWords*Gia_ObjFaninId0(pObj, i);
     word * pSims1 = pSims + nWords*Gia_ObjFaninId1(pObj, i);
     word * pSims2 = pSims + nWords*i; int w;
-    if ( Gia_ObjIsXor(pObj) )
+    if ( Gia_ObjIsMux(p, pObj) )
+    {
+        word * pSimsC = pSims + nWords*Gia_ObjFaninId2(p, i);
+        word DiffC = pComps[Gia_ObjFaninC2(p, pObj)];
+        if ( nWords >= ABC_SIMD_WORDS_MIN )
+            Abc_SimdMux( pSims2, pSimsC, pSims1, pSims0, Gia_ObjFaninC2(p, pObj), Gia_ObjFaninC1(pObj), Gia_ObjFaninC0(pObj), nWords );
+        else
+            for ( w = 0; w < nWords; w++ )
+                pSims2[w] = ((pSimsC[w] ^ DiffC) & (pSims1[w] ^ Diff1)) | (~(pSimsC[w] ^ DiffC) & (pSims0[w] ^ Diff0));
+    }
+    else if ( nWords >= ABC_SIMD_WORDS_MIN && Gia_ObjIsXor(pObj) )
+        Abc_SimdXor( pSims2, pSims0, pSims1, Gia_ObjFaninC0(pObj) ^ Gia_ObjFaninC1(pObj), nWords );
+    else if ( nWords >= ABC_SIMD_WORDS_MIN )
+        Abc_SimdAnd( pSims2, pSims0, pSims1, Gia_ObjFaninC0(pObj), Gia_ObjFaninC1(pObj), nWords );
+    else if ( Gia_ObjIsXor(pObj) )
         for ( w = 0; w < nWords; w++ )
             pSims2[w] = (pSims0[w] ^ Diff0) ^ (pSims1[w] ^ Diff1);
     else
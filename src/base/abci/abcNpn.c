@@ -25,6 +25,16 @@
 #include "bool/lucky/lucky.h"
 #include "opt/dau/dau.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 
@@ -52,6 +62,25 @@ extern Abc_TtStore_t * Abc_TtStoreLoad( char * pFileName, int nVarNum );
 extern void            Abc_TtStoreFree( Abc_TtStore_t * p, int nVarNum );
 extern void            Abc_TtStoreWrite( char * pFileName, Abc_TtStore_t * p, int fBinary );
 
+#define NPN_PROC_MAX 64
+
+// data-structure passed to the batch canonization threads
+typedef struct Abc_NpnThData_t_ Abc_NpnThData_t;
+struct Abc_NpnThData_t_
+{
+    Abc_TtStore_t *    p;          // truth tables
+    int                NpnType;    // canonization algorithm
+    permInfo *         pi;         // permutation info (exact NPN only)
+    int                iStart;     // first function of the range
+    int                iStop;      // last function of the range (exclusive)
+    int                iShard;     // the hash table shard of this thread
+    int                nShards;    // the number of shards
+    int                nTableSize; // the hash table size
+    int *              pKeys;      // hash keys of the functions
+    int *              pTable;     // hash table
+    int *              pNexts;     // hash table chains
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -113,6 +142,108 @@ int Abc_TruthNpnCountUnique( Abc_TtStore_t * p )
     return (p->nFuncs = k);
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Counts the number of unique truth tables using threads.]
+
+  Description [The hash keys are computed in parallel. Each thread then 
+  owns the buckets whose key is equal to its index modulo the number of 
+  threads and visits its functions in the original order, so the same 
+  functions are kept as by Abc_TruthNpnCountUnique().]
+               
+  SideEffects [] 
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Abc_TruthNpnRunThreads( Abc_NpnThData_t * pThData, int nThreads, void * (*pFunc)(void *) )
+{
+#ifdef ABC_USE_PTHREADS
+    pthread_t WorkerThread[NPN_PROC_MAX];
+    int i, status;
+    for ( i = 0; i < nThreads; i++ )
+    {
+        status = pthread_create( WorkerThread + i, NULL, pFunc, (void *)(pThData + i) );
+        assert( status == 0 );
+    }
+    for ( i = 0; i < nThreads; i++ )
+    {
+        status = pthread_join( WorkerThread[i], NULL );
+        assert( status == 0 );
+    }
+#else
+    int i;
+    for ( i = 0; i < nThreads; i++ )
+        pFunc( (void *)(pThData + i) );
+#endif
+}
+static void * Abc_TruthNpnWorkerKeys( void * pArg )
+{
+    Abc_NpnThData_t * pThData = (Abc_NpnThData_t *)pArg;
+    Abc_TtStore_t * p = pThData->p;
+    int i;
+    for ( i = pThData->iStart; i < pThData->iStop; i++ )
+        pThData->pKeys[i] = Abc_TruthHashKey( p->pFuncs[i], p->nWords, pThData->nTableSize );
+    return NULL;
+}
+static void * Abc_TruthNpnWorkerHash( void * pArg )
+{
+    Abc_NpnThData_t * pThData = (Abc_NpnThData_t *)pArg;
+    Abc_TtStore_t * p = pThData->p;
+    int i, Key;
+    for ( i = 0; i < p->nFuncs; i++ )
+    {
+        Key = pThData->pKeys[i];
+        if ( Key % pThData->nShards != pThData->iShard )
+            continue;
+        if ( Abc_TruthHashLookup( p->pFuncs, i, p->nWords, pThData->pTable, pThData->pNexts, Key ) ) // found equal
+            p->pFuncs[i] = NULL;
+        else // there is no equal (the first time this one occurs so far)
+            pThData->pNexts[i] = pThData->pTable[Key], pThData->pTable[Key] = i;
+    }
+    return NULL;
+}
+int Abc_TruthNpnCountUniqueMt( Abc_TtStore_t * p, int nThreads )
+{
+    Abc_NpnThData_t ThData[NPN_PROC_MAX];
+    int nTableSize, * pTable, * pNexts, * pKeys;
+    int i, k, nStep;
+    nThreads = Abc_MinInt( nThreads, NPN_PROC_MAX );
+    if ( nThreads < 2 || p->nFuncs < 2 * nThreads )
+        return Abc_TruthNpnCountUnique( p );
+    // allocate hash table
+    nTableSize = Abc_PrimeCudd(p->nFuncs);
+    pTable = ABC_FALLOC( int, nTableSize );
+    pNexts = ABC_FALLOC( int, nTableSize );
+    pKeys  = ABC_ALLOC( int, p->nFuncs );
+    // compute the keys and hash functions
+    nStep  = (p->nFuncs + nThreads - 1) / nThreads;
+    memset( ThData, 0, sizeof(Abc_NpnThData_t) * nThreads );
+    for ( i = 0; i < nThreads; i++ )
+    {
+        ThData[i].p          = p;
+        ThData[i].iStart     = Abc_MinInt( i * nStep, p->nFuncs );
+        ThData[i].iStop      = Abc_MinInt( (i + 1) * nStep, p->nFuncs );
+        ThData[i].iShard     = i;
+        ThData[i].nShards    = nThreads;
+        ThData[i].nTableSize = nTableSize;
+        ThData[i].pKeys      = pKeys;
+        ThData[i].pTable     = pTable;
+        ThData[i].pNexts     = pNexts;
+    }
+    Abc_TruthNpnRunThreads( ThData, nThreads, Abc_TruthNpnWorkerKeys );
+    Abc_TruthNpnRunThreads( ThData, nThreads, Abc_TruthNpnWorkerHash );
+    ABC_FREE( pTable );
+    ABC_FREE( pNexts );
+    ABC_FREE( pKeys );
+    // count the number of unqiue functions
+    assert( p->pFuncs[0] != NULL );
+    for ( i = k = 1; i < p->nFuncs; i++ )
+        if ( p->pFuncs[i] != NULL )
+            p->pFuncs[k++] = p->pFuncs[i];
+    return (p->nFuncs = k);
+}
+
 /**Function*************************************************************
 
   Synopsis    [Counts the number of unique truth tables.]
@@ -163,6 +294,88 @@ void Abc_TruthNpnPrint( char * pCanonPermInit, unsigned uCanonPhase, int nVars )
     printf( " )  " );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Canonizes a batch of truth tables using threads.]
+
+  Description [Each thread canonizes a contiguous range of functions in 
+  place with its own scratch buffers. Only the algorithms whose result 
+  does not depend on the previously seen functions are supported.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_TruthNpnCanMt( int NpnType )
+{
+    return (NpnType >= 1 && NpnType <= 6) || NpnType == 12;
+}
+static void * Abc_TruthNpnWorkerCanon( void * pArg )
+{
+    Abc_NpnThData_t * pThData = (Abc_NpnThData_t *)pArg;
+    Abc_TtStore_t * p = pThData->p;
+    unsigned pAux[2048];
+    word pAuxWord[1024], pAuxWord1[1024];
+    char pCanonPerm[16];
+    int i;
+    for ( i = pThData->iStart; i < pThData->iStop; i++ )
+    {
+        if ( pThData->NpnType == 1 )
+            simpleMinimal( p->pFuncs[i], pAuxWord, pAuxWord1, pThData->pi, p->nVars );
+        else if ( pThData->NpnType == 2 )
+        {
+            resetPCanonPermArray( pCanonPerm, p->nVars );
+            Kit_TruthSemiCanonicize( (unsigned *)p->pFuncs[i], pAux, p->nVars, pCanonPerm );
+        }
+        else if ( pThData->NpnType == 3 )
+        {
+            resetPCanonPermArray( pCanonPerm, p->nVars );
+            luckyCanonicizer_final_fast( p->pFuncs[i], p->nVars, pCanonPerm );
+        }
+        else if ( pThData->NpnType == 4 )
+        {
+            resetPCanonPermArray( pCanonPerm, p->nVars );
+            luckyCanonicizer_final_fast1( p->pFuncs[i], p->nVars, pCanonPerm );
+        }
+        else if ( pThData->NpnType == 5 )
+            Abc_TtCanonicize( p->pFuncs[i], p->nVars, pCanonPerm );
+        else if ( pThData->NpnType == 6 )
+            Abc_TtCanonicizePhase( p->pFuncs[i], p->nVars );
+        else if ( pThData->NpnType == 12 )
+            Abc_TtCanonicizePerm( p->pFuncs[i], p->nVars, pCanonPerm );
+        else assert( 0 );
+    }
+    return NULL;
+}
+void Abc_TruthNpnPerformMt( Abc_TtStore_t * p, int NpnType, int nThreads )
+{
+    Abc_NpnThData_t ThData[NPN_PROC_MAX];
+    permInfo * pi = NULL;
+    int i, nStep;
+    assert( Abc_TruthNpnCanMt(NpnType) );
+    nThreads = Abc_MinInt( nThreads, NPN_PROC_MAX );
+    if ( NpnType == 1 )
+    {
+        Abc_TruthNpnCountUniqueMt( p, nThreads );
+        pi = setPermInfoPtr( p->nVars );
+    }
+    nThreads = Abc_MaxInt( 1, Abc_MinInt( nThreads, p->nFuncs ) );
+    nStep    = (p->nFuncs + nThreads - 1) / nThreads;
+    memset( ThData, 0, sizeof(Abc_NpnThData_t) * nThreads );
+    for ( i = 0; i < nThreads; i++ )
+    {
+        ThData[i].p       = p;
+        ThData[i].NpnType = NpnType;
+        ThData[i].pi      = pi;
+        ThData[i].iStart  = Abc_MinInt( i * nStep, p->nFuncs );
+        ThData[i].iStop   = Abc_MinInt( (i + 1) * nStep, p->nFuncs );
+    }
+    Abc_TruthNpnRunThreads( ThData, nThreads, Abc_TruthNpnWorkerCanon );
+    if ( pi )
+        freePermInfoPtr( pi );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Apply decomposition to the truth table.]
@@ -174,7 +387,7 @@ void Abc_TruthNpnPrint( char * pCanonPermInit, unsigned uCanonPhase, int nVars )
   SeeAlso     []
 
 ***********************************************************************/
-void Abc_TruthNpnPerform( Abc_TtStore_t * p, int NpnType, int fVerbose )
+void Abc_TruthNpnPerform( Abc_TtStore_t * p, int NpnType, int nThreads, int fVerbose )
 {
     unsigned pAux[2048];
     word pAuxWord[1024], pAuxWord1[1024];
@@ -218,7 +431,9 @@ void Abc_TruthNpnPerform( Abc_TtStore_t * p, int NpnType, int fVerbose )
     if ( fVerbose )
         printf( "\n" );
 
-    if ( NpnType == 0 )
+    if ( nThreads > 1 && !fVerbose && Abc_TruthNpnCanMt(NpnType) )
+        Abc_TruthNpnPerformMt( p, NpnType, nThreads );
+    else if ( NpnType == 0 )
     {
         for ( i = 0; i < p->nFuncs; i++ )
         {
@@ -371,7 +586,7 @@ void Abc_TruthNpnPerform( Abc_TtStore_t * p, int NpnType, int fVerbose )
     }
     else assert( 0 );
     clk = Abc_Clock() - clk;
-    printf( "Classes =%9d  ", Abc_TruthNpnCountUnique(p) );
+    printf( "Classes =%9d  ", Abc_TruthNpnCountUniqueMt(p, nThreads) );
     Abc_PrintTime( 1, "Time", clk );
 }
 
@@ -386,7 +601,7 @@ void Abc_TruthNpnPerform( Abc_TtStore_t * p, int NpnType, int fVerbose )
   SeeAlso     []
 
 ***********************************************************************/
-void Abc_TruthNpnTest( char * pFileName, int NpnType, int nVarNum, int fDumpRes, int fBinary, int fVerbose )
+void Abc_TruthNpnTest( char * pFileName, int NpnType, int nVarNum, int nThreads, int fDumpRes, int fBinary, int fVerbose )
 {
     Abc_TtStore_t * p;
     char * pFileNameOut;
@@ -397,7 +612,7 @@ void Abc_TruthNpnTest( char * pFileName, int NpnType, int nVarNum, int fDumpRes,
         return;
 
     // consider functions from the file
-    Abc_TruthNpnPerform( p, NpnType, fVerbose );
+    Abc_TruthNpnPerform( p, NpnType, nThreads, fVerbose );
 
     // write the result
     if ( fDumpRes )
@@ -428,12 +643,12 @@ void Abc_TruthNpnTest( char * pFileName, int NpnType, int nVarNum, int fDumpRes,
   SeeAlso     []
 
 ***********************************************************************/
-int Abc_NpnTest( char * pFileName, int NpnType, int nVarNum, int fDumpRes, int fBinary, int fVerbose )
+int Abc_NpnTest( char * pFileName, int NpnType, int nVarNum, int nThreads, int fDumpRes, int fBinary, int fVerbose )
 {
     if ( fVerbose )
         printf( "Using truth tables from file \"%s\"...\n", pFileName );
     if ( NpnType >= 0 && NpnType <= 12 )
-        Abc_TruthNpnTest( pFileName, NpnType, nVarNum, fDumpRes, fBinary, fVerbose );
+        Abc_TruthNpnTest( pFileName, NpnType, nVarNum, nThreads, fDumpRes, fBinary, fVerbose );
     else
         printf( "Unknown canonical form value (%d).\n", NpnType );
     fflush( stdout );
@@ -83,6 +83,7 @@ void Cmd_Init( Abc_Frame_t * pAbc )
     pAbc->tAliases  = st__init_table(strcmp, st__strhash);
     pAbc->tFlags    = st__init_table(strcmp, st__strhash);
     pAbc->aHistory  = Vec_PtrAlloc( 100 );
+    if ( !pAbc->fWorker )
     Cmd_HistoryRead( pAbc );
 
     Cmd_CommandAdd( pAbc, "Basic", "time",          CmdCommandTime,            0 );
@@ -131,6 +132,7 @@ void Cmd_End( Abc_Frame_t * pAbc )
 {
     st__generator * gen;
     char * pKey, * pValue;
+    if ( !pAbc->fWorker )
     Cmd_HistoryWrite( pAbc, ABC_INFINITY );
 
 //    st__free_table( pAbc->tCommands, (void (*)()) 0, CmdCommandFree );
@@ -2386,13 +2388,15 @@ usage:
 int CmdCommandStarter( Abc_Frame_t * pAbc, int argc, char ** argv )
 {
     extern void Cmd_RunStarter( char * pFileName, char * pBinary, char * pCommand, int nCores );
+    extern void Cmd_RunStarterThreads( Abc_Frame_t * pAbc, char * pFileName, char * pCommand, int nCores, int fVerbose );
     FILE * pFile;
     char * pFileName;
     char * pCommand = NULL;
     int c, nCores    =  3;
+    int fThreads     =  0;
     int fVerbose     =  0;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "NCvh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "NCtvh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -2416,6 +2420,9 @@ int CmdCommandStarter( Abc_Frame_t * pAbc, int argc, char ** argv )
             pCommand = argv[globalUtilOptind];
             globalUtilOptind++;
             break;
+        case 't':
+            fThreads ^= 1;
+            break;
         case 'v':
             fVerbose ^= 1;
             break;
@@ -2443,14 +2450,29 @@ int CmdCommandStarter( Abc_Frame_t * pAbc, int argc, char ** argv )
     }
     fclose( pFile );
     // run commands
-    Cmd_RunStarter( pFileName, pAbc->sBinary, pCommand, nCores );
+    if ( fThreads )
+    {
+        if ( pCommand == NULL )
+        {
+            Abc_Print( -1, "Running jobs in threads requires the command line to be given (switch \"-C\").\n" );
+            return 1;
+        }
+        Cmd_RunStarterThreads( pAbc, pFileName, pCommand, nCores, fVerbose );
+    }
+    else
+        Cmd_RunStarter( pFileName, pAbc->sBinary, pCommand, nCores );
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: starter [-N num] [-C cmd] [-vh] <file>\n" );
+    Abc_Print( -2, "usage: starter [-N num] [-C cmd] [-tvh] <file>\n" );
     Abc_Print( -2, "\t         runs command lines listed in <file> concurrently on <num> CPUs\n" );
     Abc_Print( -2, "\t-N num : the number of concurrent jobs including the controller [default = %d]\n", nCores );
     Abc_Print( -2, "\t-C cmd : (optional) ABC command line to execute on benchmarks in <file>\n" );
+    Abc_Print( -2, "\t-t     : toggle running the jobs in threads of this process, each in its own frame,\n" );
+    Abc_Print( -2, "\t         rather than in separate ABC binaries [default = %s]\n", fThreads? "yes": "no" );
+    Abc_Print( -2, "\t         (the libraries loaded by the time of this call are shared by all jobs and\n" );
+    Abc_Print( -2, "\t         should not be replaced by <cmd>; the output of the jobs is not separated;\n" );
+    Abc_Print( -2, "\t         the commands starting with \"read\" are executed by one job at a time)\n" );
     Abc_Print( -2, "\t-v     : toggle printing verbose information [default = %s]\n", fVerbose? "yes": "no" );
     Abc_Print( -2, "\t-h     : print the command usage\n");
     Abc_Print( -2, "\t<file> : file name with ABC command lines (or benchmark names, if <cmd> is given)\n");
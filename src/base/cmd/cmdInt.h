@@ -68,6 +68,9 @@ extern void       CmdCommandAliasAdd( Abc_Frame_t * pAbc, char * sName, int argc
 extern void       CmdCommandAliasPrint( Abc_Frame_t * pAbc, Abc_Alias * pAlias );
 extern char *     CmdCommandAliasLookup( Abc_Frame_t * pAbc, char * sCommand );
 extern void       CmdCommandAliasFree( Abc_Alias * p );
+/*=== cmdStarter.c =====================================================*/
+extern void       Cmd_RunStarterReadStart( Abc_Frame_t * pAbc, char * pName );
+extern void       Cmd_RunStarterReadStop( Abc_Frame_t * pAbc, char * pName );
 /*=== cmdUtils.c =======================================================*/
 extern int        CmdCommandDispatch( Abc_Frame_t * pAbc, int * argc, char *** argv );
 extern const char *     CmdSplitLine( Abc_Frame_t * pAbc, const char * sCommand, int * argc, char *** argv );
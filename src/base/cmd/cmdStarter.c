@@ -24,6 +24,9 @@
 #include <assert.h>
 #include "misc/util/abc_global.h"
 #include "misc/extra/extra.h"
+#include "cmdInt.h"
+#include "map/mio/mio.h"
+#include "map/mapper/mapper.h"
 
 #ifdef ABC_USE_PTHREADS
 
@@ -45,6 +48,9 @@ ABC_NAMESPACE_IMPL_START
 #ifndef ABC_USE_PTHREADS
 
 void Cmd_RunStarter( char * pFileName, char * pBinary, char * pCommand, int nCores ) {}
+void Cmd_RunStarterThreads( Abc_Frame_t * pAbc, char * pFileName, char * pCommand, int nCores, int fVerbose ) {}
+void Cmd_RunStarterReadStart( Abc_Frame_t * pAbc, char * pName ) {}
+void Cmd_RunStarterReadStop( Abc_Frame_t * pAbc, char * pName ) {}
 
 #else // pthreads are used
 
@@ -54,6 +60,23 @@ static volatile int nThreadsRunning = 0;
 // mutex to control access to the number of threads
 pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
 
+// mutex to serialize the reader commands of the worker frames
+static pthread_mutex_t s_ReadMutex = PTHREAD_MUTEX_INITIALIZER;
+// the number of reader commands entered by this thread
+static ABC_THREAD_LOCAL int s_ReadDepth = 0;
+
+// the job server running scripts in the worker frames of this process
+typedef struct Cmd_Jobs_t_ Cmd_Jobs_t;
+struct Cmd_Jobs_t_
+{
+    Abc_Frame_t *     pMain;          // the main frame (owner of the libraries)
+    Vec_Ptr_t *       vNames;         // design names
+    char *            pCommand;       // the script to run on each design
+    int               fVerbose;       // verbosity flag
+    volatile int      iNext;          // the next job to be taken
+    volatile int      nFailed;        // the number of failed jobs
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -249,6 +272,273 @@ void Cmd_RunStarter( char * pFileName, char * pBinary, char * pCommand, int nCor
     fflush( stdout );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Atomically increments the counter and returns its old value.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Cmd_JobsFetchAdd( volatile int * pCounter, int Value )
+{
+#if defined(__GNUC__)
+    return __sync_fetch_and_add( pCounter, Value );
+#else
+    int Old, status;
+    status = pthread_mutex_lock(&mutex);   assert(status == 0);
+    Old = *pCounter;
+    *pCounter += Value;
+    status = pthread_mutex_unlock(&mutex); assert(status == 0);
+    return Old;
+#endif
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Serializes the reader commands of the worker frames.]
+
+  Description [Many readers (read_genlib, read_bench, read_eqn, etc)
+  tokenize the input with strtok(), which keeps its position in a global
+  variable, so the commands whose name starts with "read" are executed
+  by one job at a time. The nested calls of the same thread are allowed.
+  The commands of the main frame are not affected.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Cmd_RunStarterIsRead( Abc_Frame_t * pAbc, char * pName )
+{
+    return pAbc->fWorker && !strncmp( pName, "read", 4 );
+}
+void Cmd_RunStarterReadStart( Abc_Frame_t * pAbc, char * pName )
+{
+    int status;
+    if ( !Cmd_RunStarterIsRead(pAbc, pName) || s_ReadDepth++ > 0 )
+        return;
+    status = pthread_mutex_lock(&s_ReadMutex);   assert(status == 0);
+}
+void Cmd_RunStarterReadStop( Abc_Frame_t * pAbc, char * pName )
+{
+    int status;
+    if ( !Cmd_RunStarterIsRead(pAbc, pName) || --s_ReadDepth > 0 )
+        return;
+    status = pthread_mutex_unlock(&s_ReadMutex); assert(status == 0);
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs the script on one design in a fresh frame.]
+
+  Description [The frame is bound to the calling thread and borrows
+  the libraries of the main frame, which are detached before the frame
+  is deleted, so that they are neither re-read nor freed per design.
+  A job replacing a library does not free the borrowed one (see
+  Abc_FrameIsLibShared()), and the new library is owned by the job.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Cmd_RunStarterJob( Cmd_Jobs_t * p, char * pName )
+{
+    Abc_Frame_t * pMain = p->pMain, * pAbc;
+    st__generator * gen;
+    Abc_Alias * pAlias;
+    char * pBuffer, * pKey, * pValue;
+    int RetValue;
+    // start the frame of this job
+    pAbc = Abc_FrameAllocate();
+    pAbc->fWorker    = 1;
+    pAbc->fBatchMode = 1;
+    Abc_FrameSetThreadFrame( pAbc );
+    Abc_FrameInit( pAbc );
+    // inherit the aliases and the variables
+    st__foreach_item( pMain->tAliases, gen, (const char **)&pKey, (char **)&pAlias )
+        CmdCommandAliasAdd( pAbc, pAlias->sName, pAlias->argc, pAlias->argv );
+    st__foreach_item( pMain->tFlags, gen, (const char **)&pKey, (char **)&pValue )
+        if ( Cmd_FlagReadByName(pAbc, pKey) == NULL )
+            Cmd_FlagUpdateValue( pAbc, Extra_UtilStrsav(pKey), pValue );
+    // borrow the libraries
+    pAbc->pLibLut    = pMain->pLibLut;
+    pAbc->pLibBox    = pMain->pLibBox;
+    pAbc->pLibGen    = pMain->pLibGen;
+    pAbc->pLibGen2   = pMain->pLibGen2;
+    pAbc->pLibSuper  = pMain->pLibSuper;
+    pAbc->pLibScl    = pMain->pLibScl;
+    // run the script
+    pBuffer = ABC_ALLOC( char, strlen(pName) + strlen(p->pCommand) + 10 );
+    sprintf( pBuffer, "%s; %s", pName, p->pCommand );
+    RetValue = Cmd_CommandExecute( pAbc, pBuffer );
+    ABC_FREE( pBuffer );
+    // the supergate library derived by the job refers to the shared genlib
+    if ( pAbc->pLibSuper != pMain->pLibSuper )
+    {
+        Map_SuperLibFree( (Map_SuperLib_t *)pAbc->pLibSuper );
+        pAbc->pLibSuper = NULL;
+    }
+    // return the libraries
+    if ( pAbc->pLibLut   == pMain->pLibLut   ) pAbc->pLibLut   = NULL;
+    if ( pAbc->pLibBox   == pMain->pLibBox   ) pAbc->pLibBox   = NULL;
+    if ( pAbc->pLibGen   == pMain->pLibGen   ) pAbc->pLibGen   = NULL;
+    if ( pAbc->pLibGen2  == pMain->pLibGen2  ) pAbc->pLibGen2  = NULL;
+    if ( pAbc->pLibSuper == pMain->pLibSuper ) pAbc->pLibSuper = NULL;
+    if ( pAbc->pLibScl   == pMain->pLibScl   ) pAbc->pLibScl   = NULL;
+    // stop the frame
+    Abc_FrameEnd( pAbc );
+    Abc_FrameSetThreadFrame( NULL );
+    Abc_FrameDeallocate( pAbc );
+    return RetValue;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Worker thread taking jobs until none are left.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void * Cmd_RunStarterWorker( void * pArg )
+{
+    Cmd_Jobs_t * p = (Cmd_Jobs_t *)pArg;
+    char * pName;
+    int iJob;
+    while ( (iJob = Cmd_JobsFetchAdd(&p->iNext, 1)) < Vec_PtrSize(p->vNames) )
+    {
+        pName = (char *)Vec_PtrEntry( p->vNames, iJob );
+        if ( Cmd_RunStarterJob( p, pName ) )
+        {
+            Cmd_JobsFetchAdd( &p->nFailed, 1 );
+            fprintf( stdout, "The script has failed on design \"%s\".\n", pName );
+        }
+        else if ( p->fVerbose )
+            fprintf( stdout, "Finished design \"%s\".\n", pName );
+        fflush( stdout );
+    }
+    pthread_exit( NULL );
+    assert(0);
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs the script on the designs listed in the file.]
+
+  Description [Unlike Cmd_RunStarter(), which calls a new ABC binary
+  for each design, the designs are processed by a pool of threads
+  inside this process. Each job runs in its own frame, while the
+  libraries currently loaded in the main frame are shared by all jobs.
+  The DAR rewriting library is private to each job, the CNF manager
+  is private to each thread, and the portfolio (&pmc), PDR and BMC
+  engines keep their stop state per run. The threads started by the commands of
+  a job are not bound to its frame and see the main frame instead;
+  the thread procedures in ABC work on the data passed to them and
+  do not access the frame, so this matters only for new code calling
+  Abc_FrameGetGlobalFrame() from such threads, which should bind
+  the frame of the caller using Abc_FrameSetThreadFrame().]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Cmd_RunStarterThreads( Abc_Frame_t * pAbc, char * pFileName, char * pCommand, int nCores, int fVerbose )
+{
+    Cmd_Jobs_t Jobs, * p = &Jobs;
+    pthread_t * pThreadIds;
+    FILE * pFile, * pFileTemp;
+    char Buffer[1000];
+    int i, Len, nThreads, status;
+    abctime clk = Abc_Clock();
+
+    // check the number of cores
+    if ( nCores < 2 )
+    {
+        fprintf( stdout, "The number of cores (%d) should be more than 1.\n", nCores ); 
+        return; 
+    }
+    if ( pCommand == NULL )
+    {
+        fprintf( stdout, "The script to run on the designs should be given.\n" ); 
+        return; 
+    }
+    // open the file and make sure it is available
+    pFile = fopen( pFileName, "rb" );
+    if ( pFile == NULL )
+    { 
+        fprintf( stdout, "Input file \"%s\" cannot be opened.\n", pFileName ); 
+        return; 
+    }
+    // read the design names
+    memset( p, 0, sizeof(Cmd_Jobs_t) );
+    p->pMain    = pAbc;
+    p->vNames   = Vec_PtrAlloc( 100 );
+    p->pCommand = pCommand;
+    p->fVerbose = fVerbose;
+    while ( fgets( Buffer, 1000, pFile ) != NULL )
+    {
+        // remove trailing spaces
+        for ( Len = strlen(Buffer) - 1; Len >= 0; Len-- )
+            if ( Buffer[Len] == '\n' || Buffer[Len] == '\r' || Buffer[Len] == '\t' || Buffer[Len] == ' ' )
+                Buffer[Len] = 0;
+            else
+                break;
+        // skip empty lines and comments
+        if ( Buffer[0] == 0 || Buffer[0] == '\t' || Buffer[0] == ' ' || Buffer[0] == '#' )
+            continue;
+        // try to open the file
+        pFileTemp = fopen( Buffer, "rb" );
+        if ( pFileTemp == NULL )
+        {
+            fprintf( stdout, "Starter cannot open file \"%s\".\n", Buffer );
+            fflush( stdout );
+            Vec_PtrFreeFree( p->vNames );
+            fclose( pFile );
+            return;
+        }
+        fclose( pFileTemp );
+        Vec_PtrPush( p->vNames, Abc_UtilStrsav(Buffer) );
+    }
+    fclose( pFile );
+
+    // derive the supergate library once here rather than in each job
+    if ( pAbc->pLibGen && pAbc->pLibSuper == NULL && pAbc->pLibScl == NULL )
+        Map_SuperLibDeriveFromGenlib( (Mio_Library_t *)pAbc->pLibGen, 0 );
+
+    // start the workers (the controller thread is counted among the cores)
+    nThreads = Abc_MinInt( nCores - 1, Vec_PtrSize(p->vNames) );
+    if ( fVerbose )
+        fprintf( stdout, "Running script \"%s\" on %d designs using %d threads.\n", pCommand, Vec_PtrSize(p->vNames), nThreads );
+    fflush( stdout );
+    pThreadIds = ABC_ALLOC( pthread_t, Abc_MaxInt(nThreads, 1) );
+    for ( i = 0; i < nThreads; i++ )
+    {
+        status = pthread_create( pThreadIds + i, NULL, Cmd_RunStarterWorker, (void *)p );  assert( status == 0 );
+    }
+    for ( i = 0; i < nThreads; i++ )
+    {
+        status = pthread_join( pThreadIds[i], NULL );  assert( status == 0 );
+    }
+    ABC_FREE( pThreadIds );
+
+    if ( p->nFailed )
+        fprintf( stdout, "The script has failed on %d out of %d designs.\n", p->nFailed, Vec_PtrSize(p->vNames) );
+    fprintf( stdout, "Finished processing designs in file \"%s\".  ", pFileName );
+    Abc_PrintTime( 1, "Total time", Abc_Clock() - clk );
+    fflush( stdout );
+    Vec_PtrFreeFree( p->vNames );
+}
+
 #endif // pthreads are used
 
 ////////////////////////////////////////////////////////////////////////
@@ -154,7 +154,9 @@ int CmdCommandDispatch( Abc_Frame_t * pAbc, int * pargc, char *** pargv )
     // execute the command
     clk = Extra_CpuTimeDouble();
     pFunc = (int (*)(Abc_Frame_t *, int, char **))pCommand->pFunc;
+    Cmd_RunStarterReadStart( pAbc, argv[0] );
     fError = (*pFunc)( pAbc, argc, argv );
+    Cmd_RunStarterReadStop( pAbc, argv[0] );
     pAbc->TimeCommand += Extra_CpuTimeDouble() - clk;
 
     // automatic execution of arbitrary command after each command 
@@ -199,7 +199,9 @@ void call_ends(Abc_Frame_t* pAbc) {
 
 void Libs_Init(Abc_Frame_t * pAbc)
 {
-    open_libs();
+    // worker frames reuse the libraries opened by the main frame
+    if ( !pAbc->fWorker )
+        open_libs();
     call_inits(pAbc);
 }
 
@@ -19,6 +19,7 @@
 ***********************************************************************/
 
 #include "amapInt.h"
+#include "base/main/main.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -66,7 +67,7 @@ Amap_Lib_t * Amap_LibAlloc()
 ***********************************************************************/
 void Amap_LibFree( Amap_Lib_t * p )
 {
-    if ( p == NULL )
+    if ( p == NULL || Abc_FrameIsLibShared(p) )
         return;
     if ( p->vSelect )
         Vec_PtrFree( p->vSelect );
@@ -17,6 +17,7 @@
 ***********************************************************************/
 
 #include "fpgaInt.h"
+#include "base/main/main.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -184,7 +185,7 @@ Fpga_LutLib_t * Fpga_LutLibDup( Fpga_LutLib_t * p )
 ***********************************************************************/
 void Fpga_LutLibFree( Fpga_LutLib_t * pLutLib )
 {
-    if ( pLutLib == NULL )
+    if ( pLutLib == NULL || Abc_FrameIsLibShared(pLutLib) )
         return;
     ABC_FREE( pLutLib->pName );
     ABC_FREE( pLutLib );
@@ -112,6 +112,7 @@ struct If_Par_t_
     int                nStructType;   // type of the structure
     int                nAndDelay;     // delay of AND-gate in LUT library units
     int                nAndArea;      // area of AND-gate in LUT library units
+    int                nProcs;        // the number of threads for delay-oriented rounds
     int                fPreprocess;   // preprossing
     int                fArea;         // area-oriented mapping
     int                fFancy;        // a fancy feature
@@ -490,6 +491,9 @@ static inline float      If_CutLutDelay( If_LibLut_t * p, int Size, int iPin )
 // iterator over logic nodes 
 #define If_ManForEachNode( p, pObj, i )                                        \
     If_ManForEachObj( p, pObj, i ) if ( pObj->Type != IF_AND ) {} else
+// iterator over objects whose IDs are stored in the array
+#define If_ManForEachObjVec( vVec, p, pObj, i )                                \
+    for ( i = 0; (i < Vec_IntSize(vVec)) && ((pObj) = If_ManObj(p, Vec_IntEntry(vVec,i))); i++ )
 // iterator over cuts of the node
 #define If_ObjForEachCut( pObj, pCut, i )                                      \
     for ( i = 0; (i < (pObj)->pCutSet->nCuts) && ((pCut) = (pObj)->pCutSet->ppCuts[i]); i++ )
@@ -574,6 +578,8 @@ extern void            Id_DsdManTuneStr( If_DsdMan_t * p, char * pStruct, int nC
 extern void            If_DsdManFree( If_DsdMan_t * p, int fVerbose );
 extern void            If_DsdManSave( If_DsdMan_t * p, char * pFileName );
 extern If_DsdMan_t *   If_DsdManLoad( char * pFileName );
+extern If_DsdMan_t *   If_DsdManCacheStart( int nVars, int LutSize, char * pLutStruct, int fVerbose );
+extern void            If_DsdManCacheUpdate( If_DsdMan_t * p );
 extern void            If_DsdManMerge( If_DsdMan_t * p, If_DsdMan_t * pNew );
 extern void            If_DsdManCleanOccur( If_DsdMan_t * p, int fVerbose );
 extern void            If_DsdManCleanMarks( If_DsdMan_t * p, int fVerbose );
@@ -639,6 +645,7 @@ extern void            If_ManSetupSetAll( If_Man_t * p, int nCrossCut );
 /*=== ifMap.c =============================================================*/
 extern int *           If_CutArrTimeProfile( If_Man_t * p, If_Cut_t * pCut );
 extern void            If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst );
+extern int             If_ManCanMapMt( If_Man_t * p );
 extern void            If_ObjPerformMappingChoice( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess );
 extern int             If_ManPerformMappingRound( If_Man_t * p, int nCutsUsed, int Mode, int fPreprocess, int fFirst, char * pLabel );
 /*=== ifReduce.c ==========================================================*/
@@ -682,6 +689,8 @@ extern float           If_ManScanMappingDirect( If_Man_t * p );
 extern float           If_ManScanMappingSeq( If_Man_t * p );
 extern void            If_ManResetOriginalRefs( If_Man_t * p );
 extern int             If_ManCrossCut( If_Man_t * p );
+extern Vec_Wec_t *     If_ManCollectLevels( If_Man_t * p );
+extern int             If_ManCrossCutLevels( If_Man_t * p );
 
 extern Vec_Ptr_t *     If_ManReverseOrder( If_Man_t * p );
 extern void            If_ManMarkMapping( If_Man_t * p );
@@ -19,12 +19,14 @@
 ***********************************************************************/
 
 #include <math.h>
+#include <ctype.h>
 #include "if.h"
 #include "ifCount.h"
 #include "misc/extra/extra.h"
 #include "sat/bsat/satSolver.h"
 #include "aig/gia/gia.h"
 #include "bool/kit/kit.h"
+#include "misc/util/utilCache.h"
 
 #ifdef ABC_USE_CUDD
 #include "bdd/extrab/extraBdd.h"
@@ -36,7 +38,6 @@
 #include "../lib/pthread.h"
 #else
 #include <pthread.h>
-#include <unistd.h>
 #endif
 
 #endif
@@ -50,6 +51,13 @@ ABC_NAMESPACE_IMPL_START
 
 #define DSD_VERSION "dsd1"
 
+// the DSD managers used by the mapper are cached in the directory given
+// by the environment variable below; the cache entries are ordinary DSD
+// manager files (see If_DsdManSave), which hold the functions together
+// with their marks (the results of the LUT structure checks) and the
+// configurations of the matched cell
+#define IF_DSD_CACHE_DIR_VAR   "ABC_DSD_CACHE"
+
 // network types
 typedef enum { 
     IF_DSD_NONE = 0,               // 0:  unknown
@@ -100,6 +108,8 @@ struct If_DsdMan_t_
     void *         pSat;           // SAT solver
     char *         pCellStr;       // symbolic cell description
     int            nObjsPrev;      // previous number of objects
+    char *         pCacheKey;      // the key of the cache entry (or NULL)
+    int            nObjsSaved;     // the number of objects in the cache entry
     int            fNewAsUseless;  // set new as useless
     int            nUniqueHits;    // statistics
     int            nUniqueMisses;  // statistics
@@ -366,6 +376,7 @@ void If_DsdManFree( If_DsdMan_t * p, int fVerbose )
     Vec_IntFreeP( &p->vCover );
     If_ManSatUnbuild( p->pSat );
     ABC_FREE( p->pCellStr );
+    ABC_FREE( p->pCacheKey );
     ABC_FREE( p->pStore );
     ABC_FREE( p->pBins );
     ABC_FREE( p );
@@ -1046,93 +1057,108 @@ int If_DsdObjFindOrAdd( If_DsdMan_t * p, int Type, int * pLits, int nLits, word
   SeeAlso     []
 
 ***********************************************************************/
-void If_DsdManSave( If_DsdMan_t * p, char * pFileName )
+static int If_DsdManSaveFile( If_DsdMan_t * p, FILE * pFile )
 {
     If_DsdObj_t * pObj; 
     Vec_Int_t * vSets;
     word * pTruth; 
-    int i, v, Num;
-    FILE * pFile = fopen( pFileName ? pFileName : p->pStore, "wb" );
-    if ( pFile == NULL )
-    {
-        printf( "Writing DSD manager file \"%s\" has failed.\n", pFileName ? pFileName : p->pStore );
-        return;
-    }
-    fwrite( DSD_VERSION, 4, 1, pFile );
+    int i, v, Num, RetValue = 1;
+    RetValue &= fwrite( DSD_VERSION, 4, 1, pFile ) == 1;
     Num = p->nVars;
-    fwrite( &Num, 4, 1, pFile );
+    RetValue &= fwrite( &Num, 4, 1, pFile ) == 1;
     Num = p->LutSize;
-    fwrite( &Num, 4, 1, pFile );
+    RetValue &= fwrite( &Num, 4, 1, pFile ) == 1;
     Num = Vec_PtrSize(&p->vObjs);
-    fwrite( &Num, 4, 1, pFile );
+    RetValue &= fwrite( &Num, 4, 1, pFile ) == 1;
     Vec_PtrForEachEntryStart( If_DsdObj_t *, &p->vObjs, pObj, i, 2 )
     {
         Num = If_DsdObjWordNum( pObj->nFans );
-        fwrite( &Num, 4, 1, pFile );
-        fwrite( pObj, sizeof(word)*Num, 1, pFile );
+        RetValue &= fwrite( &Num, 4, 1, pFile ) == 1;
+        RetValue &= fwrite( pObj, sizeof(word)*Num, 1, pFile ) == 1;
         if ( pObj->Type == IF_DSD_PRIME )
-            fwrite( Vec_IntEntryP(&p->vTruths, i), 4, 1, pFile );
+            RetValue &= fwrite( Vec_IntEntryP(&p->vTruths, i), 4, 1, pFile ) == 1;
     }
     for ( v = 3; v <= p->nVars; v++ )
     {
         int nBytes = sizeof(word)*Vec_MemEntrySize(p->vTtMem[v]);
         Num = Vec_MemEntryNum(p->vTtMem[v]);
-        fwrite( &Num, 4, 1, pFile );
+        RetValue &= fwrite( &Num, 4, 1, pFile ) == 1;
         Vec_MemForEachEntry( p->vTtMem[v], pTruth, i )
-            fwrite( pTruth, nBytes, 1, pFile );
+            RetValue &= fwrite( pTruth, nBytes, 1, pFile ) == 1;
         Num = Vec_PtrSize(p->vTtDecs[v]);
-        fwrite( &Num, 4, 1, pFile );
+        RetValue &= fwrite( &Num, 4, 1, pFile ) == 1;
         Vec_PtrForEachEntry( Vec_Int_t *, p->vTtDecs[v], vSets, i )
         {
             Num = Vec_IntSize(vSets);
-            fwrite( &Num, 4, 1, pFile );
-            fwrite( Vec_IntArray(vSets), sizeof(int)*Num, 1, pFile );
+            RetValue &= fwrite( &Num, 4, 1, pFile ) == 1;
+            if ( Num )
+                RetValue &= fwrite( Vec_IntArray(vSets), sizeof(int)*Num, 1, pFile ) == 1;
         }
     }
     Num = p->nConfigWords;
-    fwrite( &Num, 4, 1, pFile );
+    RetValue &= fwrite( &Num, 4, 1, pFile ) == 1;
     Num = p->nTtBits;
-    fwrite( &Num, 4, 1, pFile );
+    RetValue &= fwrite( &Num, 4, 1, pFile ) == 1;
     Num = p->vConfigs ? Vec_WrdSize(p->vConfigs) : 0;
-    fwrite( &Num, 4, 1, pFile );
+    RetValue &= fwrite( &Num, 4, 1, pFile ) == 1;
     if ( Num )
-        fwrite( Vec_WrdArray(p->vConfigs), sizeof(word)*Num, 1, pFile );
+        RetValue &= fwrite( Vec_WrdArray(p->vConfigs), sizeof(word)*Num, 1, pFile ) == 1;
     Num = p->pCellStr ? strlen(p->pCellStr) : 0;
-    fwrite( &Num, 4, 1, pFile );
+    RetValue &= fwrite( &Num, 4, 1, pFile ) == 1;
     if ( Num )
-        fwrite( p->pCellStr, sizeof(char)*Num, 1, pFile );
+        RetValue &= fwrite( p->pCellStr, sizeof(char)*Num, 1, pFile ) == 1;
+    return RetValue;
+}
+void If_DsdManSave( If_DsdMan_t * p, char * pFileName )
+{
+    FILE * pFile = fopen( pFileName ? pFileName : p->pStore, "wb" );
+    if ( pFile == NULL )
+    {
+        printf( "Writing DSD manager file \"%s\" has failed.\n", pFileName ? pFileName : p->pStore );
+        return;
+    }
+    If_DsdManSaveFile( p, pFile );
     fclose( pFile );
 }
-If_DsdMan_t * If_DsdManLoad( char * pFileName )
+static inline int If_DsdManReadData( char ** ppCur, char * pLimit, void * pData, size_t nBytes )
+{
+    if ( (size_t)(pLimit - *ppCur) < nBytes )
+        return 0;
+    memcpy( pData, *ppCur, nBytes );
+    *ppCur += nBytes;
+    return 1;
+}
+If_DsdMan_t * If_DsdManLoadFromMemory( char * pContents, size_t nSize, char * pFileName )
 {
     If_DsdMan_t * p;
     If_DsdObj_t * pObj; 
     Vec_Int_t * vSets;
-    char pBuffer[10];
     unsigned * pSpot;
     word * pTruth;
-    int i, v, Num, Num2, RetValue;
-    FILE * pFile = fopen( pFileName, "rb" );
-    if ( pFile == NULL )
+    char * pCur = pContents, * pLimit = pContents + nSize;
+    int i, v, Num = 0, Num2;
+    if ( nSize < 16 || strncmp(pContents, DSD_VERSION, strlen(DSD_VERSION)) )
     {
-        printf( "Reading DSD manager file \"%s\" has failed.\n", pFileName );
+        printf( "Unrecognized format of file \"%s\".\n", pFileName );
         return NULL;
     }
-    RetValue = fread( pBuffer, 4, 1, pFile );
-    if ( strncmp(pBuffer, DSD_VERSION, strlen(DSD_VERSION)) )
+    pCur += 4;
+    if ( !If_DsdManReadData( &pCur, pLimit, &Num, 4 ) || Num < 0 || Num > DAU_MAX_VAR )
     {
-        printf( "Unrecognized format of file \"%s\".\n", pFileName );
+        printf( "The number of variables (%d) in file \"%s\" is not supported.\n", Num, pFileName );
         return NULL;
     }
-    RetValue = fread( &Num, 4, 1, pFile );
     p = If_DsdManAlloc( Num, 0 );
     ABC_FREE( p->pStore );
     p->pStore = Abc_UtilStrsav( pFileName );
-    RetValue = fread( &Num, 4, 1, pFile );
+    if ( !If_DsdManReadData( &pCur, pLimit, &Num, 4 ) || Num < 0 || Num > p->nVars )
+        goto finish;
     p->LutSize = Num;
+    if ( p->LutSize )
     p->pSat  = If_ManSatBuildXY( p->LutSize );
-    RetValue = fread( &Num, 4, 1, pFile );
-    assert( Num >= 2 );
+    // each object takes at least 20 bytes
+    if ( !If_DsdManReadData( &pCur, pLimit, &Num, 4 ) || Num < 2 || (size_t)(Num - 2) > (size_t)(pLimit - pCur) / 20 )
+        goto finish;
     Vec_PtrFillExtra( &p->vObjs, Num, NULL );
     Vec_IntFill( &p->vNexts, Num, 0 );
     Vec_IntFill( &p->vTruths, Num, -1 );
@@ -1141,17 +1167,29 @@ If_DsdMan_t * If_DsdManLoad( char * pFileName )
     memset( p->pBins, 0, sizeof(unsigned) * p->nBins );
     for ( i = 2; i < Vec_PtrSize(&p->vObjs); i++ )
     {
-        RetValue = fread( &Num, 4, 1, pFile );
+        if ( !If_DsdManReadData( &pCur, pLimit, &Num, 4 ) || Num < 1 || Num > If_DsdObjWordNum(DAU_MAX_VAR) )
+            goto finish;
         pObj = (If_DsdObj_t *)Mem_FlexEntryFetch( p->pMem, sizeof(word) * Num );
-        RetValue = fread( pObj, sizeof(word)*Num, 1, pFile );
+        if ( !If_DsdManReadData( &pCur, pLimit, pObj, sizeof(word)*Num ) || (int)pObj->Id != i )
+            goto finish;
+        if ( pObj->Type < IF_DSD_AND || pObj->Type > IF_DSD_PRIME || pObj->nFans < 2 || (int)pObj->nFans > p->nVars || Num != If_DsdObjWordNum(pObj->nFans) )
+            goto finish;
+        if ( (pObj->Type == IF_DSD_MUX && pObj->nFans != 3) || (pObj->Type == IF_DSD_PRIME && pObj->nFans < 3) )
+            goto finish;
+        // the fanins precede the object
+        for ( v = 0; v < (int)pObj->nFans; v++ )
+            if ( Abc_Lit2Var(pObj->pFans[v]) >= i )
+                goto finish;
         Vec_PtrWriteEntry( &p->vObjs, i, pObj );
         if ( pObj->Type == IF_DSD_PRIME )
         {
-            RetValue = fread( &Num, 4, 1, pFile );
+            if ( !If_DsdManReadData( &pCur, pLimit, &Num, 4 ) || Num < 0 )
+                goto finish;
             Vec_IntWriteEntry( &p->vTruths, i, Num );
         }
         pSpot = If_DsdObjHashLookup( p, pObj->Type, (int *)pObj->pFans, pObj->nFans, If_DsdObjTruthId(p, pObj) );
-        assert( *pSpot == 0 );
+        if ( *pSpot != 0 )
+            goto finish;
         *pSpot = pObj->Id;
     }
     assert( p->nUniqueMisses == Vec_PtrSize(&p->vObjs) - 2 );
@@ -1160,42 +1198,89 @@ If_DsdMan_t * If_DsdManLoad( char * pFileName )
     for ( v = 3; v <= p->nVars; v++ )
     {
         int nBytes = sizeof(word)*Vec_MemEntrySize(p->vTtMem[v]);
-        RetValue = fread( &Num, 4, 1, pFile );
+        if ( !If_DsdManReadData( &pCur, pLimit, &Num, 4 ) || Num < 0 )
+            break;
         for ( i = 0; i < Num; i++ )
         {
-            RetValue = fread( pTruth, nBytes, 1, pFile );
+            if ( !If_DsdManReadData( &pCur, pLimit, pTruth, nBytes ) )
+                break;
             Vec_MemHashInsert( p->vTtMem[v], pTruth );
         }
-        assert( Num == Vec_MemEntryNum(p->vTtMem[v]) );
-        RetValue = fread( &Num2, 4, 1, pFile );
+        if ( Num != Vec_MemEntryNum(p->vTtMem[v]) )
+            break;
+        if ( !If_DsdManReadData( &pCur, pLimit, &Num2, 4 ) || Num2 < 0 )
+            break;
         for ( i = 0; i < Num2; i++ )
         {
-            RetValue = fread( &Num, 4, 1, pFile );
+            if ( !If_DsdManReadData( &pCur, pLimit, &Num, 4 ) || Num < 0 || (size_t)(pLimit - pCur) < sizeof(int)*(size_t)Num )
+                break;
             vSets = Vec_IntAlloc( Num );
-            RetValue = fread( Vec_IntArray(vSets), sizeof(int)*Num, 1, pFile );
+            if ( !If_DsdManReadData( &pCur, pLimit, Vec_IntArray(vSets), sizeof(int)*Num ) )
+            {
+                Vec_IntFree( vSets );
+                break;
+            }
             vSets->nSize = Num;
             Vec_PtrPush( p->vTtDecs[v], vSets );
         }
-        assert( Num2 == Vec_PtrSize(p->vTtDecs[v]) ); 
+        if ( Num2 != Vec_PtrSize(p->vTtDecs[v]) )
+            break;
     }
     ABC_FREE( pTruth );
-    RetValue = fread( &Num, 4, 1, pFile );
-    p->nConfigWords = Num;
-    RetValue = fread( &Num, 4, 1, pFile );
-    p->nTtBits = Num;
-    RetValue = fread( &Num, 4, 1, pFile );
-    if ( RetValue && Num )
+    if ( v <= p->nVars )
+        goto finish;
+    // the truth tables of the prime nodes are in the tables
+    If_DsdVecForEachNode( &p->vObjs, pObj, i )
+        if ( pObj->Type == IF_DSD_PRIME && If_DsdObjTruthId(p, pObj) >= Vec_MemEntryNum(p->vTtMem[pObj->nFans]) )
+            goto finish;
+    // the remaining data is optional
+    if ( If_DsdManReadData( &pCur, pLimit, &Num, 4 ) )
+        p->nConfigWords = Num;
+    if ( If_DsdManReadData( &pCur, pLimit, &Num, 4 ) )
+        p->nTtBits = Num;
+    if ( If_DsdManReadData( &pCur, pLimit, &Num, 4 ) && Num > 0 && (size_t)(pLimit - pCur) >= sizeof(word)*(size_t)Num )
     {
         p->vConfigs = Vec_WrdStart( Num );
-        RetValue = fread( Vec_WrdArray(p->vConfigs), sizeof(word)*Num, 1, pFile );
+        if ( !If_DsdManReadData( &pCur, pLimit, Vec_WrdArray(p->vConfigs), sizeof(word)*Num ) )
+            goto finish;
     }
-    RetValue = fread( &Num, 4, 1, pFile );
-    if ( RetValue && Num )
+    if ( If_DsdManReadData( &pCur, pLimit, &Num, 4 ) && Num > 0 && (size_t)(pLimit - pCur) >= (size_t)Num )
     {
         p->pCellStr = ABC_CALLOC( char, Num + 1 );
-        RetValue = fread( p->pCellStr, sizeof(char)*Num, 1, pFile );
+        if ( !If_DsdManReadData( &pCur, pLimit, p->pCellStr, sizeof(char)*Num ) )
+            goto finish;
     }
-    fclose( pFile );
+    return p;
+finish:
+    printf( "File \"%s\" with DSD manager is truncated or corrupted.\n", pFileName );
+    If_DsdManFree( p, 0 );
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the DSD manager from file.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+If_DsdMan_t * If_DsdManLoad( char * pFileName )
+{
+    If_DsdMan_t * p;
+    size_t nSize;
+    int fMapped;
+    char * pContents = Util_CacheLoadFile( pFileName, &nSize, &fMapped );
+    if ( pContents == NULL )
+    {
+        printf( "Reading DSD manager file \"%s\" has failed.\n", pFileName );
+        return NULL;
+    }
+    p = If_DsdManLoadFromMemory( pContents, nSize, pFileName );
+    Util_CacheUnloadFile( pContents, nSize, fMapped );
     return p;
 }
 void If_DsdManMerge( If_DsdMan_t * p, If_DsdMan_t * pNew )
@@ -1307,6 +1392,145 @@ If_DsdMan_t * If_DsdManFilter( If_DsdMan_t * p, int Limit )
     return pNew;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Returns the name of the cache file.]
+
+  Description [The DSD managers are cached in the directory given by
+  the environment variable ABC_DSD_CACHE. The cache is disabled if the
+  variable is not set. The name is composed of the number of variables
+  and the key (the LUT structure, for example), whose characters other
+  than letters and digits are replaced by their codes.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static char * If_DsdManCacheFileName( int nVars, char * pKey )
+{
+    char * pDir = getenv( IF_DSD_CACHE_DIR_VAR ), * pRes, * pTemp;
+    if ( pDir == NULL || *pDir == 0 )
+        return NULL;
+    pRes = ABC_ALLOC( char, strlen(pDir) + 3 * strlen(pKey) + 40 );
+    pTemp = pRes + sprintf( pRes, "%s/dsd%02d_%s_", pDir, nVars, DSD_VERSION );
+    for ( ; *pKey; pKey++ )
+        if ( isalnum((int)(unsigned char)*pKey) )
+            *pTemp++ = *pKey;
+        else
+            pTemp += sprintf( pTemp, "%02x", (unsigned)(unsigned char)*pKey );
+    strcpy( pTemp, ".dsd" );
+    return pRes;
+}
+static int If_DsdManCacheIsEnabled( void )
+{
+    char * pDir = getenv( IF_DSD_CACHE_DIR_VAR );
+    return pDir != NULL && *pDir != 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the DSD manager from the cache.]
+
+  Description [Returns NULL if there is no cache entry for this key or
+  if the entry is not compatible with the number of variables and the
+  LUT size. The manager remembers the key and is written back by
+  If_DsdManCacheUpdate() when it changes.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static If_DsdMan_t * If_DsdManCacheRead( int nVars, int LutSize, char * pKey, int fVerbose )
+{
+    If_DsdMan_t * p = NULL;
+    size_t nSize;
+    int fMapped;
+    char * pCacheName = If_DsdManCacheFileName( nVars, pKey );
+    char * pContents = pCacheName ? Util_CacheLoadFile( pCacheName, &nSize, &fMapped ) : NULL;
+    if ( pContents == NULL )
+    {
+        ABC_FREE( pCacheName );
+        return NULL;
+    }
+    p = If_DsdManLoadFromMemory( pContents, nSize, pCacheName );
+    Util_CacheUnloadFile( pContents, nSize, fMapped );
+    if ( p && (p->nVars != nVars || p->LutSize != LutSize) )
+    {
+        If_DsdManFree( p, 0 );
+        p = NULL;
+    }
+    if ( p )
+    {
+        p->pCacheKey  = Abc_UtilStrsav( pKey );
+        p->nObjsSaved = Vec_PtrSize(&p->vObjs);
+        if ( fVerbose )
+            printf( "Read %d DSD functions from cache file \"%s\".\n", Vec_PtrSize(&p->vObjs), pCacheName );
+    }
+    ABC_FREE( pCacheName );
+    return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the DSD manager into the cache.]
+
+  Description [The entry is written if the manager has new functions.
+  The data is written into a temporary file, which is then renamed,
+  so that the concurrent jobs never see a partial entry. Failures are
+  silently ignored.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void If_DsdManCacheUpdate( If_DsdMan_t * p )
+{
+    FILE * pFile;
+    char * pCacheName, * pTempName;
+    if ( p->pCacheKey == NULL || p->nObjsSaved == Vec_PtrSize(&p->vObjs) )
+        return;
+    pCacheName = If_DsdManCacheFileName( p->nVars, p->pCacheKey );
+    if ( pCacheName == NULL )
+        return;
+    pFile = Util_CacheWriteStart( pCacheName, &pTempName );
+    if ( pFile != NULL && Util_CacheWriteStop(pFile, pTempName, pCacheName, If_DsdManSaveFile(p, pFile)) )
+        p->nObjsSaved = Vec_PtrSize(&p->vObjs);
+    ABC_FREE( pCacheName );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starts the DSD manager for the given LUT structure.]
+
+  Description [If the cache is enabled, the manager is read from the
+  cache entry of this structure (or started and assigned to this entry,
+  if the entry does not exist yet).]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+If_DsdMan_t * If_DsdManCacheStart( int nVars, int LutSize, char * pLutStruct, int fVerbose )
+{
+    char * pKey = pLutStruct ? pLutStruct : "any";
+    If_DsdMan_t * p = NULL;
+    if ( If_DsdManCacheIsEnabled() )
+        p = If_DsdManCacheRead( nVars, LutSize, pKey, fVerbose );
+    if ( p != NULL )
+        return p;
+    p = If_DsdManAlloc( nVars, LutSize );
+    if ( If_DsdManCacheIsEnabled() )
+    {
+        p->pCacheKey  = Abc_UtilStrsav( pKey );
+        p->nObjsSaved = Vec_PtrSize(&p->vObjs);
+    }
+    return p;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Collect nodes of the tree.]
@@ -2484,6 +2708,9 @@ void Id_DsdManTuneStr1( If_DsdMan_t * p, char * pStruct, int nConfls, int fVerbo
         ABC_FREE( pNtk );
         return;
     }
+    // the functions matched earlier with the same cell are not matched again
+    if ( p->nObjsPrev == 0 && p->pCellStr && !strcmp(p->pCellStr, pStruct) && p->vConfigs && p->nConfigWords > 0 )
+        p->nObjsPrev = Abc_MinInt( Vec_WrdSize(p->vConfigs) / p->nConfigWords, Vec_PtrSize(&p->vObjs) );
     ABC_FREE( p->pCellStr );
     p->pCellStr = Abc_UtilStrsav( pStruct );
     if ( If_DsdManVarNum(p) < Ifn_NtkInputNum(pNtk) )
@@ -2628,6 +2855,9 @@ void Id_DsdManTuneStr( If_DsdMan_t * p, char * pStruct, int nConfls, int nProcs,
         ABC_FREE( pNtk );
         return;
     }
+    // the functions matched earlier with the same cell are not matched again
+    if ( p->nObjsPrev == 0 && p->pCellStr && !strcmp(p->pCellStr, pStruct) && p->vConfigs && p->nConfigWords > 0 )
+        p->nObjsPrev = Abc_MinInt( Vec_WrdSize(p->vConfigs) / p->nConfigWords, Vec_PtrSize(&p->vObjs) );
     ABC_FREE( p->pCellStr );
     p->pCellStr = Abc_UtilStrsav( pStruct );
     if ( If_DsdManVarNum(p) < Ifn_NtkInputNum(pNtk) )
@@ -99,7 +99,7 @@ void If_LibBoxFree( If_LibBox_t * p )
 {
     If_Box_t * pBox;
     int i;
-    if ( p == NULL )
+    if ( p == NULL || Abc_FrameIsLibShared(p) )
         return;
     If_LibBoxForEachBox( p, pBox, i )
         If_BoxFree( pBox );
@@ -331,7 +331,7 @@ If_LibLut_t * If_LibLutDup( If_LibLut_t * p )
 ***********************************************************************/
 void If_LibLutFree( If_LibLut_t * pLutLib )
 {
-    if ( pLutLib == NULL )
+    if ( pLutLib == NULL || Abc_FrameIsLibShared(pLutLib) )
         return;
     ABC_FREE( pLutLib->pName );
     ABC_FREE( pLutLib );
@@ -21,6 +21,16 @@
 #include "if.h"
 #include "misc/extra/extra.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 ////////////////////////////////////////////////////////////////////////
@@ -31,6 +41,8 @@ extern char * Dau_DsdMerge( char * pDsd0i, int * pPerm0, char * pDsd1i, int * pP
 extern int    If_CutDelayRecCost3( If_Man_t* p, If_Cut_t* pCut, If_Obj_t * pObj );
 extern int    Abc_ExactDelayCost( word * pTruth, int nVars, int * pArrTimeProfile, char * pPerm, int * Cost, int AigLevel );
 
+#define IF_PROC_MAX 64
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -152,14 +164,16 @@ int * If_CutArrTimeProfile( If_Man_t * p, If_Cut_t * pCut )
 
   Synopsis    [Finds the best cut for the given node.]
 
-  Description [Mapping modes: delay (0), area flow (1), area (2).]
+  Description [Mapping modes: delay (0), area flow (1), area (2).
+  The cutset of the node should be set up by the caller, which also
+  dereferences the cutsets of the fanins after the node is mapped.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst )
+static void If_ObjPerformMappingAndInt( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst )
 {
     If_Set_t * pCutSet;
     If_Cut_t * pCut0, * pCut1, * pCut;
@@ -181,8 +195,8 @@ void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPrep
     if ( Mode && pObj->nRefs > 0 )
         If_CutAreaDeref( p, If_ObjCutBest(pObj) );
 
-    // prepare the cutset
-    pCutSet = If_ManSetupNodeCutSet( p, pObj );
+    // get the cutset
+    pCutSet = pObj->pCutSet;
 
     // get the current assigned best cut
     pCut = If_ObjCutBest(pObj);
@@ -487,6 +501,13 @@ void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPrep
     if ( p->pPars->pFuncUser )
         If_ObjForEachCut( pObj, pCut, i )
             p->pPars->pFuncUser( p, pObj, pCut );
+}
+void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst )
+{
+    // prepare the cutset
+    If_ManSetupNodeCutSet( p, pObj );
+    // find the best cut
+    If_ObjPerformMappingAndInt( p, pObj, Mode, fPreprocess, fFirst );
     // free the cuts
     If_ManDerefNodeCutSet( p, pObj );
 }
@@ -576,6 +597,163 @@ void If_ObjPerformMappingChoice( If_Man_t * p, If_Obj_t * pObj, int Mode, int fP
     If_ManDerefChoiceCutSet( p, pObj );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if the delay-oriented rounds can use threads.]
+
+  Description [The nodes on one logic level are mapped concurrently.
+  This is only done when the cuts of a node depend on nothing but the
+  cuts of its fanins: there are no choices, no timing manager, no truth
+  tables (their IDs depend on the order of computation) and no user
+  callbacks or special delay models with shared storage.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int If_ManCanMapMt( If_Man_t * p )
+{
+    If_Par_t * pPars = p->pPars;
+    if ( pPars->nProcs < 2 || p->pManTim || p->nChoices > 0 )
+        return 0;
+    if ( pPars->fTruth || pPars->fUseTtPerm || pPars->fDelayOpt || pPars->fDelayOptLut || pPars->fDsdBalance || 
+         pPars->fUserRecLib || pPars->fUserSesLib || pPars->nGateSize > 0 )
+        return 0;
+    if ( pPars->pFuncCost || pPars->pFuncUser || pPars->pFuncCell || pPars->pFuncCell2 )
+        return 0;
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Maps the nodes level by level using several threads.]
+
+  Description [Each thread works with a copy of the manager, which keeps
+  the statistics of the thread. The cutsets of the nodes on a level are
+  set up, and the cutsets of their fanins are dereferenced, by the main
+  thread in the order of the nodes, so the result does not depend on the
+  number of threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifndef ABC_USE_PTHREADS
+
+void If_ManPerformMappingMt( If_Man_t * p, int Mode, int fPreprocess, int fFirst )
+{
+    If_Obj_t * pObj;
+    int i;
+    If_ManForEachNode( p, pObj, i )
+        If_ObjPerformMappingAnd( p, pObj, Mode, fPreprocess, fFirst );
+}
+
+#else // pthreads are used
+
+typedef struct If_ThData_t_
+{
+    If_Man_t     Man;            // the copy of the mapping manager
+    Vec_Int_t *  vNodes;         // nodes on the current level
+    int          Mode;           // the mapping mode
+    int          fPreprocess;    // the preprocessing round
+    int          fFirst;         // the first round
+    volatile int iStart;         // the first node to process
+    volatile int iStop;          // the last node to process (exclusive)
+    volatile int fWorking;       // the thread is busy
+} If_ThData_t;
+
+void * If_WorkerThread( void * pArg )
+{
+    If_ThData_t * pThData = (If_ThData_t *)pArg;
+    volatile int * pPlace = &pThData->fWorking;
+    If_Man_t * p = &pThData->Man;
+    int i;
+    while ( 1 )
+    {
+        while ( *pPlace == 0 );
+        assert( pThData->fWorking );
+        if ( pThData->iStart == -1 )
+        {
+            pthread_exit( NULL );
+            assert( 0 );
+            return NULL;
+        }
+        for ( i = pThData->iStart; i < pThData->iStop; i++ )
+            If_ObjPerformMappingAndInt( p, If_ManObj(p, Vec_IntEntry(pThData->vNodes, i)), pThData->Mode, pThData->fPreprocess, pThData->fFirst );
+        pThData->fWorking = 0;
+    }
+    assert( 0 );
+    return NULL;
+}
+void If_ManPerformMappingMt( If_Man_t * p, int Mode, int fPreprocess, int fFirst )
+{
+    If_ThData_t ThData[IF_PROC_MAX];
+    pthread_t WorkerThread[IF_PROC_MAX];
+    Vec_Wec_t * vLevels = If_ManCollectLevels( p );
+    Vec_Int_t * vNodes;
+    If_Obj_t * pObj;
+    int nProcs = Abc_MinInt( p->pPars->nProcs, IF_PROC_MAX );
+    int i, k, status;
+    // start the threads
+    memset( ThData, 0, sizeof(If_ThData_t) * nProcs );
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].Man             = *p;
+        ThData[i].Man.nCutsMerged = 0;
+        ThData[i].Man.nCutsTotal  = 0;
+        ThData[i].Mode            = Mode;
+        ThData[i].fPreprocess     = fPreprocess;
+        ThData[i].fFirst          = fFirst;
+        ThData[i].iStart          = -1;
+        ThData[i].fWorking        = 0;
+        status = pthread_create( WorkerThread + i, NULL, If_WorkerThread, (void *)(ThData + i) );  assert( status == 0 );
+    }
+    Vec_WecForEachLevel( vLevels, vNodes, k )
+    {
+        // small levels are not worth the synchronization
+        if ( Vec_IntSize(vNodes) < 16 * nProcs )
+        {
+            If_ManForEachObjVec( vNodes, p, pObj, i )
+                If_ObjPerformMappingAnd( p, pObj, Mode, fPreprocess, fFirst );
+            continue;
+        }
+        If_ManForEachObjVec( vNodes, p, pObj, i )
+            If_ManSetupNodeCutSet( p, pObj );
+        for ( i = 0; i < nProcs; i++ )
+        {
+            ThData[i].vNodes   = vNodes;
+            ThData[i].iStart   = (int)((word)Vec_IntSize(vNodes) * i / nProcs);
+            ThData[i].iStop    = (int)((word)Vec_IntSize(vNodes) * (i+1) / nProcs);
+            ThData[i].fWorking = 1;
+        }
+        // wait till threads finish
+        for ( i = 0; i < nProcs; i++ )
+            if ( ThData[i].fWorking )
+                i = -1;
+        // free the cuts in the order of nodes
+        If_ManForEachObjVec( vNodes, p, pObj, i )
+            If_ManDerefNodeCutSet( p, pObj );
+    }
+    // stop the threads
+    for ( i = 0; i < nProcs; i++ )
+    {
+        assert( !ThData[i].fWorking );
+        ThData[i].iStart   = -1;
+        ThData[i].fWorking = 1;
+    }
+    for ( i = 0; i < nProcs; i++ )
+    {
+        status = pthread_join( WorkerThread[i], NULL );  assert( status == 0 );
+        p->nCutsMerged += ThData[i].Man.nCutsMerged;
+        p->nCutsTotal  += ThData[i].Man.nCutsTotal;
+    }
+    Vec_WecFree( vLevels );
+}
+
+#endif // pthreads are used
+
 /**Function*************************************************************
 
   Synopsis    [Performs one mapping pass over all nodes.]
@@ -642,6 +820,8 @@ int If_ManPerformMappingRound( If_Man_t * p, int nCutsUsed, int Mode, int fPrepr
         }
 //        Tim_ManPrint( p->pManTim );
     }
+    else if ( Mode == 0 && If_ManCanMapMt(p) )
+        If_ManPerformMappingMt( p, Mode, fPreprocess, fFirst );
     else
     {
         pProgress = Extra_ProgressBarStart( stdout, If_ManObjNum(p) );
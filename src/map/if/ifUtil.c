@@ -349,6 +349,71 @@ int If_ManCrossCut( If_Man_t * p )
     return nCutSizeMax;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Collects the internal nodes by logic level.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Wec_t * If_ManCollectLevels( If_Man_t * p )
+{
+    Vec_Wec_t * vLevels = Vec_WecStart( p->nLevelMax + 1 );
+    If_Obj_t * pObj;
+    int i;
+    If_ManForEachNode( p, pObj, i )
+        Vec_WecPush( vLevels, If_ObjLevel(pObj), pObj->Id );
+    return vLevels;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes cross-cut of the circuit mapped level by level.]
+
+  Description [Assumes that the cutsets of all nodes on a level are
+  set up before the cutsets of their fanins are dereferenced.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int If_ManCrossCutLevels( If_Man_t * p )
+{
+    Vec_Wec_t * vLevels = If_ManCollectLevels( p );
+    Vec_Int_t * vLevel;
+    If_Obj_t * pObj, * pFanin;
+    int i, k, nCutSize = 0, nCutSizeMax = 0;
+    Vec_WecForEachLevel( vLevels, vLevel, i )
+    {
+        // consider the nodes
+        nCutSize += Vec_IntSize(vLevel);
+        if ( nCutSizeMax < nCutSize )
+            nCutSizeMax = nCutSize;
+        If_ManForEachObjVec( vLevel, p, pObj, k )
+        {
+            if ( pObj->nVisits == 0 )
+                nCutSize--;
+            // consider the fanins
+            pFanin = If_ObjFanin0(pObj);
+            if ( !If_ObjIsCi(pFanin) && --pFanin->nVisits == 0 )
+                nCutSize--;
+            pFanin = If_ObjFanin1(pObj);
+            if ( !If_ObjIsCi(pFanin) && --pFanin->nVisits == 0 )
+                nCutSize--;
+        }
+    }
+    If_ManForEachObj( p, pObj, i )
+        pObj->nVisits = pObj->nVisitsCopy;
+    assert( nCutSize == 0 );
+    Vec_WecFree( vLevels );
+    return nCutSizeMax;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Computes the reverse topological order of nodes.]
@@ -169,7 +169,7 @@ clk = Abc_Clock();
 ***********************************************************************/
 void Map_SuperLibFree( Map_SuperLib_t * p )
 {
-    if ( p == NULL ) return;
+    if ( p == NULL || Abc_FrameIsLibShared(p) ) return;
     if ( p->pGenlib )
     {
         if ( p->pGenlib != Abc_FrameReadLibGen() )
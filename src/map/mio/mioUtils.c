@@ -51,7 +51,7 @@ ABC_NAMESPACE_IMPL_START
 void Mio_LibraryDelete( Mio_Library_t * pLib )
 {
     Mio_Gate_t * pGate, * pGate2;
-    if ( pLib == NULL )
+    if ( pLib == NULL || Abc_FrameIsLibShared(pLib) )
         return;
     Mio_LibraryMatchesStop( pLib );
     Mio_LibraryMatches2Stop( pLib );
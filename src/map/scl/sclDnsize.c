@@ -90,23 +90,21 @@ void Abc_SclFindWindow( Abc_Obj_t * pPivot, Vec_Int_t ** pvNodes, Vec_Int_t ** p
 
 /**Function*************************************************************
 
-  Synopsis    [Returns 1 if the node can be improved.]
+  Synopsis    [Finds the best smaller gate for the node.]
 
-  Description [Updated the node to have a new gate.]
+  Description [Returns the best gate or -1 if the node cannot be improved.
+  The gate, the timing and the loads are not changed.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-int Abc_SclCheckImprovement( SC_Man * p, Abc_Obj_t * pObj, Vec_Int_t * vNodes, Vec_Int_t * vEvals, int Notches, int DelayGap )
+int Abc_SclFindBestDnsize( SC_Man * p, Abc_Obj_t * pObj, Vec_Int_t * vNodes, Vec_Int_t * vEvals, int Notches, int DelayGap, float * pGainBest )
 {
-    Abc_Obj_t * pTemp;
     SC_Cell * pCellOld, * pCellNew;
     float dGain, dGainBest;
-    int i, k, gateBest;
-    abctime clk;
-clk = Abc_Clock();
+    int i, gateBest;
 //    printf( "%d -> %d\n", Vec_IntSize(vNodes), Vec_IntSize(vEvals) );
     // save old gate, timing, fanin load
     pCellOld = Abc_SclObjCell( pObj );
@@ -144,25 +142,98 @@ clk = Abc_Clock();
     // put back old cell and timing
     Abc_SclObjSetCell( pObj, pCellOld );
     Abc_SclConeRestore( p, vNodes );
+    *pGainBest = dGainBest;
+    return gateBest;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Updates the node to have a new gate.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_SclApplyDnsize( SC_Man * p, Abc_Obj_t * pObj, Vec_Int_t * vNodes, int gateBest )
+{
+    Abc_Obj_t * pTemp;
+    SC_Cell * pCellOld = Abc_SclObjCell( pObj );
+    SC_Cell * pCellNew = SC_LibCell( p->pLib, gateBest );
+    int k;
+    Abc_SclObjSetCell( pObj, pCellNew );
+    p->SumArea += pCellNew->area - pCellOld->area;
+//    printf( "%f   %f -> %f\n", pCellNew->area - pCellOld->area, p->SumArea - (pCellNew->area - pCellOld->area), p->SumArea );
+//    printf( "%6d  %20s -> %20s  %f -> %f\n", Abc_ObjId(pObj), pCellOld->pName, pCellNew->pName, pCellOld->area, pCellNew->area );
+    // mark used nodes with the current trav ID
+    Abc_NtkForEachObjVec( vNodes, p->pNtk, pTemp, k )
+        Abc_NodeSetTravIdCurrent( pTemp );
+    // update load and timing...
+    Abc_SclUpdateLoad( p, pObj, pCellOld, pCellNew );
+    Abc_SclTimeIncInsert( p, pObj );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if the node can be improved.]
+
+  Description [Updated the node to have a new gate.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_SclCheckImprovement( SC_Man * p, Abc_Obj_t * pObj, Vec_Int_t * vNodes, Vec_Int_t * vEvals, int Notches, int DelayGap )
+{
+    float dGainBest;
+    int gateBest;
+    abctime clk;
+clk = Abc_Clock();
+    gateBest = Abc_SclFindBestDnsize( p, pObj, vNodes, vEvals, Notches, DelayGap, &dGainBest );
 p->timeSize += Abc_Clock() - clk;
     if ( gateBest >= 0 )
     {
-        pCellNew = SC_LibCell( p->pLib, gateBest );
-        Abc_SclObjSetCell( pObj, pCellNew );
-        p->SumArea += pCellNew->area - pCellOld->area;
-//        printf( "%f   %f -> %f\n", pCellNew->area - pCellOld->area, p->SumArea - (pCellNew->area - pCellOld->area), p->SumArea );
-//        printf( "%6d  %20s -> %20s  %f -> %f\n", Abc_ObjId(pObj), pCellOld->pName, pCellNew->pName, pCellOld->area, pCellNew->area );
-        // mark used nodes with the current trav ID
-        Abc_NtkForEachObjVec( vNodes, p->pNtk, pTemp, k )
-            Abc_NodeSetTravIdCurrent( pTemp );
-        // update load and timing...
-        Abc_SclUpdateLoad( p, pObj, pCellOld, pCellNew );
-        Abc_SclTimeIncInsert( p, pObj );
+        Abc_SclApplyDnsize( p, pObj, vNodes, gateBest );
         return 1;
     }
     return 0;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Evaluates the batch of windows and applies the improvements.]
+
+  Description [Returns the number of improved nodes.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_SclCheckImprovementMt( SC_Man * p, int Notches, int DelayGap )
+{
+    Abc_Obj_t * pObj;
+    int i, gateBest, nChanges = 0;
+    abctime clk;
+clk = Abc_Clock();
+    Abc_SclSizeMtEvaluate( p->pMt, 1, Notches, DelayGap );
+p->timeSize += Abc_Clock() - clk;
+    for ( i = 0; i < Abc_SclSizeMtWinNum(p->pMt); i++ )
+    {
+        gateBest = Abc_SclSizeMtGate( p->pMt, i );
+        if ( gateBest < 0 )
+            continue;
+        pObj = Abc_NtkObj( p->pNtk, Abc_SclSizeMtObj(p->pMt, i) );
+        Abc_SclApplyDnsize( p, pObj, Abc_SclSizeMtNodes(p->pMt, i), gateBest );
+        nChanges++;
+    }
+    Abc_SclSizeMtClear( p->pMt );
+    return nChanges;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Collect nodes by area.]
@@ -260,10 +331,12 @@ void Abc_SclDnsizePerformInt( SC_Lib * pLib, Abc_Ntk_t * pNtk, SC_SizePars * pPa
     }
 
     // prepare the manager; collect init stats
-    p = Abc_SclManStart( pLib, pNtk, pPars->fUseWireLoads, pPars->fUseDept, pPars->DelayUser, pPars->BuffTreeEst );
+    p = Abc_SclManStart( pLib, pNtk, pPars->fUseWireLoads, pPars->fUseDept, pPars->DelayUser, pPars->BuffTreeEst, pPars->nProcs );
     p->timeTotal  = Abc_Clock();
     assert( p->vGatesBest == NULL );
     p->vGatesBest = Vec_IntDup( p->pNtk->vGates );
+    if ( p->pPool )
+        p->pMt = Abc_SclSizeMtStart( p );
 
     // perform upsizing
     vNodes = Vec_IntAlloc( 1000 );
@@ -285,12 +358,28 @@ void Abc_SclDnsizePerformInt( SC_Lib * pLib, Abc_Ntk_t * pNtk, SC_SizePars * pPa
                 pObj = Abc_NtkObj( p->pNtk, Vec_QuePop(p->vNodeByGain) );
                 Abc_SclFindWindow( pObj, &vNodes, &vEvals );
                 p->timeCone += Abc_Clock() - clk;
-                if ( Abc_SclCheckOverlap( p->pNtk, vNodes ) )
+                if ( p->pMt )
+                {
+                    // evaluate the batch when the window interferes with it;
+                    // the windows of the batch do not overlap, so the nodes
+                    // are improved in the same way as in the serial loop
+                    if ( !Abc_SclCheckOverlap( p->pNtk, vNodes ) && !Abc_SclSizeMtAddWindow( p->pMt, pObj, vNodes, vEvals ) )
+                    {
+                        nChanges += Abc_SclCheckImprovementMt( p, pPars->Notches, pPars->DelayGap );
+                        if ( !Abc_SclCheckOverlap( p->pNtk, vNodes ) )
+                            Abc_SclSizeMtAddWindow( p->pMt, pObj, vNodes, vEvals );
+                    }
+                    if ( Abc_SclCheckOverlap( p->pNtk, vNodes ) )
+                        nOverlap++, Vec_IntPush( vTryLater, Abc_ObjId(pObj) );
+                }
+                else if ( Abc_SclCheckOverlap( p->pNtk, vNodes ) )
                     nOverlap++, Vec_IntPush( vTryLater, Abc_ObjId(pObj) );
                 else 
                     nChanges += Abc_SclCheckImprovement( p, pObj, vNodes, vEvals, pPars->Notches, pPars->DelayGap );
                 nAttempt++;
             }
+            if ( p->pMt )
+                nChanges += Abc_SclCheckImprovementMt( p, pPars->Notches, pPars->DelayGap );
             Abc_NtkForEachObjVec( vTryLater, pNtk, pObj, k )
                 Vec_QuePush( p->vNodeByGain, Abc_ObjId(pObj) );
 
@@ -342,6 +431,8 @@ void Abc_SclDnsizePerformInt( SC_Lib * pLib, Abc_Ntk_t * pNtk, SC_SizePars * pPa
 
     // save the result and quit
     Abc_SclSclGates2MioGates( pLib, pNtk ); // updates gate pointers
+    if ( p->pMt )
+        Abc_SclSizeMtStop( p->pMt );
     Abc_SclManFree( p );
 //    Abc_NtkCleanMarkAB( pNtk );
 }
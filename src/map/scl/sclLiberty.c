@@ -25,9 +25,11 @@
 #include <fnmatch.h>
 #endif
 
-#include "sclLib.h"
+#include "sclSize.h"
 #include "misc/st/st.h"
 #include "map/mio/mio.h"
+#include "misc/extra/extra.h"
+#include "misc/util/utilCache.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -38,6 +40,16 @@ ABC_NAMESPACE_IMPL_START
 
 // #define ABC_MAX_LIB_STR_LEN 5000
 
+// the parsed libraries are cached in the directory given by the environment
+// variable below (or in the temporary directory, if it is not set); setting
+// the variable also enables the cache in read_lib by default; the name
+// of the cache file contains the hash of the Liberty file contents and the
+// reading options, so a modified library or a different set of dont_use
+// cells never matches a stale entry
+#define SCL_CACHE_DIR_VAR   "ABC_LIB_CACHE"
+#define SCL_CACHE_MAGIC     "ABC_SCLC"
+#define SCL_CACHE_HEADER    24             // magic (8) + hash (8) + size (8)
+
 // entry types
 typedef enum { 
     SCL_LIBERTY_NONE = 0,        // 0:  unknown
@@ -78,6 +90,22 @@ struct Scl_Tree_t_
     char *          pError;       // the error string
     abctime         clkStart;     // beginning time
     Vec_Str_t *     vBuffer;      // temp string buffer
+    Vec_Int_t *     vCells;       // cells whose bodies are parsed later
+    Vec_Int_t *     vCellLines;   // the first line of each of these cells
+};
+
+// the parallel parser reads the top level of the library while skipping
+// the bodies of the cells; the cells are then split into blocks of about
+// the same size in bytes and each block is parsed into a separate array
+// of items; finally, the arrays are appended to the array of the tree,
+// in the order of the blocks, and the item indexes are shifted
+typedef struct Scl_ParseMt_t_ Scl_ParseMt_t;
+struct Scl_ParseMt_t_
+{
+    Scl_Tree_t *    p;            // the parse tree
+    Vec_Int_t *     vBlocks;      // the first cell of each block
+    Vec_Int_t *     vChilds;      // the first child of each cell (in its block)
+    Scl_Tree_t *    pSubs;        // the parse trees of the blocks
 };
 
 
@@ -188,6 +216,13 @@ long Scl_LibertyCountItems( char * pBeg, char * pEnd )
         Counter += (*pBeg == '(' || *pBeg == ':');
     return Counter;
 }
+long Scl_LibertyCountLines( char * pBeg, char * pEnd )
+{
+    long Counter = 0;
+    for ( ; pBeg < pEnd; pBeg++ )
+        Counter += (*pBeg == '\n');
+    return Counter;
+}
 // removes C-style comments
 /*
 void Scl_LibertyWipeOutComments( char * pBeg, char * pEnd )
@@ -371,6 +406,37 @@ char * Scl_LibertyReadString( Scl_Tree_t * p, Scl_Pair_t Pair )
     Buffer[Pair.End-Pair.Beg] = 0;
     return Buffer;
 }
+
+/**Function*************************************************************
+
+  Synopsis    [Splits the string into tokens.]
+
+  Description [Works as strtok() but keeps the position in *ppNext
+  rather than in a global variable, so that several libraries can be
+  read at the same time.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+char * Scl_LibertyToken( char * pStr, char * pDelims, char ** ppNext )
+{
+    char * pEnd;
+    if ( pStr == NULL )
+        pStr = *ppNext;
+    pStr += strspn( pStr, pDelims );
+    if ( *pStr == 0 )
+    {
+        *ppNext = pStr;
+        return NULL;
+    }
+    pEnd = pStr + strcspn( pStr, pDelims );
+    if ( *pEnd )
+        *pEnd++ = 0;
+    *ppNext = pEnd;
+    return pStr;
+}
 long Scl_LibertyItemNum( Scl_Tree_t * p, Scl_Item_t * pRoot, char * pName )
 {
     Scl_Item_t * pItem;
@@ -468,9 +534,19 @@ long Scl_LibertyBuildItem( Scl_Tree_t * p, char ** ppPos, char * pEnd )
             pItem->Head = Scl_LibertyUpdateHead( p, Head );
             pItem->Body = Body;
             *ppPos = pNext + 1;
-            pItem->Child = Scl_LibertyBuildItem( p, ppPos, pStop );
-            if ( pItem->Child == -1 )
-                goto exit;
+            if ( p->vCells && !Scl_LibertyCompare(p, Key, "cell") )
+            {
+                // the body is parsed later by Scl_LibertyParseCells()
+                Vec_IntPush( p->vCells, Scl_LibertyItemId(p, pItem) );
+                Vec_IntPush( p->vCellLines, p->nLines );
+                p->nLines += Scl_LibertyCountLines( pNext, pStop );
+            }
+            else
+            {
+                pItem->Child = Scl_LibertyBuildItem( p, ppPos, pStop );
+                if ( pItem->Child == -1 )
+                    goto exit;
+            }
             *ppPos = pStop + 1;
             pItem->Next = Scl_LibertyBuildItem( p, ppPos, pEnd );
             if ( pItem->Next == -1 )
@@ -602,21 +678,176 @@ void Scl_LibertyStop( Scl_Tree_t * p, int fVerbose )
         ABC_PRT( "Time", Abc_Clock() - p->clkStart );
     }
     Vec_StrFree( p->vBuffer );
+    Vec_IntFreeP( &p->vCells );
+    Vec_IntFreeP( &p->vCellLines );
     ABC_FREE( p->pFileName );
     ABC_FREE( p->pContents );
     ABC_FREE( p->pItems );
     ABC_FREE( p->pError );
     ABC_FREE( p );
 }
-Scl_Tree_t * Scl_LibertyParse( char * pFileName, int fVerbose )
+/**Function*************************************************************
+
+  Synopsis    [Parses the bodies of the cells in the given range of blocks.]
+
+  Description [Each block is parsed into its own tree, which shares the
+  file contents with the main tree. The line counter of a block starts
+  from the line recorded for each cell, so the items get the same line
+  numbers as in the serial parser.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Scl_LibertyParseBlocks( void * pArg, int iThread, int iStart, int iStop )
+{
+    Scl_ParseMt_t * pMt = (Scl_ParseMt_t *)pArg;
+    Scl_Tree_t * p = pMt->p, * pSub;
+    Scl_Item_t * pCell;
+    char * pPos;
+    int b, c, iBeg, iEnd;
+    for ( b = iStart; b < iStop; b++ )
+    {
+        iBeg = Vec_IntEntry( pMt->vBlocks, b );
+        iEnd = Vec_IntEntry( pMt->vBlocks, b+1 );
+        pSub = pMt->pSubs + b;
+        pSub->pFileName = p->pFileName;
+        pSub->pContents = p->pContents;
+        pSub->nContents = p->nContents;
+        pSub->vBuffer   = Vec_StrStart( 10 );
+        pSub->nItermAlloc = 10;
+        for ( c = iBeg; c < iEnd; c++ )
+        {
+            pCell = Scl_LibertyItem( p, Vec_IntEntry(p->vCells, c) );
+            pSub->nItermAlloc += Scl_LibertyCountItems( p->pContents + pCell->Body.Beg, p->pContents + pCell->Body.End );
+        }
+        pSub->pItems = ABC_CALLOC( Scl_Item_t, pSub->nItermAlloc );
+        for ( c = iBeg; c < iEnd; c++ )
+        {
+            pCell = Scl_LibertyItem( p, Vec_IntEntry(p->vCells, c) );
+            pSub->nLines = Vec_IntEntry( p->vCellLines, c );
+            pPos = p->pContents + pCell->Body.Beg;
+            Vec_IntWriteEntry( pMt->vChilds, c, Scl_LibertyBuildItem(pSub, &pPos, p->pContents + pCell->Body.End) );
+            if ( Vec_IntEntry(pMt->vChilds, c) == -1 )
+                break;
+        }
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Parses the bodies of the cells skipped by the top-level parser.]
+
+  Description [Returns 0 if parsing of a cell has failed.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Scl_LibertyParseCells( Scl_Tree_t * p, int nProcs )
+{
+    Scl_ParseMt_t Mt, * pMt = &Mt;
+    Scl_Pool_t * pPool = Abc_SclPoolStart( nProcs );
+    Scl_Tree_t * pSub;
+    Scl_Item_t * pCell;
+    long nBytes = 0, nTotal = 0, Offset;
+    int b, c, i, nBlocks, RetValue = 1;
+    // divide the cells into blocks of similar size
+    Vec_IntForEachEntry( p->vCells, i, c )
+        nTotal += Scl_LibertyItem(p, i)->Body.End - Scl_LibertyItem(p, i)->Body.Beg;
+    nBlocks = Abc_MinInt( Abc_SclPoolProcNum(pPool), Vec_IntSize(p->vCells) );
+    pMt->p       = p;
+    pMt->vBlocks = Vec_IntAlloc( nBlocks + 1 );
+    pMt->vChilds = Vec_IntStartFull( Vec_IntSize(p->vCells) );
+    pMt->pSubs   = ABC_CALLOC( Scl_Tree_t, nBlocks );
+    Vec_IntPush( pMt->vBlocks, 0 );
+    Vec_IntForEachEntry( p->vCells, i, c )
+    {
+        if ( nBytes >= (long)((word)nTotal * Vec_IntSize(pMt->vBlocks) / nBlocks) && Vec_IntSize(pMt->vBlocks) < nBlocks )
+            Vec_IntPush( pMt->vBlocks, c );
+        nBytes += Scl_LibertyItem(p, i)->Body.End - Scl_LibertyItem(p, i)->Body.Beg;
+    }
+    nBlocks = Vec_IntSize( pMt->vBlocks );
+    Vec_IntPush( pMt->vBlocks, Vec_IntSize(p->vCells) );
+    // parse the blocks
+    Abc_SclPoolRun( pPool, Scl_LibertyParseBlocks, pMt, nBlocks, 1 );
+    Abc_SclPoolStop( pPool );
+    // append the items of the blocks to the tree
+    for ( b = 0; b < nBlocks; b++ )
+    {
+        pSub = pMt->pSubs + b;
+        if ( RetValue && pSub->pError )
+        {
+            // report the first failure in the file
+            ABC_FREE( p->pError );
+            p->pError = pSub->pError;
+            pSub->pError = NULL;
+            RetValue = 0;
+        }
+        if ( RetValue )
+        {
+            assert( p->nItems + pSub->nItems <= p->nItermAlloc );
+            Offset = p->nItems;
+            for ( i = 0; i < pSub->nItems; i++ )
+            {
+                Scl_Item_t * pItem = p->pItems + p->nItems++;
+                *pItem = pSub->pItems[i];
+                if ( pItem->Next >= 0 )
+                    pItem->Next += Offset;
+                if ( pItem->Child >= 0 )
+                    pItem->Child += Offset;
+            }
+            for ( c = Vec_IntEntry(pMt->vBlocks, b); c < Vec_IntEntry(pMt->vBlocks, b+1); c++ )
+            {
+                pCell = Scl_LibertyItem( p, Vec_IntEntry(p->vCells, c) );
+                pCell->Child = Vec_IntEntry( pMt->vChilds, c );
+                if ( pCell->Child >= 0 )
+                    pCell->Child += Offset;
+            }
+        }
+        Vec_StrFree( pSub->vBuffer );
+        ABC_FREE( pSub->pItems );
+        ABC_FREE( pSub->pError );
+    }
+    ABC_FREE( pMt->pSubs );
+    Vec_IntFree( pMt->vBlocks );
+    Vec_IntFree( pMt->vChilds );
+    return RetValue;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Parses the Liberty file.]
+
+  Description [If nProcs > 1, the bodies of the cells are parsed
+  concurrently; the resulting tree is the same, except for the order
+  of the items in the array.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Scl_Tree_t * Scl_LibertyParse( char * pFileName, int fVerbose, int nProcs )
 {
     Scl_Tree_t * p;
     char * pPos;
+    long RetValue;
     if ( (p = Scl_LibertyStart(pFileName)) == NULL )
         return NULL;
     pPos = p->pContents;
     Scl_LibertyWipeOutComments( p->pContents, p->pContents+p->nContents );
-    if ( (!Scl_LibertyBuildItem( p, &pPos, p->pContents + p->nContents )) == 0 )
+    if ( nProcs > 1 )
+    {
+        p->vCells     = Vec_IntAlloc( 1000 );
+        p->vCellLines = Vec_IntAlloc( 1000 );
+    }
+    RetValue = Scl_LibertyBuildItem( p, &pPos, p->pContents + p->nContents );
+    if ( p->vCells && Vec_IntSize(p->vCells) > 0 && !Scl_LibertyParseCells(p, nProcs) )
+        RetValue = -1;
+    if ( (!RetValue) == 0 )
     {
         if ( p->pError ) printf( "%s", p->pError );
         printf( "Parsing failed.  " );
@@ -876,9 +1107,9 @@ void Scl_LibertyReadLoadUnit( Scl_Tree_t * p, Vec_Str_t * vOut )
     Scl_ItemForEachChildName( p, Scl_LibertyRoot(p), pItem, "capacitive_load_unit" )
     {
         // expecting (1.00,ff) or (1, pf) ... 12 or 15 for 'pf' or 'ff'
-        char * pHead   = Scl_LibertyReadString(p, pItem->Head);
-        float First    = atof(strtok(pHead, " \t\n\r\\\","));
-        char * pSecond = strtok(NULL, " \t\n\r\\\",");
+        char * pHead   = Scl_LibertyReadString(p, pItem->Head), * pNext = NULL;
+        float First    = atof(Scl_LibertyToken(pHead, " \t\n\r\\\",", &pNext));
+        char * pSecond = Scl_LibertyToken(NULL, " \t\n\r\\\",", &pNext);
         Vec_StrPutF_( vOut, First );
         if ( pSecond && !strcmp(pSecond, "pf") )
             Vec_StrPutI_( vOut, 12 );
@@ -908,9 +1139,9 @@ void Scl_LibertyReadWireLoad( Scl_Tree_t * p, Vec_Str_t * vOut )
         Vec_StrPut_( vOut );
         Scl_ItemForEachChildName( p, pItem, pChild, "fanout_length" )
         {
-            char * pHead  = Scl_LibertyReadString(p, pChild->Head);
-            int    First  = atoi( strtok(pHead, " ,") );
-            float  Second = atof( strtok(NULL, " ") );
+            char * pHead  = Scl_LibertyReadString(p, pChild->Head), * pNext = NULL;
+            int    First  = atoi( Scl_LibertyToken(pHead, " ,", &pNext) );
+            float  Second = atof( Scl_LibertyToken(NULL, " ", &pNext) );
             Vec_StrPutI_( vOut, First );
             Vec_StrPutF_( vOut, Second );
             Vec_StrPut_( vOut );
@@ -932,10 +1163,10 @@ void Scl_LibertyReadWireLoadSelect( Scl_Tree_t * p, Vec_Str_t * vOut )
         Vec_StrPut_( vOut );
         Scl_ItemForEachChildName( p, pItem, pChild, "wire_load_from_area" )
         {
-            char * pHead  = Scl_LibertyReadString(p, pChild->Head);
-            float  First  = atof( strtok(pHead, " ,") );
-            float  Second = atof( strtok(NULL, " ,") );
-            char * pThird = strtok(NULL, " ");
+            char * pHead  = Scl_LibertyReadString(p, pChild->Head), * pNext = NULL;
+            float  First  = atof( Scl_LibertyToken(pHead, " ,", &pNext) );
+            float  Second = atof( Scl_LibertyToken(NULL, " ,", &pNext) );
+            char * pThird = Scl_LibertyToken(NULL, " ", &pNext);
             if ( pThird[0] == '\"' )
                 assert(pThird[strlen(pThird)-1] == '\"'), pThird[strlen(pThird)-1] = 0, pThird++;
             Vec_StrPutF_( vOut, First );
@@ -1015,9 +1246,9 @@ int Scl_LibertyReadTimingSense( Scl_Tree_t * p, Scl_Item_t * pPin )
 }
 Vec_Flt_t * Scl_LibertyReadFloatVec( char * pName )
 {
-    char * pToken;
+    char * pToken, * pNext = NULL;
     Vec_Flt_t * vValues = Vec_FltAlloc( 100 );
-    for ( pToken = strtok(pName, " \t\n\r\\\","); pToken; pToken = strtok(NULL, " \t\n\r\\\",") )
+    for ( pToken = Scl_LibertyToken(pName, " \t\n\r\\\",", &pNext); pToken; pToken = Scl_LibertyToken(NULL, " \t\n\r\\\",", &pNext) )
         Vec_FltPush( vValues, atof(pToken) );
     return vValues;
 }
@@ -1686,20 +1917,212 @@ Vec_Str_t * Scl_LibertyReadSclStr( Scl_Tree_t * p, int fVerbose, int fVeryVerbos
     }
     return vOut;
 }
-SC_Lib * Abc_SclReadLiberty( char * pFileName, int fVerbose, int fVeryVerbose, SC_DontUse dont_use )
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the cache key of the library.]
+
+  Description [Hashes the contents of the Liberty file, the names of
+  the dont_use cells and the version of the SCL format. Returns 0 if
+  the file cannot be read.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline word Scl_LibertyCacheHashStep( word Hash, word Data )
+{
+    Hash ^= Data;
+    Hash *= ABC_CONST(0x100000001B3);
+    return Hash ^ (Hash >> 29);
+}
+word Scl_LibertyCacheHash( char * pFileName, SC_DontUse dont_use )
+{
+    word Hash = ABC_CONST(0xCBF29CE484222325), Data;
+    size_t i, nSize, nWords;
+    int k, fMapped;
+    char * pContents = Util_CacheLoadFile( pFileName, &nSize, &fMapped );
+    if ( pContents == NULL )
+        return 0;
+    nWords = nSize / 8;
+    for ( i = 0; i < nWords; i++ )
+    {
+        memcpy( &Data, pContents + 8 * i, 8 );
+        Hash = Scl_LibertyCacheHashStep( Hash, Data );
+    }
+    for ( i = 8 * nWords; i < nSize; i++ )
+        Hash = Scl_LibertyCacheHashStep( Hash, (word)(unsigned char)pContents[i] );
+    Util_CacheUnloadFile( pContents, nSize, fMapped );
+    Hash = Scl_LibertyCacheHashStep( Hash, (word)nSize );
+    Hash = Scl_LibertyCacheHashStep( Hash, (word)ABC_SCL_CUR_VERSION );
+    for ( k = 0; k < dont_use.size; k++ )
+    {
+        char * pName = dont_use.dont_use_list[k];
+        Hash = Scl_LibertyCacheHashStep( Hash, (word)k );
+        for ( ; *pName; pName++ )
+            Hash = Scl_LibertyCacheHashStep( Hash, (word)(unsigned char)*pName );
+    }
+    return Hash ? Hash : 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the name of the cache file.]
+
+  Description [The file is placed into the directory given by the
+  environment variable ABC_LIB_CACHE or into the temporary directory.
+  The name is composed of the library file name and the hash key.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+char * Scl_LibertyCacheFileName( char * pFileName, word Hash )
+{
+    char * pDir = getenv( SCL_CACHE_DIR_VAR ), * pBase, * pRes;
+    if ( pDir == NULL || *pDir == 0 )
+        pDir = getenv( "TMPDIR" );
+#ifdef _WIN32
+    if ( pDir == NULL || *pDir == 0 )
+        pDir = getenv( "TEMP" );
+    if ( pDir == NULL || *pDir == 0 )
+        pDir = ".";
+#else
+    if ( pDir == NULL || *pDir == 0 )
+        pDir = "/tmp";
+#endif
+    pBase = Extra_FileNameWithoutPath( pFileName );
+    pRes = ABC_ALLOC( char, strlen(pDir) + strlen(pBase) + 40 );
+    sprintf( pRes, "%s/%s.%08x%08x.scl", pDir, pBase, (unsigned)(Hash >> 32), (unsigned)Hash );
+    return pRes;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the library from the cache.]
+
+  Description [Returns NULL if there is no valid cache entry. The cache
+  file is memory-mapped and the library is deserialized directly from
+  the mapped pages.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+SC_Lib * Scl_LibertyCacheRead( char * pCacheName, word Hash )
+{
+    SC_Lib * pLib = NULL;
+    Vec_Str_t vStr;
+    size_t nSize;
+    word Header[2];
+    int fMapped;
+    char * pContents = Util_CacheLoadFile( pCacheName, &nSize, &fMapped );
+    if ( pContents == NULL )
+        return NULL;
+    if ( nSize > SCL_CACHE_HEADER && !memcmp(pContents, SCL_CACHE_MAGIC, 8) )
+    {
+        memcpy( Header, pContents + 8, 16 );
+        if ( Header[0] == Hash && Header[1] == (word)(nSize - SCL_CACHE_HEADER) && Header[1] < (word)0x7FFFFFFF )
+        {
+            vStr.nCap   = (int)Header[1];
+            vStr.nSize  = (int)Header[1];
+            vStr.pArray = pContents + SCL_CACHE_HEADER;
+            pLib = Abc_SclReadFromStr( &vStr );
+        }
+    }
+    Util_CacheUnloadFile( pContents, nSize, fMapped );
+    return pLib;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the library into the cache.]
+
+  Description [The data is written into a temporary file, which is then
+  renamed, so that the concurrent jobs never see a partial entry.
+  Failures are silently ignored (for example, a read-only directory).]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Scl_LibertyCacheWrite( char * pCacheName, word Hash, Vec_Str_t * vStr )
+{
+    word Header[2] = { Hash, (word)Vec_StrSize(vStr) };
+    char * pTempName;
+    int RetValue;
+    FILE * pFile = Util_CacheWriteStart( pCacheName, &pTempName );
+    if ( pFile == NULL )
+        return;
+    RetValue  = fwrite( SCL_CACHE_MAGIC, 8, 1, pFile ) == 1;
+    RetValue &= fwrite( Header, 16, 1, pFile ) == 1;
+    RetValue &= fwrite( Vec_StrArray(vStr), Vec_StrSize(vStr), 1, pFile ) == 1;
+    Util_CacheWriteStop( pFile, pTempName, pCacheName, RetValue );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the Liberty library.]
+
+  Description [If fUseCache is set, the parsed library is looked up in
+  the on-disk cache (see Scl_LibertyCacheFileName) and stored there
+  after parsing, so that the following runs reading the same unchanged
+  library skip the parser. If nProcs > 1, the cells are parsed by
+  several threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+SC_Lib * Abc_SclReadLiberty( char * pFileName, int fVerbose, int fVeryVerbose, SC_DontUse dont_use, int fUseCache, int nProcs )
 {
     SC_Lib * pLib;
     Scl_Tree_t * p;
     Vec_Str_t * vStr;
-    p = Scl_LibertyParse( pFileName, fVeryVerbose );
+    char * pCacheName = NULL;
+    word Hash = 0;
+    if ( fUseCache && (Hash = Scl_LibertyCacheHash( pFileName, dont_use )) )
+    {
+        abctime clk = Abc_Clock();
+        pCacheName = Scl_LibertyCacheFileName( pFileName, Hash );
+        pLib = Scl_LibertyCacheRead( pCacheName, Hash );
+        if ( pLib != NULL )
+        {
+            if ( fVerbose )
+            {
+                printf( "Library \"%s\" from \"%s\" has %d cells (loaded from cache \"%s\").  ", 
+                    pLib->pName, pFileName, SC_LibCellNum(pLib), pCacheName );
+                Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+            }
+            ABC_FREE( pCacheName );
+            pLib->pFileName = Abc_UtilStrsav( pFileName );
+            Abc_SclLibNormalize( pLib );
+            return pLib;
+        }
+    }
+    p = Scl_LibertyParse( pFileName, fVeryVerbose, nProcs );
     if ( p == NULL )
+    {
+        ABC_FREE( pCacheName );
         return NULL;
+    }
 //    Scl_LibertyParseDump( p, "temp_.lib" );
     // collect relevant data
     vStr = Scl_LibertyReadSclStr( p, fVerbose, fVeryVerbose, dont_use );
     Scl_LibertyStop( p, fVeryVerbose );
     if ( vStr == NULL )
+    {
+        ABC_FREE( pCacheName );
         return NULL;
+    }
+    if ( pCacheName )
+        Scl_LibertyCacheWrite( pCacheName, Hash, vStr );
+    ABC_FREE( pCacheName );
     // construct SCL data-structure
     pLib = Abc_SclReadFromStr( vStr );
     if ( pLib == NULL )
@@ -1711,6 +2134,58 @@ SC_Lib * Abc_SclReadLiberty( char * pFileName, int fVerbose, int fVeryVerbose, S
     return pLib;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Reads several Liberty libraries concurrently.]
+
+  Description [The libraries are read by separate threads, which share
+  nProcs threads among them for parsing the cells. The messages of the
+  readers are suppressed and a summary is printed after reading, if
+  fVerbose is set. The entries of ppLibs are NULL for the libraries
+  that could not be read.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+typedef struct Scl_ReadMt_t_ Scl_ReadMt_t;
+struct Scl_ReadMt_t_
+{
+    char **         pFileNames;   // the library file names
+    SC_Lib **       ppLibs;       // the resulting libraries
+    SC_DontUse      dont_use;     // the cells not to use
+    int             fUseCache;    // use the library cache
+    int             nProcs;       // the number of threads per library
+};
+static void Abc_SclReadLibertyRange( void * pArg, int iThread, int iStart, int iStop )
+{
+    Scl_ReadMt_t * pRd = (Scl_ReadMt_t *)pArg;
+    int i;
+    for ( i = iStart; i < iStop; i++ )
+        pRd->ppLibs[i] = Abc_SclReadLiberty( pRd->pFileNames[i], 0, 0, pRd->dont_use, pRd->fUseCache, pRd->nProcs );
+}
+void Abc_SclReadLibertyArray( char ** pFileNames, SC_Lib ** ppLibs, int nFiles, int fVerbose, SC_DontUse dont_use, int fUseCache, int nProcs )
+{
+    Scl_ReadMt_t Rd, * pRd = &Rd;
+    Scl_Pool_t * pPool = Abc_SclPoolStart( Abc_MinInt(nProcs, nFiles) );
+    abctime clk = Abc_Clock();
+    int i;
+    pRd->pFileNames = pFileNames;
+    pRd->ppLibs     = ppLibs;
+    pRd->dont_use   = dont_use;
+    pRd->fUseCache  = fUseCache;
+    pRd->nProcs     = Abc_MaxInt( 1, nProcs / nFiles );
+    Abc_SclPoolRun( pPool, Abc_SclReadLibertyRange, pRd, nFiles, 1 );
+    Abc_SclPoolStop( pPool );
+    if ( !fVerbose )
+        return;
+    for ( i = 0; i < nFiles; i++ )
+        if ( ppLibs[i] )
+            printf( "Library \"%s\" from \"%s\" has %d cells.\n", ppLibs[i]->pName, pFileNames[i], SC_LibCellNum(ppLibs[i]) );
+    Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Experiments with Liberty parsing.]
@@ -1730,7 +2205,7 @@ void Scl_LibertyTest()
     Scl_Tree_t * p;
     Vec_Str_t * vStr;
 //    return;
-    p = Scl_LibertyParse( pFileName, fVeryVerbose );
+    p = Scl_LibertyParse( pFileName, fVeryVerbose, 1 );
     if ( p == NULL )
         return;
 //    Scl_LibertyParseDump( p, "temp_.lib" );
@@ -279,33 +279,6 @@ static inline void Abc_SclTimeFanin( SC_Man * p, SC_Timing * pTime, Abc_Obj_t *
     SC_Pair * pSlewOut = Abc_SclObjSlew( p, pObj );   // modified
     Scl_LibPinArrival( pTime, pArrIn, pSlewIn, pLoad, pArrOut, pSlewOut );
 }
-static inline void Abc_SclDeptFanin( SC_Man * p, SC_Timing * pTime, Abc_Obj_t * pObj, Abc_Obj_t * pFanin )
-{
-    SC_Pair * pDepIn   = Abc_SclObjDept( p, pFanin );   // modified
-    SC_Pair * pSlewIn  = Abc_SclObjSlew( p, pFanin );
-    SC_Pair * pLoad    = Abc_SclObjLoad( p, pObj );
-    SC_Pair * pDepOut  = Abc_SclObjDept( p, pObj );
-    Scl_LibPinDeparture( pTime, pDepIn, pSlewIn, pLoad, pDepOut );
-}
-static inline void Abc_SclDeptObj( SC_Man * p, Abc_Obj_t * pObj )
-{
-    SC_Timing * pTime;
-    Abc_Obj_t * pFanout;
-    int i;
-    SC_PairClean( Abc_SclObjDept(p, pObj) );
-    Abc_ObjForEachFanout( pObj, pFanout, i )
-    {
-        if ( Abc_ObjIsCo(pFanout) || Abc_ObjIsLatch(pFanout) )
-            continue;
-        pTime = Scl_CellPinTime( Abc_SclObjCell(pFanout), Abc_NodeFindFanin(pFanout, pObj) );
-        Abc_SclDeptFanin( p, pTime, pFanout, pObj );
-    }
-}
-static inline float Abc_SclObjLoadValue( SC_Man * p, Abc_Obj_t * pObj )
-{
-//    float Value = Abc_MaxFloat(pLoad->fall, pLoad->rise) / (p->EstLoadAve * p->EstLoadMax);
-    return (0.5 * Abc_SclObjLoad(p, pObj)->fall + 0.5 * Abc_SclObjLoad(p, pObj)->rise) / (p->EstLoadAve * p->EstLoadMax);
-}
 static inline void Abc_SclTimeCi( SC_Man * p, Abc_Obj_t * pObj )
 {
     if ( p->pPiDrive != NULL )
@@ -418,6 +391,9 @@ void Abc_SclTimeNtkRecompute( SC_Man * p, float * pArea, float * pDelay, int fRe
     p->nEstNodes = 0;
     Abc_NtkForEachCi( p->pNtk, pObj, i )
         Abc_SclTimeNode( p, pObj, 0 );
+    if ( p->pPool )
+        Abc_SclTimeNtkRecomputeMt( p, 0 );
+    else
     Abc_NtkForEachNode1( p->pNtk, pObj, i )
         Abc_SclTimeNode( p, pObj, 0 );
     Abc_NtkForEachCo( p->pNtk, pObj, i )
@@ -432,6 +408,9 @@ void Abc_SclTimeNtkRecompute( SC_Man * p, float * pArea, float * pDelay, int fRe
     if ( fReverse )
     {
         p->nEstNodes = 0;
+        if ( p->pPool )
+            Abc_SclTimeNtkRecomputeMt( p, 1 );
+        else
         Abc_NtkForEachNodeReverse1( p->pNtk, pObj, i )
             Abc_SclTimeNode( p, pObj, 1 );
     }
@@ -540,6 +519,74 @@ static inline void Abc_SclTimeIncUpdateDeparture( SC_Man * p )
     } 
     p->MaxDelay = Abc_SclReadMaxDelay( p );
 }
+static inline void Abc_SclTimeIncUpdateArrivalMt( SC_Man * p )
+{
+    Vec_Int_t * vFlags = Vec_IntAlloc( 100 );
+    Vec_Int_t * vLevel;
+    SC_Pair ArrOut, SlewOut;
+    SC_Pair * pArrOut, *pSlewOut;
+    Abc_Obj_t * pObj;
+    float E = (float)0.1;
+    int i, k, kStart, kStop;
+    Vec_WecForEachLevel( p->vLevels, vLevel, i )
+    {
+        // the nodes of the level are updated concurrently; the objects
+        // added to the level while it is processed are updated afterwards
+        for ( kStart = 0; kStart < Vec_IntSize(vLevel); kStart = kStop )
+        {
+            kStop = Vec_IntSize(vLevel);
+            Abc_SclTimeIncLevelMt( p, vLevel, kStart, kStop, 0, vFlags );
+            for ( k = kStart; k < kStop; k++ )
+            {
+                pObj = Abc_NtkObj( p->pNtk, Vec_IntEntry(vLevel, k) );
+                if ( Abc_ObjIsCo(pObj) )
+                {
+                    Abc_SclObjDupFanin( p, pObj );
+                    Vec_FltWriteEntry( p->vTimesOut, pObj->iData, Abc_SclObjTimeMax(p, pObj) );
+                    Vec_QueUpdate( p->vQue, pObj->iData );
+                    continue;
+                }
+                if ( Abc_ObjIsCi(pObj) )
+                {
+                    pArrOut  = Abc_SclObjTime( p, pObj );
+                    pSlewOut = Abc_SclObjSlew( p, pObj );
+                    SC_PairMove( &ArrOut,  pArrOut  );
+                    SC_PairMove( &SlewOut, pSlewOut );
+                    Abc_SclTimeNode( p, pObj, 0 );
+                    if ( !SC_PairEqualE(&ArrOut, pArrOut, E) || !SC_PairEqualE(&SlewOut, pSlewOut, E) )
+                        Vec_IntWriteEntry( vFlags, k, 1 );
+                }
+                if ( Vec_IntEntry(vFlags, k) )
+                    Abc_SclTimeIncAddFanouts( p, pObj );
+            }
+        }
+    }
+    Vec_IntFree( vFlags );
+    p->MaxDelay = Abc_SclReadMaxDelay( p );
+}
+static inline void Abc_SclTimeIncUpdateDepartureMt( SC_Man * p )
+{
+    Vec_Int_t * vFlags = Vec_IntAlloc( 100 );
+    Vec_Int_t * vLevel;
+    Abc_Obj_t * pObj;
+    int i, k, kStart, kStop;
+    Vec_WecForEachLevelReverse( p->vLevels, vLevel, i )
+    {
+        for ( kStart = 0; kStart < Vec_IntSize(vLevel); kStart = kStop )
+        {
+            kStop = Vec_IntSize(vLevel);
+            Abc_SclTimeIncLevelMt( p, vLevel, kStart, kStop, 1, vFlags );
+            for ( k = kStart; k < kStop; k++ )
+                if ( Vec_IntEntry(vFlags, k) )
+                {
+                    pObj = Abc_NtkObj( p->pNtk, Vec_IntEntry(vLevel, k) );
+                    Abc_SclTimeIncAddFanins( p, pObj );
+                }
+        }
+    } 
+    Vec_IntFree( vFlags );
+    p->MaxDelay = Abc_SclReadMaxDelay( p );
+}
 void Abc_SclTimeIncCheckLevel( Abc_Ntk_t * pNtk )
 {
     Abc_Obj_t * pObj;
@@ -563,8 +610,16 @@ int Abc_SclTimeIncUpdate( SC_Man * p )
         Abc_SclTimeIncAddNode( p, pObj );
     }
     Vec_IntClear( p->vChanged );
-    Abc_SclTimeIncUpdateArrival( p );
-    Abc_SclTimeIncUpdateDeparture( p );
+    if ( p->pPool )
+    {
+        Abc_SclTimeIncUpdateArrivalMt( p );
+        Abc_SclTimeIncUpdateDepartureMt( p );
+    }
+    else
+    {
+        Abc_SclTimeIncUpdateArrival( p );
+        Abc_SclTimeIncUpdateDeparture( p );
+    }
     Abc_SclTimeIncUpdateClean( p );
     RetValue = p->nIncUpdates;
     p->nIncUpdates = 0;
@@ -641,9 +696,11 @@ void Abc_SclManReadSlewAndLoad( SC_Man * p, Abc_Ntk_t * pNtk )
   SeeAlso     []
 
 ***********************************************************************/
-SC_Man * Abc_SclManStart( SC_Lib * pLib, Abc_Ntk_t * pNtk, int fUseWireLoads, int fDept, float DUser, int nTreeCRatio )
+SC_Man * Abc_SclManStart( SC_Lib * pLib, Abc_Ntk_t * pNtk, int fUseWireLoads, int fDept, float DUser, int nTreeCRatio, int nProcs )
 {
     SC_Man * p = Abc_SclManAlloc( pLib, pNtk );
+    if ( nProcs > 1 )
+        p->pPool = Abc_SclPoolStart( nProcs );
     if ( nTreeCRatio )
     {
         p->EstLoadMax = 0.01 * nTreeCRatio;  // max ratio of Cout/Cave when the estimation is used
@@ -679,10 +736,10 @@ SC_Man * Abc_SclManStart( SC_Lib * pLib, Abc_Ntk_t * pNtk, int fUseWireLoads, in
   SeeAlso     []
 
 ***********************************************************************/
-void Abc_SclTimePerformInt( SC_Lib * pLib, Abc_Ntk_t * pNtk, int nTreeCRatio, int fUseWireLoads, int fShowAll, int fPrintPath, int fDumpStats )
+void Abc_SclTimePerformInt( SC_Lib * pLib, Abc_Ntk_t * pNtk, int nTreeCRatio, int fUseWireLoads, int fShowAll, int fPrintPath, int fDumpStats, int nProcs )
 {
     SC_Man * p;
-    p = Abc_SclManStart( pLib, pNtk, fUseWireLoads, 1, 0, nTreeCRatio );
+    p = Abc_SclManStart( pLib, pNtk, fUseWireLoads, 1, 0, nTreeCRatio, nProcs );
     Abc_SclTimeNtkPrint( p, fShowAll, fPrintPath );
     if ( fDumpStats )
         Abc_SclDumpStats( p, "stats.txt", 0 );
@@ -700,12 +757,12 @@ void Abc_SclTimePerformInt( SC_Lib * pLib, Abc_Ntk_t * pNtk, int nTreeCRatio, in
   SeeAlso     []
 
 ***********************************************************************/
-void Abc_SclTimePerform( SC_Lib * pLib, Abc_Ntk_t * pNtk, int nTreeCRatio, int fUseWireLoads, int fShowAll, int fPrintPath, int fDumpStats )
+void Abc_SclTimePerform( SC_Lib * pLib, Abc_Ntk_t * pNtk, int nTreeCRatio, int fUseWireLoads, int fShowAll, int fPrintPath, int fDumpStats, int nProcs )
 {
     Abc_Ntk_t * pNtkNew = pNtk;
     if ( pNtk->nBarBufs2 > 0 )
         pNtkNew = Abc_NtkDupDfsNoBarBufs( pNtk );
-    Abc_SclTimePerformInt( pLib, pNtkNew, nTreeCRatio, fUseWireLoads, fShowAll, fPrintPath, fDumpStats );
+    Abc_SclTimePerformInt( pLib, pNtkNew, nTreeCRatio, fUseWireLoads, fShowAll, fPrintPath, fDumpStats, nProcs );
     if ( pNtk->nBarBufs2 > 0 )
         Abc_NtkDelete( pNtkNew );
 }
@@ -910,7 +967,7 @@ void Abc_SclPrintBuffers( SC_Lib * pLib, Abc_Ntk_t * pNtk, int fVerbose )
     int fUseWireLoads = 0;
     SC_Man * p;
     assert( Abc_NtkIsMappedLogic(pNtk) );
-    p = Abc_SclManStart( pLib, pNtk, fUseWireLoads, 1, 0, 10000 ); 
+    p = Abc_SclManStart( pLib, pNtk, fUseWireLoads, 1, 0, 10000, 1 ); 
     Abc_SclPrintBufferTrees( p, pNtk ); 
 //    Abc_SclPrintFaninPairs( p, pNtk );
     Abc_SclManFree( p );
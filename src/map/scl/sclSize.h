@@ -41,7 +41,13 @@ ABC_NAMESPACE_HEADER_START
 ///                    STRUCTURE DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
 
+#define SCL_PROC_MAX 64
+
 typedef struct SC_Man_          SC_Man;
+typedef struct Scl_Pool_t_      Scl_Pool_t;
+typedef struct Scl_SizeMt_t_    Scl_SizeMt_t;
+
+typedef void (*Scl_PoolFunc_t)( void * pArg, int iThread, int iStart, int iStop );
 struct SC_Man_ 
 {
     SC_Lib *       pLib;          // library
@@ -82,6 +88,9 @@ struct SC_Man_
     Vec_Wec_t *    vLevels;
     Vec_Int_t *    vChanged; 
     int            nIncUpdates;
+    // concurrent evaluation
+    Scl_Pool_t *   pPool;         // worker threads
+    Scl_SizeMt_t * pMt;           // evaluator of sizing windows
     // optimization parameters
     float          SumArea;       // total area
     float          MaxDelay;      // max delay
@@ -191,8 +200,11 @@ static inline SC_Man * Abc_SclManAlloc( SC_Lib * pLib, Abc_Ntk_t * pNtk )
 }
 static inline void Abc_SclManFree( SC_Man * p )
 {
+    extern void Abc_SclPoolStop( Scl_Pool_t * p );
     Abc_Obj_t * pObj;
     int i;
+    if ( p->pPool )
+        Abc_SclPoolStop( p->pPool );
     // set CI/CO ids
     Abc_NtkForEachCi( p->pNtk, pObj, i )
         pObj->iData = 0;
@@ -276,6 +288,45 @@ static inline void Abc_SclManCleanTime( SC_Man * p )
 }
 
 
+/**Function*************************************************************
+
+  Synopsis    [Departure time computation.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Abc_SclDeptFanin( SC_Man * p, SC_Timing * pTime, Abc_Obj_t * pObj, Abc_Obj_t * pFanin )
+{
+    SC_Pair * pDepIn   = Abc_SclObjDept( p, pFanin );   // modified
+    SC_Pair * pSlewIn  = Abc_SclObjSlew( p, pFanin );
+    SC_Pair * pLoad    = Abc_SclObjLoad( p, pObj );
+    SC_Pair * pDepOut  = Abc_SclObjDept( p, pObj );
+    Scl_LibPinDeparture( pTime, pDepIn, pSlewIn, pLoad, pDepOut );
+}
+static inline void Abc_SclDeptObj( SC_Man * p, Abc_Obj_t * pObj )
+{
+    SC_Timing * pTime;
+    Abc_Obj_t * pFanout;
+    int i;
+    SC_PairClean( Abc_SclObjDept(p, pObj) );
+    Abc_ObjForEachFanout( pObj, pFanout, i )
+    {
+        if ( Abc_ObjIsCo(pFanout) || Abc_ObjIsLatch(pFanout) )
+            continue;
+        pTime = Scl_CellPinTime( Abc_SclObjCell(pFanout), Abc_NodeFindFanin(pFanout, pObj) );
+        Abc_SclDeptFanin( p, pTime, pFanout, pObj );
+    }
+}
+static inline float Abc_SclObjLoadValue( SC_Man * p, Abc_Obj_t * pObj )
+{
+//    float Value = Abc_MaxFloat(pLoad->fall, pLoad->rise) / (p->EstLoadAve * p->EstLoadMax);
+    return (0.5 * Abc_SclObjLoad(p, pObj)->fall + 0.5 * Abc_SclObjLoad(p, pObj)->rise) / (p->EstLoadAve * p->EstLoadMax);
+}
+
 /**Function*************************************************************
 
   Synopsis    [Stores/retrivies information for the logic cone.]
@@ -551,6 +602,7 @@ extern int           Abc_SclCheckNtk( Abc_Ntk_t * p, int fVerbose );
 extern Abc_Ntk_t *   Abc_SclPerformBuffering( Abc_Ntk_t * p, int DegreeR, int Degree, int fUseInvs, int fVerbose );
 extern Abc_Ntk_t *   Abc_SclBufPerform( Abc_Ntk_t * pNtk, int FanMin, int FanMax, int fBufPis, int fSkipDup, int fVerbose );
 /*=== sclDnsize.c ===============================================================*/
+extern int           Abc_SclFindBestDnsize( SC_Man * p, Abc_Obj_t * pObj, Vec_Int_t * vNodes, Vec_Int_t * vEvals, int Notches, int DelayGap, float * pGainBest );
 extern void          Abc_SclDnsizePerform( SC_Lib * pLib, Abc_Ntk_t * pNtk, SC_SizePars * pPars );
 /*=== sclLoad.c ===============================================================*/
 extern Vec_Flt_t *   Abc_SclFindWireCaps( SC_WireLoad * pWL, int nFanoutMax );
@@ -563,16 +615,35 @@ extern void          Abc_SclUpdateLoadSplit( SC_Man * p, Abc_Obj_t * pBuffer, Ab
 extern Abc_Obj_t *   Abc_SclFindCriticalCo( SC_Man * p, int * pfRise );
 extern Abc_Obj_t *   Abc_SclFindMostCriticalFanin( SC_Man * p, int * pfRise, Abc_Obj_t * pNode );
 extern void          Abc_SclTimeNtkPrint( SC_Man * p, int fShowAll, int fPrintPath );
-extern SC_Man *      Abc_SclManStart( SC_Lib * pLib, Abc_Ntk_t * pNtk, int fUseWireLoads, int fDept, float DUser, int nTreeCRatio );
+extern SC_Man *      Abc_SclManStart( SC_Lib * pLib, Abc_Ntk_t * pNtk, int fUseWireLoads, int fDept, float DUser, int nTreeCRatio, int nProcs );
 extern void          Abc_SclTimeCone( SC_Man * p, Vec_Int_t * vCone );
 extern void          Abc_SclTimeNtkRecompute( SC_Man * p, float * pArea, float * pDelay, int fReverse, float DUser );
 extern int           Abc_SclTimeIncUpdate( SC_Man * p );
 extern void          Abc_SclTimeIncInsert( SC_Man * p, Abc_Obj_t * pObj );
 extern void          Abc_SclTimeIncUpdateLevel( Abc_Obj_t * pObj );
-extern void          Abc_SclTimePerform( SC_Lib * pLib, Abc_Ntk_t * pNtk, int nTreeCRatio, int fUseWireLoads, int fShowAll, int fPrintPath, int fDumpStats );
+extern void          Abc_SclTimePerform( SC_Lib * pLib, Abc_Ntk_t * pNtk, int nTreeCRatio, int fUseWireLoads, int fShowAll, int fPrintPath, int fDumpStats, int nProcs );
 extern void          Abc_SclPrintBuffers( SC_Lib * pLib, Abc_Ntk_t * pNtk, int fVerbose );
+/*=== sclSizeMt.c ===============================================================*/
+extern Scl_SizeMt_t * Abc_SclSizeMtStart( SC_Man * p );
+extern void          Abc_SclSizeMtStop( Scl_SizeMt_t * pMt );
+extern void          Abc_SclSizeMtClear( Scl_SizeMt_t * pMt );
+extern int           Abc_SclSizeMtAddWindow( Scl_SizeMt_t * pMt, Abc_Obj_t * pObj, Vec_Int_t * vNodes, Vec_Int_t * vEvals );
+extern void          Abc_SclSizeMtEvaluate( Scl_SizeMt_t * pMt, int fDnsize, int Notches, int DelayGap );
+extern int           Abc_SclSizeMtWinNum( Scl_SizeMt_t * pMt );
+extern int           Abc_SclSizeMtObj( Scl_SizeMt_t * pMt, int i );
+extern Vec_Int_t *   Abc_SclSizeMtNodes( Scl_SizeMt_t * pMt, int i );
+extern int           Abc_SclSizeMtGate( Scl_SizeMt_t * pMt, int i );
+extern float         Abc_SclSizeMtGain( Scl_SizeMt_t * pMt, int i );
+/*=== sclTimeMt.c ===============================================================*/
+extern Scl_Pool_t *  Abc_SclPoolStart( int nProcs );
+extern void          Abc_SclPoolStop( Scl_Pool_t * p );
+extern int           Abc_SclPoolProcNum( Scl_Pool_t * p );
+extern void          Abc_SclPoolRun( Scl_Pool_t * p, Scl_PoolFunc_t pFunc, void * pArg, int nItems, int nGrain );
+extern void          Abc_SclTimeNtkRecomputeMt( SC_Man * p, int fDept );
+extern void          Abc_SclTimeIncLevelMt( SC_Man * p, Vec_Int_t * vLevel, int iStart, int iStop, int fDept, Vec_Int_t * vFlags );
 /*=== sclUpsize.c ===============================================================*/
 extern int           Abc_SclCountNearCriticalNodes( SC_Man * p );
+extern int           Abc_SclFindBestCell( SC_Man * p, Abc_Obj_t * pObj, Vec_Int_t * vRecalcs, Vec_Int_t * vEvals, int Notches, int DelayGap, float * pGainBest );
 extern void          Abc_SclUpsizePerform( SC_Lib * pLib, Abc_Ntk_t * pNtk, SC_SizePars * pPars );
 /*=== sclUtil.c ===============================================================*/
 extern void          Abc_SclMioGates2SclGates( SC_Lib * pLib, Abc_Ntk_t * p );
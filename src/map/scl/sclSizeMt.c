@@ -0,0 +1,280 @@
+/**CFile****************************************************************
+
+  FileName    [sclSizeMt.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Standard-cell library representation.]
+
+  Synopsis    [Multi-threaded evaluation of gate sizing windows.]
+
+  Author      [Alan Mishchenko, Niklas Een]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - August 24, 2012.]
+
+  Revision    [$Id: sclSizeMt.c,v 1.0 2012/08/24 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include "sclSize.h"
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+// the sizing commands collect a batch of windows (the node to resize, the
+// nodes whose timing is recomputed and the nodes whose timing is evaluated),
+// which do not interfere: no window updates the timing, the load or the gate
+// of an object, whose data is read by another window; the windows of a batch
+// are evaluated concurrently against the current timing using the shared
+// timing arrays, and each thread has its own copy of the manager with
+// private backup storage; since every evaluation restores the data it
+// changes, the results do not depend on the number of threads
+
+struct Scl_SizeMt_t_
+{
+    SC_Man *         p;               // the sizing manager
+    int              nProcs;          // the number of threads
+    SC_Man *         pMans;           // the copies of the manager
+    // windows of the current batch
+    Vec_Int_t *      vObjs;           // the nodes to resize
+    Vec_Wec_t *      vNodes;          // the nodes to recompute
+    Vec_Wec_t *      vEvals;          // the nodes to evaluate
+    Vec_Int_t *      vGates;          // the best gate of each window
+    Vec_Flt_t *      vGains;          // the best gain of each window
+    Vec_Int_t *      vStampR;         // the last batch reading the object
+    Vec_Int_t *      vStampW;         // the last batch updating the object
+    int              Stamp;           // the current batch
+    // evaluation parameters
+    int              fDnsize;         // evaluate downsizing
+    int              Notches;         // the limit on the resizing steps
+    int              DelayGap;        // the delay gap
+};
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Evaluates the given range of windows.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Abc_SclSizeMtEvalRange( void * pArg, int iThread, int iStart, int iStop )
+{
+    Scl_SizeMt_t * pMt = (Scl_SizeMt_t *)pArg;
+    SC_Man * p = pMt->pMans + iThread;
+    Abc_Obj_t * pObj;
+    float Gain;
+    int i, Gate;
+    for ( i = iStart; i < iStop; i++ )
+    {
+        pObj = Abc_NtkObj( p->pNtk, Vec_IntEntry(pMt->vObjs, i) );
+        if ( pMt->fDnsize )
+            Gate = Abc_SclFindBestDnsize( p, pObj, Vec_WecEntry(pMt->vNodes, i), Vec_WecEntry(pMt->vEvals, i), pMt->Notches, pMt->DelayGap, &Gain );
+        else
+            Gate = Abc_SclFindBestCell( p, pObj, Vec_WecEntry(pMt->vNodes, i), Vec_WecEntry(pMt->vEvals, i), pMt->Notches, pMt->DelayGap, &Gain );
+        Vec_IntWriteEntry( pMt->vGates, i, Gate );
+        Vec_FltWriteEntry( pMt->vGains, i, Gain );
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starts and stops the evaluation manager.]
+
+  Description [The windows are evaluated by the worker threads of
+  the sizing manager.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Scl_SizeMt_t * Abc_SclSizeMtStart( SC_Man * p )
+{
+    Scl_SizeMt_t * pMt = ABC_CALLOC( Scl_SizeMt_t, 1 );
+    int i;
+    pMt->p       = p;
+    pMt->nProcs  = Abc_SclPoolProcNum( p->pPool );
+    pMt->pMans   = ABC_CALLOC( SC_Man, pMt->nProcs );
+    for ( i = 0; i < pMt->nProcs; i++ )
+    {
+        pMt->pMans[i].vLoads2 = Vec_FltAlloc( 100 );
+        pMt->pMans[i].vTimes2 = Vec_FltAlloc( 100 );
+        pMt->pMans[i].vTimes3 = Vec_FltAlloc( 100 );
+    }
+    pMt->vObjs   = Vec_IntAlloc( 1000 );
+    pMt->vNodes  = Vec_WecAlloc( 1000 );
+    pMt->vEvals  = Vec_WecAlloc( 1000 );
+    pMt->vGates  = Vec_IntAlloc( 1000 );
+    pMt->vGains  = Vec_FltAlloc( 1000 );
+    pMt->vStampR = Vec_IntStart( Abc_NtkObjNumMax(p->pNtk) );
+    pMt->vStampW = Vec_IntStart( Abc_NtkObjNumMax(p->pNtk) );
+    pMt->Stamp   = 1;
+    return pMt;
+}
+void Abc_SclSizeMtStop( Scl_SizeMt_t * pMt )
+{
+    int i;
+    for ( i = 0; i < pMt->nProcs; i++ )
+    {
+        Vec_FltFree( pMt->pMans[i].vLoads2 );
+        Vec_FltFree( pMt->pMans[i].vTimes2 );
+        Vec_FltFree( pMt->pMans[i].vTimes3 );
+    }
+    ABC_FREE( pMt->pMans );
+    Vec_IntFree( pMt->vObjs );
+    Vec_WecFree( pMt->vNodes );
+    Vec_WecFree( pMt->vEvals );
+    Vec_IntFree( pMt->vGates );
+    Vec_FltFree( pMt->vGains );
+    Vec_IntFree( pMt->vStampR );
+    Vec_IntFree( pMt->vStampW );
+    ABC_FREE( pMt );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Adds one window to the current batch.]
+
+  Description [Returns 0 if the window interferes with the windows
+  already in the batch. The window updates the timing of vNodes and
+  the loads of the fanins of pObj (which belong to vNodes), and reads
+  the timing and the gates of the nodes in vNodes and their fanins.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_SclSizeMtAddWindow( Scl_SizeMt_t * pMt, Abc_Obj_t * pObj, Vec_Int_t * vNodes, Vec_Int_t * vEvals )
+{
+    Abc_Ntk_t * pNtk = pMt->p->pNtk;
+    Abc_Obj_t * pTemp, * pFanin;
+    int i, k;
+    Vec_IntFillExtra( pMt->vStampR, Abc_NtkObjNumMax(pNtk), 0 );
+    Vec_IntFillExtra( pMt->vStampW, Abc_NtkObjNumMax(pNtk), 0 );
+    // check the overlap
+    Abc_NtkForEachObjVec( vNodes, pNtk, pTemp, i )
+    {
+        if ( Vec_IntEntry(pMt->vStampR, Abc_ObjId(pTemp)) == pMt->Stamp )
+            return 0;
+        if ( Vec_IntEntry(pMt->vStampW, Abc_ObjId(pTemp)) == pMt->Stamp )
+            return 0;
+        Abc_ObjForEachFanin( pTemp, pFanin, k )
+            if ( Vec_IntEntry(pMt->vStampW, Abc_ObjId(pFanin)) == pMt->Stamp )
+                return 0;
+    }
+    Abc_ObjForEachFanin( pObj, pFanin, k )
+        if ( Vec_IntEntry(pMt->vStampR, Abc_ObjId(pFanin)) == pMt->Stamp )
+            return 0;
+    // mark the objects
+    Abc_NtkForEachObjVec( vNodes, pNtk, pTemp, i )
+    {
+        Vec_IntWriteEntry( pMt->vStampW, Abc_ObjId(pTemp), pMt->Stamp );
+        Vec_IntWriteEntry( pMt->vStampR, Abc_ObjId(pTemp), pMt->Stamp );
+        Abc_ObjForEachFanin( pTemp, pFanin, k )
+            Vec_IntWriteEntry( pMt->vStampR, Abc_ObjId(pFanin), pMt->Stamp );
+    }
+    Abc_ObjForEachFanin( pObj, pFanin, k )
+        Vec_IntWriteEntry( pMt->vStampW, Abc_ObjId(pFanin), pMt->Stamp );
+    // save the window
+    Vec_IntPush( pMt->vObjs, Abc_ObjId(pObj) );
+    Vec_IntAppend( Vec_WecPushLevel(pMt->vNodes), vNodes );
+    Vec_IntAppend( Vec_WecPushLevel(pMt->vEvals), vEvals );
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Evaluates the windows of the current batch.]
+
+  Description [For each window, finds the best gate (or -1) and its
+  gain, which can be read using Abc_SclSizeMtGate() and Abc_SclSizeMtGain().
+  The timing information is not changed.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_SclSizeMtEvaluate( Scl_SizeMt_t * pMt, int fDnsize, int Notches, int DelayGap )
+{
+    int i, nWins = Vec_IntSize( pMt->vObjs );
+    pMt->fDnsize  = fDnsize;
+    pMt->Notches  = Notches;
+    pMt->DelayGap = DelayGap;
+    Vec_IntFill( pMt->vGates, nWins, -1 );
+    Vec_FltFill( pMt->vGains, nWins, 0 );
+    // refresh the copies of the manager (the arrays may have been reallocated)
+    for ( i = 0; i < pMt->nProcs; i++ )
+    {
+        SC_Man * pMan = pMt->pMans + i;
+        Vec_Flt_t * vLoads2 = pMan->vLoads2;
+        Vec_Flt_t * vTimes2 = pMan->vTimes2;
+        Vec_Flt_t * vTimes3 = pMan->vTimes3;
+        *pMan = *pMt->p;
+        pMan->vLoads2 = vLoads2;
+        pMan->vTimes2 = vTimes2;
+        pMan->vTimes3 = vTimes3;
+    }
+    Abc_SclPoolRun( pMt->p->pPool, Abc_SclSizeMtEvalRange, pMt, nWins, 2 );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Access to the windows of the current batch.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_SclSizeMtClear( Scl_SizeMt_t * pMt )
+{
+    Vec_IntClear( pMt->vObjs );
+    Vec_WecClear( pMt->vNodes );
+    Vec_WecClear( pMt->vEvals );
+    pMt->Stamp++;
+}
+int Abc_SclSizeMtWinNum( Scl_SizeMt_t * pMt )
+{
+    return Vec_IntSize( pMt->vObjs );
+}
+int Abc_SclSizeMtObj( Scl_SizeMt_t * pMt, int i )
+{
+    return Vec_IntEntry( pMt->vObjs, i );
+}
+Vec_Int_t * Abc_SclSizeMtNodes( Scl_SizeMt_t * pMt, int i )
+{
+    return Vec_WecEntry( pMt->vNodes, i );
+}
+int Abc_SclSizeMtGate( Scl_SizeMt_t * pMt, int i )
+{
+    return Vec_IntEntry( pMt->vGates, i );
+}
+float Abc_SclSizeMtGain( Scl_SizeMt_t * pMt, int i )
+{
+    return Vec_FltEntry( pMt->vGains, i );
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
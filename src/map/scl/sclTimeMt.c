@@ -0,0 +1,546 @@
+/**CFile****************************************************************
+
+  FileName    [sclTimeMt.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Standard-cell library representation.]
+
+  Synopsis    [Levelized multi-threaded static timing analysis.]
+
+  Author      [Alan Mishchenko, Niklas Een]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - August 24, 2012.]
+
+  Revision    [$Id: sclTimeMt.c,v 1.0 2012/08/24 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include "sclSize.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+// the pool of worker threads shared by the timing engine and the sizing
+// commands; the workers wait for a range of items and call the function
+// given by the main thread; the main thread waits till all ranges are done
+
+typedef struct Scl_PoolTh_t_ Scl_PoolTh_t;
+struct Scl_PoolTh_t_
+{
+    Scl_Pool_t *     pPool;           // the pool
+    int              iThread;         // the thread number
+    volatile int     iStart;          // the first item (-1 to stop)
+    volatile int     iStop;           // the last item (exclusive)
+    volatile int     fWorking;        // the thread is busy
+};
+
+struct Scl_Pool_t_
+{
+    int              nProcs;          // the number of threads
+    Scl_PoolFunc_t   pFunc;           // the function to call
+    void *           pArg;            // the argument of the function
+#ifdef ABC_USE_PTHREADS
+    Scl_PoolTh_t     ThData[SCL_PROC_MAX];
+    pthread_t        WorkerThread[SCL_PROC_MAX];
+#endif
+};
+
+// the timing graph is levelized and stored in the compact form: the objects
+// are sorted by level and the fanins (for arrival times) or the fanouts with
+// the pin numbers (for departure times) of each object are stored in one array
+
+#define SCL_STA_GRAIN 32   // the smallest number of nodes per thread
+
+typedef struct Scl_TimeMt_t_ Scl_TimeMt_t;
+struct Scl_TimeMt_t_
+{
+    SC_Man *         p;               // the sizing manager
+    Vec_Int_t *      vObjs;           // objects sorted by level
+    Vec_Int_t *      vLevStarts;      // the first object of each level
+    Vec_Int_t *      vStarts;         // the first fanin/fanout of each object
+    Vec_Int_t *      vFans;           // fanins or fanout/pin pairs
+    Vec_Int_t *      vFlags;          // the objects whose timing has changed
+    int              iFirst;          // the first object of the current level
+    int              nEstNodes[SCL_PROC_MAX];
+};
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+#ifdef ABC_USE_PTHREADS
+
+/**Function*************************************************************
+
+  Synopsis    [Runs one thread.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void * Abc_SclPoolWorkerThread( void * pArg )
+{
+    Scl_PoolTh_t * pThData = (Scl_PoolTh_t *)pArg;
+    volatile int * pPlace = &pThData->fWorking;
+    while ( 1 )
+    {
+        while ( *pPlace == 0 );
+        assert( pThData->fWorking );
+        if ( pThData->iStart == -1 )
+        {
+            pthread_exit( NULL );
+            assert( 0 );
+            return NULL;
+        }
+        pThData->pPool->pFunc( pThData->pPool->pArg, pThData->iThread, pThData->iStart, pThData->iStop );
+        pThData->fWorking = 0;
+    }
+    assert( 0 );
+    return NULL;
+}
+
+#endif // pthreads are used
+
+/**Function*************************************************************
+
+  Synopsis    [Starts and stops the pool of threads.]
+
+  Description [Returns NULL if the threads are not available.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Scl_Pool_t * Abc_SclPoolStart( int nProcs )
+{
+#ifdef ABC_USE_PTHREADS
+    Scl_Pool_t * p;
+    int i, status;
+    if ( nProcs < 2 )
+        return NULL;
+    p = ABC_CALLOC( Scl_Pool_t, 1 );
+    p->nProcs = Abc_MinInt( nProcs, SCL_PROC_MAX );
+    for ( i = 0; i < p->nProcs; i++ )
+    {
+        p->ThData[i].pPool    = p;
+        p->ThData[i].iThread  = i;
+        p->ThData[i].iStart   = -1;
+        p->ThData[i].fWorking = 0;
+        status = pthread_create( p->WorkerThread + i, NULL, Abc_SclPoolWorkerThread, (void *)(p->ThData + i) );  assert( status == 0 );
+    }
+    return p;
+#else
+    if ( nProcs > 1 )
+        printf( "Multi-threading is not enabled; the computation is performed in one thread.\n" );
+    return NULL;
+#endif
+}
+void Abc_SclPoolStop( Scl_Pool_t * p )
+{
+#ifdef ABC_USE_PTHREADS
+    int i, status;
+    for ( i = 0; i < p->nProcs; i++ )
+    {
+        assert( !p->ThData[i].fWorking );
+        p->ThData[i].iStart   = -1;
+        p->ThData[i].fWorking = 1;
+    }
+    for ( i = 0; i < p->nProcs; i++ )
+    {
+        status = pthread_join( p->WorkerThread[i], NULL );
+        assert( status == 0 );
+    }
+#endif
+    ABC_FREE( p );
+}
+int Abc_SclPoolProcNum( Scl_Pool_t * p )
+{
+    return p ? p->nProcs : 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Applies the function to the range of items.]
+
+  Description [The range is divided into as many parts as there are
+  threads. The ranges with less than nGrain items per thread are processed
+  in the current thread, which is reported to the function as thread 0.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_SclPoolRun( Scl_Pool_t * p, Scl_PoolFunc_t pFunc, void * pArg, int nItems, int nGrain )
+{
+#ifdef ABC_USE_PTHREADS
+    if ( p && nItems >= nGrain * p->nProcs )
+    {
+        int i;
+        p->pFunc = pFunc;
+        p->pArg  = pArg;
+        for ( i = 0; i < p->nProcs; i++ )
+        {
+            p->ThData[i].iStart   = (int)((word)nItems * i / p->nProcs);
+            p->ThData[i].iStop    = (int)((word)nItems * (i+1) / p->nProcs);
+            p->ThData[i].fWorking = 1;
+        }
+        // wait till threads finish
+        for ( i = 0; i < p->nProcs; i++ )
+            if ( p->ThData[i].fWorking )
+                i = -1;
+        return;
+    }
+#endif
+    pFunc( pArg, 0, 0, nItems );
+}
+
+
+/**Function*************************************************************
+
+  Synopsis    [Computes timing of one node.]
+
+  Description [Same as Abc_SclTimeNode() for the internal nodes, except
+  that the loads are not changed, so that the nodes of one level can be
+  processed concurrently. Returns 1 if the buffer tree estimation is used.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Abc_SclTimeNodeArray( SC_Man * p, int iObj, int * pFanins, int nFanins )
+{
+    SC_Cell * pCell = SC_LibCell( p->pLib, Vec_IntEntry(p->pNtk->vGates, iObj) );
+    SC_Pair * pArrOut  = p->pTimes + iObj;
+    SC_Pair * pSlewOut = p->pSlews + iObj;
+    SC_Pair Load = p->pLoads[iObj];
+    float Value = p->EstLoadMax ? Abc_SclObjLoadValue( p, Abc_NtkObj(p->pNtk, iObj) ) : 0;
+    int k;
+    if ( p->EstLoadMax && Value > 1 )
+        Load.rise = Load.fall = p->EstLoadAve * p->EstLoadMax;
+    for ( k = 0; k < nFanins; k++ )
+        Scl_LibPinArrival( Scl_CellPinTime(pCell, k), p->pTimes + pFanins[k], p->pSlews + pFanins[k], &Load, pArrOut, pSlewOut );
+    if ( p->EstLoadMax && Value > 1 )
+    {
+        float EstDelta = p->EstLinear * log( Value );
+        pArrOut->rise += EstDelta;
+        pArrOut->fall += EstDelta;
+        return 1;
+    }
+    return 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes departure time of one object.]
+
+  Description [Collects the contributions of the fanouts, which are given
+  as pairs (fanout, pin), instead of propagating the departure time of each
+  node to its fanins, as done by Abc_SclTimeNode().]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Abc_SclDeptNodeArray( SC_Man * p, int iObj, int * pFanouts, int nFanouts )
+{
+    SC_Pair * pDepIn  = p->pDepts + iObj;
+    SC_Pair * pSlewIn = p->pSlews + iObj;
+    SC_Pair Load, DepOut;
+    float Value, EstDelta;
+    int k, iFanout;
+    for ( k = 0; k < nFanouts; k++ )
+    {
+        iFanout = pFanouts[2*k];
+        Load    = p->pLoads[iFanout];
+        DepOut  = p->pDepts[iFanout];
+        Value   = p->EstLoadMax ? Abc_SclObjLoadValue( p, Abc_NtkObj(p->pNtk, iFanout) ) : 0;
+        if ( p->EstLoadMax && Value > 1 )
+        {
+            Load.rise = Load.fall = p->EstLoadAve * p->EstLoadMax;
+            EstDelta = p->EstLinear * log( Value );
+            DepOut.rise += EstDelta;
+            DepOut.fall += EstDelta;
+        }
+        Scl_LibPinDeparture( Scl_CellPinTime(SC_LibCell(p->pLib, Vec_IntEntry(p->pNtk->vGates, iFanout)), pFanouts[2*k+1]), pDepIn, pSlewIn, &Load, &DepOut );
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Levelizes the timing graph.]
+
+  Description [Collects the CIs and the nodes by level. If fDept is 0,
+  records the fanins of the internal nodes; otherwise, records the internal
+  nodes using each object, together with the pin numbers.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Abc_SclTimeMtLevelize( Scl_TimeMt_t * pSta, int fDept )
+{
+    Abc_Ntk_t * pNtk = pSta->p->pNtk;
+    Vec_Int_t * vLevels = Vec_IntStart( Abc_NtkObjNumMax(pNtk) );
+    Vec_Int_t * vCounts;
+    Abc_Obj_t * pObj, * pFanin;
+    int i, k, Level, LevelMax = 0;
+    // compute levels (the objects are in a topological order)
+    Abc_NtkForEachObj( pNtk, pObj, i )
+    {
+        if ( !Abc_ObjIsNode(pObj) )
+            continue;
+        Level = 0;
+        Abc_ObjForEachFanin( pObj, pFanin, k )
+            Level = Abc_MaxInt( Level, Vec_IntEntry(vLevels, Abc_ObjId(pFanin)) + 1 );
+        Vec_IntWriteEntry( vLevels, i, Level );
+        LevelMax = Abc_MaxInt( LevelMax, Level );
+    }
+    // sort objects by level
+    vCounts = Vec_IntStart( LevelMax + 2 );
+    Abc_NtkForEachObj( pNtk, pObj, i )
+        if ( Abc_ObjIsCi(pObj) || Abc_ObjIsNode(pObj) )
+            Vec_IntAddToEntry( vCounts, Vec_IntEntry(vLevels, i) + 1, 1 );
+    for ( i = 1; i < Vec_IntSize(vCounts); i++ )
+        Vec_IntAddToEntry( vCounts, i, Vec_IntEntry(vCounts, i-1) );
+    Vec_IntClear( pSta->vLevStarts );
+    Vec_IntAppend( pSta->vLevStarts, vCounts );
+    Vec_IntFill( pSta->vObjs, Vec_IntEntryLast(vCounts), 0 );
+    Abc_NtkForEachObj( pNtk, pObj, i )
+        if ( Abc_ObjIsCi(pObj) || Abc_ObjIsNode(pObj) )
+        {
+            Level = Vec_IntEntry( vLevels, i );
+            Vec_IntWriteEntry( pSta->vObjs, Vec_IntEntry(vCounts, Level), i );
+            Vec_IntAddToEntry( vCounts, Level, 1 );
+        }
+    // collect fanins or fanouts
+    Vec_IntClear( pSta->vStarts );
+    Vec_IntClear( pSta->vFans );
+    if ( !fDept )
+    {
+        Vec_IntForEachEntry( pSta->vObjs, i, k )
+        {
+            pObj = Abc_NtkObj( pNtk, i );
+            Vec_IntPush( pSta->vStarts, Vec_IntSize(pSta->vFans) );
+            if ( Abc_ObjIsNode(pObj) )
+                Vec_IntAppend( pSta->vFans, &pObj->vFanins );
+        }
+        Vec_IntPush( pSta->vStarts, Vec_IntSize(pSta->vFans) );
+    }
+    else
+    {
+        // count the internal nodes using each object
+        Vec_IntFill( vLevels, Abc_NtkObjNumMax(pNtk) + 1, 0 );
+        Abc_NtkForEachNode1( pNtk, pObj, i )
+            Abc_ObjForEachFanin( pObj, pFanin, k )
+                Vec_IntAddToEntry( vLevels, Abc_ObjId(pFanin) + 1, 1 );
+        Vec_IntForEachEntry( pSta->vObjs, i, k )
+        {
+            Vec_IntPush( pSta->vStarts, Vec_IntSize(pSta->vFans) );
+            Vec_IntFillExtra( pSta->vFans, Vec_IntSize(pSta->vFans) + 2 * Vec_IntEntry(vLevels, i + 1), 0 );
+        }
+        Vec_IntPush( pSta->vStarts, Vec_IntSize(pSta->vFans) );
+        // remember where each object starts
+        Vec_IntForEachEntry( pSta->vObjs, i, k )
+            Vec_IntWriteEntry( vLevels, i, Vec_IntEntry(pSta->vStarts, k) );
+        Abc_NtkForEachNode1( pNtk, pObj, i )
+            Abc_ObjForEachFanin( pObj, pFanin, k )
+            {
+                int iPlace = Vec_IntEntry( vLevels, Abc_ObjId(pFanin) );
+                Vec_IntWriteEntry( pSta->vFans, iPlace++, i );
+                Vec_IntWriteEntry( pSta->vFans, iPlace++, k );
+                Vec_IntWriteEntry( vLevels, Abc_ObjId(pFanin), iPlace );
+            }
+    }
+    Vec_IntFree( vCounts );
+    Vec_IntFree( vLevels );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes timing of a range of objects of one level.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Abc_SclTimeMtArrivalRange( void * pArg, int iThread, int iStart, int iStop )
+{
+    Scl_TimeMt_t * pSta = (Scl_TimeMt_t *)pArg;
+    SC_Man * p = pSta->p;
+    int * pObjs   = Vec_IntArray( pSta->vObjs );
+    int * pStarts = Vec_IntArray( pSta->vStarts );
+    int * pFans   = Vec_IntArray( pSta->vFans );
+    int i, nEst = 0;
+    iStart += pSta->iFirst;
+    iStop  += pSta->iFirst;
+    for ( i = iStart; i < iStop; i++ )
+        if ( pStarts[i+1] > pStarts[i] ) // skip CIs and constants
+            nEst += Abc_SclTimeNodeArray( p, pObjs[i], pFans + pStarts[i], pStarts[i+1] - pStarts[i] );
+    pSta->nEstNodes[iThread] += nEst;
+}
+static void Abc_SclTimeMtDepartureRange( void * pArg, int iThread, int iStart, int iStop )
+{
+    Scl_TimeMt_t * pSta = (Scl_TimeMt_t *)pArg;
+    SC_Man * p = pSta->p;
+    int * pObjs   = Vec_IntArray( pSta->vObjs );
+    int * pStarts = Vec_IntArray( pSta->vStarts );
+    int * pFans   = Vec_IntArray( pSta->vFans );
+    int i;
+    iStart += pSta->iFirst;
+    iStop  += pSta->iFirst;
+    for ( i = iStart; i < iStop; i++ )
+        Abc_SclDeptNodeArray( p, pObjs[i], pFans + pStarts[i], (pStarts[i+1] - pStarts[i]) / 2 );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes arrival or departure times of the network.]
+
+  Description [Expects the CI arrival times to be computed and the
+  departure times to be cleaned. The objects of each level are processed
+  concurrently; the levels are processed in the topological order for
+  the arrival times and in the reverse order for the departure times.
+  The result is the same as in Abc_SclTimeNtkRecompute().]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_SclTimeNtkRecomputeMt( SC_Man * p, int fDept )
+{
+    Scl_TimeMt_t Sta, * pSta = &Sta;
+    int i, iBeg, iEnd, nLevels;
+    memset( pSta, 0, sizeof(Scl_TimeMt_t) );
+    pSta->p          = p;
+    pSta->vObjs      = Vec_IntAlloc( Abc_NtkObjNumMax(p->pNtk) );
+    pSta->vLevStarts = Vec_IntAlloc( 100 );
+    pSta->vStarts    = Vec_IntAlloc( Abc_NtkObjNumMax(p->pNtk) + 1 );
+    pSta->vFans      = Vec_IntAlloc( 3 * Abc_NtkObjNumMax(p->pNtk) );
+    Abc_SclTimeMtLevelize( pSta, fDept );
+    nLevels = Vec_IntSize(pSta->vLevStarts) - 1;
+    for ( i = 0; i < nLevels; i++ )
+    {
+        int Level = fDept ? nLevels - 1 - i : i;
+        iBeg = Vec_IntEntry( pSta->vLevStarts, Level );
+        iEnd = Vec_IntEntry( pSta->vLevStarts, Level + 1 );
+        pSta->iFirst = iBeg;
+        Abc_SclPoolRun( p->pPool, fDept ? Abc_SclTimeMtDepartureRange : Abc_SclTimeMtArrivalRange, pSta, iEnd - iBeg, SCL_STA_GRAIN );
+    }
+    if ( !fDept )
+        for ( i = 0; i < SCL_PROC_MAX; i++ )
+            p->nEstNodes += pSta->nEstNodes[i];
+    Vec_IntFree( pSta->vObjs );
+    Vec_IntFree( pSta->vLevStarts );
+    Vec_IntFree( pSta->vStarts );
+    Vec_IntFree( pSta->vFans );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Incremental timing update of one level.]
+
+  Description [Recomputes the arrival times (fDept = 0) or the departure
+  times (fDept = 1) of the objects with numbers from iStart to iStop-1 in
+  vLevel, concurrently, and sets the entries of vFlags for the objects whose
+  timing has changed. In the arrival mode, the CIs and the COs are skipped
+  and should be processed by the caller.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Abc_SclTimeIncMtArrivalRange( void * pArg, int iThread, int iStart, int iStop )
+{
+    Scl_TimeMt_t * pSta = (Scl_TimeMt_t *)pArg;
+    SC_Man * p = pSta->p;
+    SC_Pair ArrOut, SlewOut;
+    Abc_Obj_t * pObj;
+    float E = (float)0.1;
+    int i, nEst = 0;
+    iStart += pSta->iFirst;
+    iStop  += pSta->iFirst;
+    for ( i = iStart; i < iStop; i++ )
+    {
+        pObj = Abc_NtkObj( p->pNtk, Vec_IntEntry(pSta->vObjs, i) );
+        if ( !Abc_ObjIsNode(pObj) )
+            continue;
+        SC_PairMove( &ArrOut,  Abc_SclObjTime(p, pObj) );
+        SC_PairMove( &SlewOut, Abc_SclObjSlew(p, pObj) );
+        nEst += Abc_SclTimeNodeArray( p, Abc_ObjId(pObj), Vec_IntArray(&pObj->vFanins), Abc_ObjFaninNum(pObj) );
+        if ( !SC_PairEqualE(&ArrOut, Abc_SclObjTime(p, pObj), E) || !SC_PairEqualE(&SlewOut, Abc_SclObjSlew(p, pObj), E) )
+            Vec_IntWriteEntry( pSta->vFlags, i, 1 );
+    }
+    pSta->nEstNodes[iThread] += nEst;
+}
+static void Abc_SclTimeIncMtDepartureRange( void * pArg, int iThread, int iStart, int iStop )
+{
+    Scl_TimeMt_t * pSta = (Scl_TimeMt_t *)pArg;
+    SC_Man * p = pSta->p;
+    SC_Pair DepOut, * pDepOut;
+    Abc_Obj_t * pObj;
+    float E = (float)0.1;
+    int i;
+    iStart += pSta->iFirst;
+    iStop  += pSta->iFirst;
+    for ( i = iStart; i < iStop; i++ )
+    {
+        pObj = Abc_NtkObj( p->pNtk, Vec_IntEntry(pSta->vObjs, i) );
+        pDepOut = Abc_SclObjDept( p, pObj );
+        SC_PairMove( &DepOut, pDepOut );
+        Abc_SclDeptObj( p, pObj );
+        if ( !SC_PairEqualE(&DepOut, pDepOut, E) )
+            Vec_IntWriteEntry( pSta->vFlags, i, 1 );
+    }
+}
+void Abc_SclTimeIncLevelMt( SC_Man * p, Vec_Int_t * vLevel, int iStart, int iStop, int fDept, Vec_Int_t * vFlags )
+{
+    Scl_TimeMt_t Sta, * pSta = &Sta;
+    int i;
+    memset( pSta, 0, sizeof(Scl_TimeMt_t) );
+    Vec_IntFill( vFlags, Vec_IntSize(vLevel), 0 );
+    pSta->p = p;
+    pSta->vObjs  = vLevel;
+    pSta->vFlags = vFlags;
+    pSta->iFirst = iStart;
+    Abc_SclPoolRun( p->pPool, fDept ? Abc_SclTimeIncMtDepartureRange : Abc_SclTimeIncMtArrivalRange, pSta, iStop - iStart, SCL_STA_GRAIN );
+    if ( !fDept )
+        for ( i = 0; i < SCL_PROC_MAX; i++ )
+            p->nEstNodes += pSta->nEstNodes[i];
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
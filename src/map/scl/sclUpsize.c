@@ -582,6 +582,80 @@ void Abc_SclObjMarkFanFans( Abc_Obj_t * pObj, Vec_Ptr_t * vNodes )
 */
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Evaluates upsizing of the nodes concurrently.]
+
+  Description [Collects the windows of the nodes into batches of
+  non-interfering windows and evaluates each batch using several threads.
+  The nodes are added to the queue in the same order as in the serial
+  computation, so the result does not depend on the number of threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_SclEvalUpsizesMt( SC_Man * p, Vec_Int_t * vPathNodes, Vec_Int_t * vRecalcs, Vec_Int_t * vEvals, int Notches, int iIter, int DelayGap )
+{
+    Vec_Int_t * vCands  = Vec_IntAlloc( Vec_IntSize(vPathNodes) );
+    Vec_Int_t * vLater  = Vec_IntAlloc( Vec_IntSize(vPathNodes) );
+    Vec_Int_t * vBatch  = Vec_IntAlloc( Vec_IntSize(vPathNodes) );
+    Vec_Int_t * vGates  = Vec_IntStartFull( Vec_IntSize(vPathNodes) );
+    Vec_Flt_t * vGains  = Vec_FltStart( Vec_IntSize(vPathNodes) );
+    Abc_Obj_t * pObj;
+    int i, k, iIterLast;
+    // collect the nodes to evaluate
+    Abc_NtkForEachObjVec( vPathNodes, p->pNtk, pObj, i )
+    {
+        assert( pObj->fMarkB == 0 );
+        iIterLast = Vec_IntEntry(p->vNodeIter, Abc_ObjId(pObj));
+        if ( iIterLast >= 0 && iIterLast + 5 > iIter )
+            continue;
+        Vec_IntPush( vCands, i );
+    }
+    // evaluate them in batches of non-interfering windows
+    while ( Vec_IntSize(vCands) > 0 )
+    {
+        Abc_SclSizeMtClear( p->pMt );
+        Vec_IntClear( vLater );
+        Vec_IntClear( vBatch );
+        Vec_IntForEachEntry( vCands, i, k )
+        {
+            pObj = Abc_NtkObj( p->pNtk, Vec_IntEntry(vPathNodes, i) );
+            Abc_SclFindNodesToUpdate( pObj, &vRecalcs, &vEvals, NULL );
+            assert( Vec_IntSize(vEvals) > 0 );
+            if ( Abc_SclSizeMtAddWindow( p->pMt, pObj, vRecalcs, vEvals ) )
+                Vec_IntPush( vBatch, i );
+            else
+                Vec_IntPush( vLater, i );
+        }
+        assert( Vec_IntSize(vBatch) > 0 );
+        Abc_SclSizeMtEvaluate( p->pMt, 0, Notches, DelayGap );
+        Vec_IntForEachEntry( vBatch, i, k )
+        {
+            Vec_IntWriteEntry( vGates, i, Abc_SclSizeMtGate(p->pMt, k) );
+            Vec_FltWriteEntry( vGains, i, Abc_SclSizeMtGain(p->pMt, k) );
+        }
+        ABC_SWAP( Vec_Int_t *, vCands, vLater );
+    }
+    // remember savings
+    Abc_NtkForEachObjVec( vPathNodes, p->pNtk, pObj, i )
+    {
+        if ( Vec_IntEntry(vGates, i) < 0 )
+            continue;
+        assert( Vec_FltEntry(vGains, i) > 0.0 );
+        Vec_FltWriteEntry( p->vNode2Gain, Abc_ObjId(pObj), Vec_FltEntry(vGains, i) );
+        Vec_IntWriteEntry( p->vNode2Gate, Abc_ObjId(pObj), Vec_IntEntry(vGates, i) );
+        Vec_QuePush( p->vNodeByGain, Abc_ObjId(pObj) );
+    }
+    Vec_IntFree( vCands );
+    Vec_IntFree( vLater );
+    Vec_IntFree( vBatch );
+    Vec_IntFree( vGates );
+    Vec_FltFree( vGains );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Computes the set of gates to upsize.]
@@ -606,6 +680,9 @@ int Abc_SclFindUpsizes( SC_Man * p, Vec_Int_t * vPathNodes, int Ratio, int Notch
     vRecalcs = Vec_IntAlloc( 100 );
     vEvals = Vec_IntAlloc( 100 );
     Vec_QueClear( p->vNodeByGain );
+    if ( p->pMt )
+        Abc_SclEvalUpsizesMt( p, vPathNodes, vRecalcs, vEvals, Notches, iIter, DelayGap );
+    else
     Abc_NtkForEachObjVec( vPathNodes, p->pNtk, pObj, i )
     {
         assert( pObj->fMarkB == 0 );
@@ -890,11 +967,13 @@ void Abc_SclUpsizePerformInt( SC_Lib * pLib, Abc_Ntk_t * pNtk, SC_SizePars * pPa
     if ( pPars->Window == 1 )
         pPars->Window += (Abc_NtkNodeNum(pNtk) > 40000);
     // prepare the manager; collect init stats
-    p = Abc_SclManStart( pLib, pNtk, pPars->fUseWireLoads, pPars->fUseDept, 0, pPars->BuffTreeEst );
+    p = Abc_SclManStart( pLib, pNtk, pPars->fUseWireLoads, pPars->fUseDept, 0, pPars->BuffTreeEst, pPars->nProcs );
     p->timeTotal  = Abc_Clock();
     assert( p->vGatesBest == NULL );
     p->vGatesBest = Vec_IntDup( p->pNtk->vGates );
     p->BestDelay  = p->MaxDelay0;
+    if ( p->pPool )
+        p->pMt = Abc_SclSizeMtStart( p );
     // perform upsizing
     nAllPos = nAllNodes = nAllTfos = nAllUpsizes = 0;
     if ( p->BestDelay <= pPars->DelayUser )
@@ -1009,6 +1088,8 @@ void Abc_SclUpsizePerformInt( SC_Lib * pLib, Abc_Ntk_t * pNtk, SC_SizePars * pPa
 
     // save the result and quit
     Abc_SclSclGates2MioGates( pLib, pNtk ); // updates gate pointers
+    if ( p->pMt )
+        Abc_SclSizeMtStop( p->pMt );
     Abc_SclManFree( p );
 //    Abc_NtkCleanMarkAB( pNtk );
 }
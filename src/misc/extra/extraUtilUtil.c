@@ -41,10 +41,11 @@ ABC_NAMESPACE_IMPL_START
  *  Purpose: get option letter from argv.
  */
 
-const char * globalUtilOptarg;        // Global argument pointer (util_optarg)
-int    globalUtilOptind = 0;    // Global argv index (util_optind)
+// the option parser state is per-thread, so that commands can run in several frames concurrently
+ABC_THREAD_LOCAL const char * globalUtilOptarg;        // Global argument pointer (util_optarg)
+ABC_THREAD_LOCAL int    globalUtilOptind = 0;    // Global argv index (util_optind)
 
-static const char *pScanStr;
+static ABC_THREAD_LOCAL const char *pScanStr;
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
@@ -65,6 +65,17 @@
 #endif
 #endif
 
+// thread-local storage (used to give each worker thread its own frame)
+#if !defined(ABC_THREAD_LOCAL)
+#if !defined(ABC_USE_PTHREADS)
+#define ABC_THREAD_LOCAL
+#elif defined(_MSC_VER)
+#define ABC_THREAD_LOCAL __declspec(thread)
+#else
+#define ABC_THREAD_LOCAL __thread
+#endif
+#endif
+
 /*
 #ifdef __cplusplus
 #error "C++ code"
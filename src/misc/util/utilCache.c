@@ -0,0 +1,173 @@
+/**CFile****************************************************************
+
+  FileName    [utilCache.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [On-disk cache file utilities.]
+
+  Synopsis    [Reading and atomic writing of the cache files.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: utilCache.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "abc_global.h"
+#include "utilCache.h"
+
+ABC_NAMESPACE_IMPL_START
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Maps the file into memory.]
+
+  Description [Falls back to reading the file into the buffer, if
+  memory-mapping is not available. The mapping is private and writable,
+  so that the caller may patch the contents in place. Returns NULL if
+  the file cannot be opened or is empty. The contents are released by
+  Util_CacheUnloadFile().]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+char * Util_CacheLoadFile( char * pFileName, size_t * pnSize, int * pfMapped )
+{
+    FILE * pFile;
+    char * pContents;
+    long nFileSize;
+    *pfMapped = 0;
+#ifndef _WIN32
+    {
+        struct stat Stat;
+        int fd = open( pFileName, O_RDONLY );
+        if ( fd == -1 )
+            return NULL;
+        if ( fstat(fd, &Stat) == 0 && Stat.st_size > 0 )
+        {
+            pContents = (char *)mmap( NULL, (size_t)Stat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+            if ( pContents != (char *)MAP_FAILED )
+            {
+#ifdef MADV_SEQUENTIAL
+                madvise( pContents, (size_t)Stat.st_size, MADV_SEQUENTIAL );
+#endif
+                close( fd );
+                *pnSize = (size_t)Stat.st_size;
+                *pfMapped = 1;
+                return pContents;
+            }
+        }
+        close( fd );
+    }
+#endif
+    pFile = fopen( pFileName, "rb" );
+    if ( pFile == NULL )
+        return NULL;
+    fseek( pFile, 0, SEEK_END );
+    nFileSize = ftell( pFile );
+    rewind( pFile );
+    if ( nFileSize <= 0 )
+    {
+        fclose( pFile );
+        return NULL;
+    }
+    pContents = ABC_ALLOC( char, nFileSize );
+    if ( fread( pContents, nFileSize, 1, pFile ) != 1 )
+    {
+        fclose( pFile );
+        ABC_FREE( pContents );
+        return NULL;
+    }
+    fclose( pFile );
+    *pnSize = (size_t)nFileSize;
+    return pContents;
+}
+void Util_CacheUnloadFile( char * pContents, size_t nSize, int fMapped )
+{
+#ifndef _WIN32
+    if ( fMapped )
+    {
+        munmap( pContents, nSize );
+        return;
+    }
+#endif
+    ABC_FREE( pContents );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the cache file atomically.]
+
+  Description [Util_CacheWriteStart() opens a temporary file next to
+  the cache file. Its name is unique for the process and the call, so
+  that concurrent jobs and threads do not share it. Returns NULL if the
+  file cannot be opened. Util_CacheWriteStop() closes the file and, if
+  fSuccess is set and the data was flushed, renames it into the cache
+  file, so that the readers never see a partial entry. Otherwise, the
+  temporary file is removed. The temporary name is freed in both cases.
+  Returns 1 if the cache file was written.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+FILE * Util_CacheWriteStart( char * pFileName, char ** ppTempName )
+{
+    FILE * pFile;
+    char * pTempName = ABC_ALLOC( char, strlen(pFileName) + 40 );
+    sprintf( pTempName, "%s.%d.%u.tmp", pFileName, (int)getpid(), (unsigned)(ABC_PTRUINT_T)pTempName );
+    pFile = fopen( pTempName, "wb" );
+    if ( pFile == NULL )
+    {
+        ABC_FREE( pTempName );
+        return NULL;
+    }
+    *ppTempName = pTempName;
+    return pFile;
+}
+int Util_CacheWriteStop( FILE * pFile, char * pTempName, char * pFileName, int fSuccess )
+{
+    fSuccess &= fclose( pFile ) == 0;
+    if ( fSuccess && rename( pTempName, pFileName ) != 0 )
+        fSuccess = 0;
+    if ( !fSuccess )
+        remove( pTempName );
+    ABC_FREE( pTempName );
+    return fSuccess;
+}
+
+ABC_NAMESPACE_IMPL_END
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,62 @@
+/**CFile****************************************************************
+
+  FileName    [utilCache.h]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [On-disk cache file utilities.]
+
+  Synopsis    [On-disk cache file utilities.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: utilCache.h,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#ifndef ABC__misc__util__utilCache_h
+#define ABC__misc__util__utilCache_h
+
+////////////////////////////////////////////////////////////////////////
+///                          INCLUDES                                ///
+////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stddef.h>
+
+////////////////////////////////////////////////////////////////////////
+///                         PARAMETERS                               ///
+////////////////////////////////////////////////////////////////////////
+
+ABC_NAMESPACE_HEADER_START
+
+////////////////////////////////////////////////////////////////////////
+///                         BASIC TYPES                              ///
+////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////
+///                      MACRO DEFINITIONS                           ///
+////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////
+///                    FUNCTION DECLARATIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/*=== utilCache.c ==========================================================*/
+
+extern char *    Util_CacheLoadFile( char * pFileName, size_t * pnSize, int * pfMapped );
+extern void      Util_CacheUnloadFile( char * pContents, size_t nSize, int fMapped );
+extern FILE *    Util_CacheWriteStart( char * pFileName, char ** ppTempName );
+extern int       Util_CacheWriteStop( FILE * pFile, char * pTempName, char * pFileName, int fSuccess );
+
+ABC_NAMESPACE_HEADER_END
+
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
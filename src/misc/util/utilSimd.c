@@ -0,0 +1,299 @@
+/**CFile****************************************************************
+
+  FileName    [utilSimd.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Vectorized bit-parallel simulation kernels.]
+
+  Synopsis    [AND/XOR/MUX kernels with runtime CPU dispatch.]
+
+  Author      [Alan Mishchenko]
+  
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: utilSimd.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "misc/util/abc_global.h"
+#include "utilSimd.h"
+
+// the vectorized kernels are compiled using function-level target attributes,
+// so that the rest of the code does not depend on the compiler flags
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(ABC_NO_SIMD)
+#define ABC_USE_SIMD_X86
+#include <immintrin.h>
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+// the level of SIMD support: 0 = scalar, 1 = AVX2, 2 = AVX-512
+static int s_SimdLevel = -1;
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Detects the SIMD extensions of the CPU.]
+
+  Description [The environment variable ABC_SIMD (set to 0, 1, or 2)
+  limits the kernels used, which is helpful for comparing them.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_SimdLevel( void )
+{
+    if ( s_SimdLevel == -1 )
+    {
+        int Level = 0;
+        char * pLimit = getenv( "ABC_SIMD" );
+#ifdef ABC_USE_SIMD_X86
+        __builtin_cpu_init();
+        if ( __builtin_cpu_supports("avx512f") )
+            Level = 2;
+        else if ( __builtin_cpu_supports("avx2") )
+            Level = 1;
+#endif
+        if ( pLimit && atoi(pLimit) < Level )
+            Level = Abc_MaxInt( 0, atoi(pLimit) );
+        s_SimdLevel = Level;
+    }
+    return s_SimdLevel;
+}
+char * Abc_SimdName( void )
+{
+    char * pNames[3] = { "scalar", "AVX2", "AVX-512" };
+    return pNames[Abc_SimdLevel()];
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Scalar kernels.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Abc_SimdAndScalar( word * pOut, word * pIn0, word * pIn1, word Mask0, word Mask1, int nWords )
+{
+    int w;
+    for ( w = 0; w < nWords; w++ )
+        pOut[w] = (pIn0[w] ^ Mask0) & (pIn1[w] ^ Mask1);
+}
+static void Abc_SimdXorScalar( word * pOut, word * pIn0, word * pIn1, word Mask, int nWords )
+{
+    int w;
+    for ( w = 0; w < nWords; w++ )
+        pOut[w] = pIn0[w] ^ pIn1[w] ^ Mask;
+}
+static void Abc_SimdMuxScalar( word * pOut, word * pCtrl, word * pIn1, word * pIn0, word MaskC, word Mask1, word Mask0, int nWords )
+{
+    int w;
+    for ( w = 0; w < nWords; w++ )
+        pOut[w] = (pIn0[w] ^ Mask0) ^ ((pCtrl[w] ^ MaskC) & ((pIn0[w] ^ Mask0) ^ (pIn1[w] ^ Mask1)));
+}
+
+#ifdef ABC_USE_SIMD_X86
+
+/**Function*************************************************************
+
+  Synopsis    [AVX2 kernels.]
+
+  Description [Unaligned loads are used because simulation info of
+  a node is not necessarily aligned to the vector size.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+__attribute__((target("avx2")))
+static void Abc_SimdAndAvx2( word * pOut, word * pIn0, word * pIn1, word Mask0, word Mask1, int nWords )
+{
+    __m256i M0 = _mm256_set1_epi64x( (long long)Mask0 );
+    __m256i M1 = _mm256_set1_epi64x( (long long)Mask1 );
+    int w;
+    for ( w = 0; w + 4 <= nWords; w += 4 )
+    {
+        __m256i A = _mm256_loadu_si256( (__m256i const *)(pIn0 + w) );
+        __m256i B = _mm256_loadu_si256( (__m256i const *)(pIn1 + w) );
+        _mm256_storeu_si256( (__m256i *)(pOut + w), _mm256_and_si256(_mm256_xor_si256(A, M0), _mm256_xor_si256(B, M1)) );
+    }
+    for ( ; w < nWords; w++ )
+        pOut[w] = (pIn0[w] ^ Mask0) & (pIn1[w] ^ Mask1);
+}
+__attribute__((target("avx2")))
+static void Abc_SimdXorAvx2( word * pOut, word * pIn0, word * pIn1, word Mask, int nWords )
+{
+    __m256i M = _mm256_set1_epi64x( (long long)Mask );
+    int w;
+    for ( w = 0; w + 4 <= nWords; w += 4 )
+    {
+        __m256i A = _mm256_loadu_si256( (__m256i const *)(pIn0 + w) );
+        __m256i B = _mm256_loadu_si256( (__m256i const *)(pIn1 + w) );
+        _mm256_storeu_si256( (__m256i *)(pOut + w), _mm256_xor_si256(_mm256_xor_si256(A, B), M) );
+    }
+    for ( ; w < nWords; w++ )
+        pOut[w] = pIn0[w] ^ pIn1[w] ^ Mask;
+}
+__attribute__((target("avx2")))
+static void Abc_SimdMuxAvx2( word * pOut, word * pCtrl, word * pIn1, word * pIn0, word MaskC, word Mask1, word Mask0, int nWords )
+{
+    __m256i MC = _mm256_set1_epi64x( (long long)MaskC );
+    __m256i M1 = _mm256_set1_epi64x( (long long)Mask1 );
+    __m256i M0 = _mm256_set1_epi64x( (long long)Mask0 );
+    int w;
+    for ( w = 0; w + 4 <= nWords; w += 4 )
+    {
+        __m256i C = _mm256_xor_si256( _mm256_loadu_si256((__m256i const *)(pCtrl + w)), MC );
+        __m256i A = _mm256_xor_si256( _mm256_loadu_si256((__m256i const *)(pIn1 + w)), M1 );
+        __m256i B = _mm256_xor_si256( _mm256_loadu_si256((__m256i const *)(pIn0 + w)), M0 );
+        _mm256_storeu_si256( (__m256i *)(pOut + w), _mm256_xor_si256(B, _mm256_and_si256(C, _mm256_xor_si256(A, B))) );
+    }
+    for ( ; w < nWords; w++ )
+        pOut[w] = (pIn0[w] ^ Mask0) ^ ((pCtrl[w] ^ MaskC) & ((pIn0[w] ^ Mask0) ^ (pIn1[w] ^ Mask1)));
+}
+
+/**Function*************************************************************
+
+  Synopsis    [AVX-512 kernels.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+__attribute__((target("avx512f")))
+static void Abc_SimdAndAvx512( word * pOut, word * pIn0, word * pIn1, word Mask0, word Mask1, int nWords )
+{
+    __m512i M0 = _mm512_set1_epi64( (long long)Mask0 );
+    __m512i M1 = _mm512_set1_epi64( (long long)Mask1 );
+    int w;
+    for ( w = 0; w + 8 <= nWords; w += 8 )
+    {
+        __m512i A = _mm512_loadu_si512( (void const *)(pIn0 + w) );
+        __m512i B = _mm512_loadu_si512( (void const *)(pIn1 + w) );
+        _mm512_storeu_si512( (void *)(pOut + w), _mm512_and_si512(_mm512_xor_si512(A, M0), _mm512_xor_si512(B, M1)) );
+    }
+    for ( ; w < nWords; w++ )
+        pOut[w] = (pIn0[w] ^ Mask0) & (pIn1[w] ^ Mask1);
+}
+__attribute__((target("avx512f")))
+static void Abc_SimdXorAvx512( word * pOut, word * pIn0, word * pIn1, word Mask, int nWords )
+{
+    __m512i M = _mm512_set1_epi64( (long long)Mask );
+    int w;
+    for ( w = 0; w + 8 <= nWords; w += 8 )
+    {
+        __m512i A = _mm512_loadu_si512( (void const *)(pIn0 + w) );
+        __m512i B = _mm512_loadu_si512( (void const *)(pIn1 + w) );
+        _mm512_storeu_si512( (void *)(pOut + w), _mm512_xor_si512(_mm512_xor_si512(A, B), M) );
+    }
+    for ( ; w < nWords; w++ )
+        pOut[w] = pIn0[w] ^ pIn1[w] ^ Mask;
+}
+__attribute__((target("avx512f")))
+static void Abc_SimdMuxAvx512( word * pOut, word * pCtrl, word * pIn1, word * pIn0, word MaskC, word Mask1, word Mask0, int nWords )
+{
+    __m512i MC = _mm512_set1_epi64( (long long)MaskC );
+    __m512i M1 = _mm512_set1_epi64( (long long)Mask1 );
+    __m512i M0 = _mm512_set1_epi64( (long long)Mask0 );
+    int w;
+    for ( w = 0; w + 8 <= nWords; w += 8 )
+    {
+        __m512i C = _mm512_xor_si512( _mm512_loadu_si512((void const *)(pCtrl + w)), MC );
+        __m512i A = _mm512_xor_si512( _mm512_loadu_si512((void const *)(pIn1 + w)), M1 );
+        __m512i B = _mm512_xor_si512( _mm512_loadu_si512((void const *)(pIn0 + w)), M0 );
+        _mm512_storeu_si512( (void *)(pOut + w), _mm512_xor_si512(B, _mm512_and_si512(C, _mm512_xor_si512(A, B))) );
+    }
+    for ( ; w < nWords; w++ )
+        pOut[w] = (pIn0[w] ^ Mask0) ^ ((pCtrl[w] ^ MaskC) & ((pIn0[w] ^ Mask0) ^ (pIn1[w] ^ Mask1)));
+}
+
+#endif // ABC_USE_SIMD_X86
+
+/**Function*************************************************************
+
+  Synopsis    [Computes AND/XOR/MUX of simulation vectors.]
+
+  Description [The output can be the same as one of the inputs.
+  The AVX-512 kernels process 8 words at a time, so the shorter
+  vectors are processed by the AVX2 kernels.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_SimdAnd( word * pOut, word * pIn0, word * pIn1, int fCompl0, int fCompl1, int nWords )
+{
+    word Mask0 = fCompl0 ? ~(word)0 : 0;
+    word Mask1 = fCompl1 ? ~(word)0 : 0;
+#ifdef ABC_USE_SIMD_X86
+    int Level = Abc_SimdLevel();
+    if ( Level == 2 && nWords >= 8 )
+        Abc_SimdAndAvx512( pOut, pIn0, pIn1, Mask0, Mask1, nWords );
+    else if ( Level >= 1 )
+        Abc_SimdAndAvx2( pOut, pIn0, pIn1, Mask0, Mask1, nWords );
+    else
+#endif
+    Abc_SimdAndScalar( pOut, pIn0, pIn1, Mask0, Mask1, nWords );
+}
+void Abc_SimdXor( word * pOut, word * pIn0, word * pIn1, int fCompl, int nWords )
+{
+    word Mask = fCompl ? ~(word)0 : 0;
+#ifdef ABC_USE_SIMD_X86
+    int Level = Abc_SimdLevel();
+    if ( Level == 2 && nWords >= 8 )
+        Abc_SimdXorAvx512( pOut, pIn0, pIn1, Mask, nWords );
+    else if ( Level >= 1 )
+        Abc_SimdXorAvx2( pOut, pIn0, pIn1, Mask, nWords );
+    else
+#endif
+    Abc_SimdXorScalar( pOut, pIn0, pIn1, Mask, nWords );
+}
+void Abc_SimdMux( word * pOut, word * pCtrl, word * pIn1, word * pIn0, int fComplC, int fCompl1, int fCompl0, int nWords )
+{
+    word MaskC = fComplC ? ~(word)0 : 0;
+    word Mask1 = fCompl1 ? ~(word)0 : 0;
+    word Mask0 = fCompl0 ? ~(word)0 : 0;
+#ifdef ABC_USE_SIMD_X86
+    int Level = Abc_SimdLevel();
+    if ( Level == 2 && nWords >= 8 )
+        Abc_SimdMuxAvx512( pOut, pCtrl, pIn1, pIn0, MaskC, Mask1, Mask0, nWords );
+    else if ( Level >= 1 )
+        Abc_SimdMuxAvx2( pOut, pCtrl, pIn1, pIn0, MaskC, Mask1, Mask0, nWords );
+    else
+#endif
+    Abc_SimdMuxScalar( pOut, pCtrl, pIn1, pIn0, MaskC, Mask1, Mask0, nWords );
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
+
@@ -0,0 +1,65 @@
+/**CFile****************************************************************
+
+  FileName    [utilSimd.h]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Vectorized bit-parallel simulation kernels.]
+
+  Synopsis    [Vectorized bit-parallel simulation kernels.]
+
+  Author      [Alan Mishchenko]
+  
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: utilSimd.h,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+ 
+#ifndef ABC__misc__util__utilSimd_h
+#define ABC__misc__util__utilSimd_h
+
+////////////////////////////////////////////////////////////////////////
+///                          INCLUDES                                ///
+////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////
+///                         PARAMETERS                               ///
+////////////////////////////////////////////////////////////////////////
+
+ABC_NAMESPACE_HEADER_START
+
+// the smallest number of words for which the vectorized kernels are called
+// (one AVX2 vector); shorter simulation info is processed by the inlined
+// scalar loops
+#define ABC_SIMD_WORDS_MIN   4
+
+////////////////////////////////////////////////////////////////////////
+///                         BASIC TYPES                              ///
+////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////
+///                      MACRO DEFINITIONS                           ///
+////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////
+///                    FUNCTION DECLARATIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/*=== utilSimd.c ==========================================================*/
+
+extern int       Abc_SimdLevel( void );
+extern char *    Abc_SimdName( void );
+extern void      Abc_SimdAnd( word * pOut, word * pIn0, word * pIn1, int fCompl0, int fCompl1, int nWords );
+extern void      Abc_SimdXor( word * pOut, word * pIn0, word * pIn1, int fCompl, int nWords );
+extern void      Abc_SimdMux( word * pOut, word * pCtrl, word * pIn1, word * pIn0, int fComplC, int fCompl1, int fCompl0, int nWords );
+
+ABC_NAMESPACE_HEADER_END
+
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
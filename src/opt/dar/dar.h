@@ -83,6 +83,8 @@ struct Dar_RefPar_t_
 /*=== darLib.c ========================================================*/
 extern void            Dar_LibStart();
 extern void            Dar_LibStop();
+extern void            Dar_LibStartThread();
+extern void            Dar_LibStopThread();
 extern void            Dar_LibPrepare( int nSubgraphs );
 extern int             Dar_LibReturnClass( unsigned uTruth );
 /*=== darBalance.c ========================================================*/
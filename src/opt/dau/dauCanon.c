@@ -796,7 +796,7 @@ int Abc_TtCofactorPermNaive( word * pTruth, int i, int nWords, int fSwapOnly )
 {
     if ( fSwapOnly )
     {
-        static word pCopy[1024];
+        word pCopy[1024];
         Abc_TtCopy( pCopy, pTruth, nWords, 0 );
         Abc_TtSwapAdjacent( pCopy, nWords, i );
         if ( Abc_TtCompareRev(pTruth, pCopy, nWords) == 1 )
@@ -807,8 +807,8 @@ int Abc_TtCofactorPermNaive( word * pTruth, int i, int nWords, int fSwapOnly )
         return 0;
     }
     {
-        static word pCopy[1024];
-        static word pBest[1024];
+        word pCopy[1024];
+        word pBest[1024];
         int Config = 0;
         // save two copies
         Abc_TtCopy( pCopy, pTruth, nWords, 0 );
@@ -987,7 +987,7 @@ int Abc_TtCofactorPerm( word * pTruth, int i, int nWords, int fSwapOnly, char *
         return Config;
     }
     {
-        static word pCopy1[1024];
+        word pCopy1[1024];
         int Config;
         Abc_TtCopy( pCopy1, pTruth, nWords, 0 );
         Config = Abc_TtCofactorPermConfig( pTruth, i, nWords, 0, fNaive );
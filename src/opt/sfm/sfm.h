@@ -56,6 +56,7 @@ struct Sfm_Par_t_
     int             nNodesMax;     // the maximum number of nodes to try
     int             iNodeOne;      // one particular node to try
     int             nFirstFixed;   // the number of first nodes to be treated as fixed
+    int             nProcs;        // the number of threads
     int             nTimeWin;      // the size of timing window in percents
     int             DeltaCrit;     // delay delta in picoseconds
     int             DelAreaRatio;  // delay/area tradeoff (how many ps we trade for a unit of area)
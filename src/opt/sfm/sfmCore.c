@@ -21,6 +21,16 @@
 #include "sfmInt.h"
 #include "bool/kit/kit.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 
@@ -28,6 +38,21 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define SFM_PROC_MAX   64
+#define SFM_BATCH_SIZE 64
+
+typedef struct Sfm_ThData_t_ Sfm_ThData_t;
+struct Sfm_ThData_t_
+{
+    Sfm_Ntk_t *       p;           // the copy of the manager used by this thread
+    Vec_Int_t *       vBatch;      // the nodes to try
+    Vec_Int_t *       vUpdates;    // the recorded updates (status, fanin, new fanin, TFO size)
+    Vec_Wrd_t *       vTruths;     // the recorded truth tables
+    Vec_Wec_t *       vWins;       // the window objects of the updated nodes (TFO first)
+    int               iThread;     // the thread number
+    int               nThreads;    // the number of threads
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -52,6 +77,7 @@ void Sfm_ParSetDefault( Sfm_Par_t * pPars )
     pPars->nWinSizeMax  =  300;  // the maximum window size
     pPars->nGrowthLevel =    0;  // the maximum allowed growth in level
     pPars->nBTLimit     = 5000;  // the maximum number of conflicts in one SAT run
+    pPars->nProcs       =    1;  // the number of threads
     pPars->fRrOnly      =    0;  // perform redundancy removal
     pPars->fArea        =    0;  // performs optimization for area
     pPars->fMoreEffort  =    0;  // performs high-affort minimization
@@ -211,6 +237,15 @@ finish:
         p->nResubs++;
     if ( fSkipUpdate )
         return 0;
+    // record the update to be performed later
+    if ( p->fDelayUpdate )
+    {
+        p->iUpdFanin    = f;
+        p->iUpdFaninNew = (iVar == -1 ? iVar : Vec_IntEntry(p->vDivs, iVar));
+        p->uUpdTruth    = uTruth;
+        Abc_TtCopy( p->pUpdTruth, p->pTruth, SFM_WORDS_MAX, 0 );
+        return 1;
+    }
     // update the network
     Sfm_NtkUpdate( p, iNode, f, (iVar == -1 ? iVar : Vec_IntEntry(p->vDivs, iVar)), uTruth, p->pTruth );
     // the number of fanins cannot increase
@@ -277,6 +312,14 @@ p->timeSat += Abc_Clock() - clk;
     p->nImproves++;
     if ( fSkipUpdate )
         return 0;
+    // record the update to be performed later
+    if ( p->fDelayUpdate )
+    {
+        p->iUpdFanin    = -1;
+        p->iUpdFaninNew = -1;
+        p->uUpdTruth    = uTruth;
+        return 1;
+    }
     // update truth table
     Vec_WrdWriteEntry( p->vTruths, iNode, uTruth );
     Sfm_TruthToCnf( uTruth, NULL, Sfm_ObjFaninNum(p, iNode), p->vCover, (Vec_Str_t *)Vec_WecEntry(p->vCnfs, iNode) );
@@ -354,6 +397,243 @@ void Sfm_NtkPrint( Sfm_Ntk_t * p )
     }
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Tries the nodes of the batch assigned to one thread.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void * Sfm_NtkWorkerThread( void * pArg )
+{
+    Sfm_ThData_t * pThData = (Sfm_ThData_t *)pArg;
+    Sfm_Ntk_t * p = pThData->p;
+    int i, iNode, * pUpdate;
+    word * pTruth;
+    for ( i = pThData->iThread; i < Vec_IntSize(pThData->vBatch); i += pThData->nThreads )
+    {
+        iNode   = Vec_IntEntry( pThData->vBatch, i );
+        pUpdate = Vec_IntEntryP( pThData->vUpdates, 4*i );
+        pUpdate[0] = Sfm_NodeResub( p, iNode );
+        if ( pUpdate[0] == 0 )
+            continue;
+        pUpdate[1] = p->iUpdFanin;
+        pUpdate[2] = p->iUpdFaninNew;
+        pUpdate[3] = 1 + Vec_IntSize(p->vTfo);
+        pTruth = Vec_WrdEntryP( pThData->vTruths, (SFM_WORDS_MAX+1)*i );
+        pTruth[0] = p->uUpdTruth;
+        Abc_TtCopy( pTruth + 1, p->pUpdTruth, SFM_WORDS_MAX, 0 );
+        // the node and its TFO are followed by the TFI of the roots and divisors
+        Vec_IntClear( Vec_WecEntry(pThData->vWins, i) );
+        Vec_IntPush( Vec_WecEntry(pThData->vWins, i), iNode );
+        Vec_IntAppend( Vec_WecEntry(pThData->vWins, i), p->vTfo );
+        Vec_IntAppend( Vec_WecEntry(pThData->vWins, i), p->vOrder );
+    }
+    return NULL;
+}
+void Sfm_NtkRunThreads( Sfm_ThData_t * pThData, int nThreads )
+{
+#ifdef ABC_USE_PTHREADS
+    pthread_t WorkerThread[SFM_PROC_MAX];
+    int i, status;
+    for ( i = 0; i < nThreads; i++ )
+    {
+        status = pthread_create( WorkerThread + i, NULL, Sfm_NtkWorkerThread, (void *)(pThData + i) );
+        assert( status == 0 );
+    }
+    for ( i = 0; i < nThreads; i++ )
+    {
+        status = pthread_join( WorkerThread[i], NULL );
+        assert( status == 0 );
+    }
+#else
+    int i;
+    for ( i = 0; i < nThreads; i++ )
+        Sfm_NtkWorkerThread( (void *)(pThData + i) );
+#endif
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs resubstitution using several threads.]
+
+  Description [The nodes are processed in batches of fixed size. The nodes
+  of a batch are tried by the threads, each of which has its own window 
+  and SAT solver, while the network is not modified. The updates are then
+  performed in the order of nodes. An update is skipped, and its node is 
+  tried again in the next batch, if an earlier update of the same batch 
+  changed the fanins or the function of an object in its window, or the 
+  fanouts of the node or its TFO. The updated nodes are also tried again,
+  as in the serial loop. The new nodes of a batch come from different 
+  parts of the network, so their windows are less likely to overlap. 
+  Because the batches do not depend on the number of threads, the result 
+  is the same for any number of threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Sfm_NtkPerformMt( Sfm_Ntk_t * p, int * pCounterLarge )
+{
+    Sfm_ThData_t ThData[SFM_PROC_MAX];
+    int nThreads       = Abc_MinInt( p->pPars->nProcs, SFM_PROC_MAX );
+    Vec_Int_t * vBatch = Vec_IntAlloc( SFM_BATCH_SIZE );
+    Vec_Int_t * vQueue = Vec_IntAlloc( SFM_BATCH_SIZE );
+    Vec_Int_t * vUpdates = Vec_IntStart( 4*SFM_BATCH_SIZE );
+    Vec_Wrd_t * vTruths  = Vec_WrdStart( (SFM_WORDS_MAX+1)*SFM_BATCH_SIZE );
+    Vec_Wec_t * vWins    = Vec_WecStart( SFM_BATCH_SIZE );
+    Vec_Int_t * vStamps  = Vec_IntStart( p->nObjs );
+    Vec_Str_t * vChanged = Vec_StrStart( p->nObjs );
+    int pNext[SFM_BATCH_SIZE], pStop[SFM_BATCH_SIZE], nStripe = (p->nNodes + SFM_BATCH_SIZE - 1) / SFM_BATCH_SIZE;
+    int i, k, n, iNode, iObj, iNext, iStripe = 0, iHead = 0, nBatches = 0, Counter = 0, fStop = 0;
+    word * pTruth;
+    p->vTouched = Vec_IntAlloc( 100 );
+    for ( i = 0; i < nThreads; i++ )
+    {
+        ThData[i].p        = Sfm_NtkStartThread( p );
+        ThData[i].vBatch   = vBatch;
+        ThData[i].vUpdates = vUpdates;
+        ThData[i].vTruths  = vTruths;
+        ThData[i].vWins    = vWins;
+        ThData[i].iThread  = i;
+        ThData[i].nThreads = nThreads;
+    }
+    // the new nodes of a batch are taken from different parts of the network
+    for ( k = 0; k < SFM_BATCH_SIZE; k++ )
+    {
+        pNext[k] = p->nPis + Abc_MinInt( k * nStripe, p->nNodes );
+        pStop[k] = p->nPis + Abc_MinInt( (k + 1) * nStripe, p->nNodes );
+    }
+    while ( !fStop )
+    {
+        // collect the nodes to be tried again, followed by the new nodes
+        Vec_IntClear( vBatch );
+        for ( ; iHead < Vec_IntSize(vQueue) && Vec_IntSize(vBatch) < SFM_BATCH_SIZE; iHead++ )
+        {
+            iObj = Vec_IntEntry( vQueue, iHead );
+            if ( Sfm_ObjFanoutNum(p, iObj) == 0 )
+                continue;
+            if ( p->pPars->nDepthMax && Sfm_ObjLevel(p, iObj) > p->pPars->nDepthMax )
+                continue;
+            if ( Sfm_ObjFaninNum(p, iObj) > SFM_SUPP_MAX )
+                continue;
+            Vec_IntPush( vBatch, iObj );
+        }
+        for ( n = 0; n < SFM_BATCH_SIZE && Vec_IntSize(vBatch) < SFM_BATCH_SIZE; n++, iStripe = (iStripe + 1) % SFM_BATCH_SIZE )
+            while ( pNext[iStripe] < pStop[iStripe] )
+            {
+                iNext = pNext[iStripe]++;
+                if ( Sfm_ObjIsFixed( p, iNext ) )
+                    continue;
+                // skip the nodes removed by the earlier updates
+                if ( Sfm_ObjFanoutNum(p, iNext) == 0 )
+                    continue;
+                if ( p->pPars->nDepthMax && Sfm_ObjLevel(p, iNext) > p->pPars->nDepthMax )
+                    continue;
+                if ( Sfm_ObjFaninNum(p, iNext) > SFM_SUPP_MAX )
+                {
+                    (*pCounterLarge)++;
+                    continue;
+                }
+                Vec_IntPush( vBatch, iNext );
+                break;
+            }
+        if ( Vec_IntSize(vBatch) == 0 )
+            break;
+        if ( iHead == Vec_IntSize(vQueue) )
+        {
+            Vec_IntClear( vQueue );
+            iHead = 0;
+        }
+        // try the nodes while the network is not modified
+        Sfm_NtkRunThreads( ThData, nThreads );
+        // perform the updates in the order of nodes
+        nBatches++;
+        Vec_IntForEachEntry( vBatch, iNode, i )
+        {
+            int * pUpdate = Vec_IntEntryP( vUpdates, 4*i );
+            if ( pUpdate[0] == 0 )
+                continue;
+            Vec_IntForEachEntry( Vec_WecEntry(vWins, i), iObj, k )
+                if ( Vec_IntEntry(vStamps, iObj) == 2*nBatches+1 || (k < pUpdate[3] && Vec_IntEntry(vStamps, iObj) == 2*nBatches) )
+                    break;
+            if ( k < Vec_IntSize(Vec_WecEntry(vWins, i)) )
+            {
+                Vec_IntPush( vQueue, iNode );
+                continue;
+            }
+            pTruth = Vec_WrdEntryP( vTruths, (SFM_WORDS_MAX+1)*i );
+            Vec_IntClear( p->vTouched );
+            if ( pUpdate[1] == -1 )
+            {
+                p->nImproves++;
+                Vec_WrdWriteEntry( p->vTruths, iNode, pTruth[0] );
+                Sfm_TruthToCnf( pTruth[0], NULL, Sfm_ObjFaninNum(p, iNode), p->vCover, (Vec_Str_t *)Vec_WecEntry(p->vCnfs, iNode) );
+                Vec_IntPush( p->vTouched, iNode );
+            }
+            else
+            {
+                if ( pUpdate[2] == -1 )
+                    p->nRemoves++;
+                else
+                    p->nResubs++;
+                Sfm_NtkUpdate( p, iNode, pUpdate[1], pUpdate[2], pTruth[0], pTruth + 1 );
+            }
+            // mark the objects whose fanins or function changed (the updated node and 
+            // the removed nodes) and those objects whose only fanouts changed
+            Vec_IntForEachEntry( p->vTouched, iObj, k )
+                if ( iObj == iNode || (Sfm_ObjIsNode(p, iObj) && Sfm_ObjFanoutNum(p, iObj) == 0) )
+                    Vec_IntWriteEntry( vStamps, iObj, 2*nBatches+1 );
+                else if ( Vec_IntEntry(vStamps, iObj) != 2*nBatches+1 )
+                    Vec_IntWriteEntry( vStamps, iObj, 2*nBatches );
+            // the updated node is tried again
+            Vec_IntPush( vQueue, iNode );
+            if ( !Vec_StrEntry(vChanged, iNode) )
+            {
+                Vec_StrWriteEntry( vChanged, iNode, 1 );
+                Counter++;
+            }
+            if ( p->pPars->nNodesMax && Counter >= p->pPars->nNodesMax )
+            {
+                fStop = 1;
+                break;
+            }
+        }
+    }
+    // collect statistics
+    for ( i = 0; i < nThreads; i++ )
+    {
+        Sfm_Ntk_t * pThr = ThData[i].p;
+        p->nTryRemoves  += pThr->nTryRemoves;
+        p->nTryImproves += pThr->nTryImproves;
+        p->nTryResubs   += pThr->nTryResubs;
+        p->nNodesTried  += pThr->nNodesTried;
+        p->nTotalDivs   += pThr->nTotalDivs;
+        p->nSatCalls    += pThr->nSatCalls;
+        p->nTimeOuts    += pThr->nTimeOuts;
+        p->nMaxDivs     += pThr->nMaxDivs;
+        p->timeWin      += pThr->timeWin;
+        p->timeDiv      += pThr->timeDiv;
+        p->timeCnf      += pThr->timeCnf;
+        p->timeSat      += pThr->timeSat;
+        Sfm_NtkStopThread( pThr );
+    }
+    Vec_IntFreeP( &p->vTouched );
+    Vec_IntFree( vBatch );
+    Vec_IntFree( vQueue );
+    Vec_IntFree( vUpdates );
+    Vec_WrdFree( vTruths );
+    Vec_WecFree( vWins );
+    Vec_IntFree( vStamps );
+    Vec_StrFree( vChanged );
+    return Counter;
+}
+
 /**Function*************************************************************
 
   Synopsis    []
@@ -383,6 +663,9 @@ int Sfm_NtkPerform( Sfm_Ntk_t * p, Sfm_Par_t * pPars )
 //    return 0;
     p->nTotalNodesBeg = Vec_WecSizeUsedLimits( &p->vFanins, Sfm_NtkPiNum(p), Vec_WecSize(&p->vFanins) - Sfm_NtkPoNum(p) );
     p->nTotalEdgesBeg = Vec_WecSizeSize(&p->vFanins) - Sfm_NtkPoNum(p);
+    if ( pPars->nProcs > 1 && !pPars->fVeryVerbose )
+        Counter = Sfm_NtkPerformMt( p, &CounterLarge );
+    else
     Sfm_NtkForEachNode( p, i )
     {
         if ( Sfm_ObjIsFixed( p, i ) )
@@ -255,6 +255,81 @@ void Sfm_NtkFree( Sfm_Ntk_t * p )
     ABC_FREE( p );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Starts the copy of the manager used by one thread.]
+
+  Description [The copy shares the network (fanins, fanouts, levels, 
+  truth tables, CNFs) with the original manager, which should not be
+  modified while the copy is in use. The traversal data, the window, 
+  the SAT solver, and the parameters are private. The copy records 
+  the updates instead of performing them.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Sfm_Ntk_t * Sfm_NtkStartThread( Sfm_Ntk_t * p )
+{
+    Sfm_Ntk_t * pNew; int i;
+    pNew = ABC_ALLOC( Sfm_Ntk_t, 1 );
+    memcpy( pNew, p, sizeof(Sfm_Ntk_t) );
+    pNew->pPars = ABC_ALLOC( Sfm_Par_t, 1 );
+    memcpy( pNew->pPars, p->pPars, sizeof(Sfm_Par_t) );
+    // traversal data
+    Vec_IntZero( &pNew->vCounts );
+    Vec_IntZero( &pNew->vTravIds );
+    Vec_IntZero( &pNew->vTravIds2 );
+    Vec_IntZero( &pNew->vId2Var );
+    Vec_IntZero( &pNew->vVar2Id );
+    Vec_IntFill( &pNew->vCounts,   p->nObjs,  0 );
+    Vec_IntFill( &pNew->vTravIds,  p->nObjs,  0 );
+    Vec_IntFill( &pNew->vTravIds2, p->nObjs,  0 );
+    Vec_IntFill( &pNew->vId2Var,   2*p->nObjs, -1 );
+    Vec_IntFill( &pNew->vVar2Id,   2*p->nObjs, -1 );
+    pNew->nTravIds  = 0;
+    pNew->nTravIds2 = 0;
+    pNew->vCover    = Vec_IntAlloc( 1 << 16 );
+    pNew->vTouched  = NULL;
+    // window and SAT solver
+    Sfm_NtkPrepare( pNew );
+    pNew->nLevelMax = p->nLevelMax;
+    for ( i = 0; i < SFM_FANIN_MAX; i++ )
+        pNew->pTtElems[i] = pNew->TtElems[i];
+    pNew->fDelayUpdate = 1;
+    // statistics
+    pNew->nTryRemoves = pNew->nTryImproves = pNew->nTryResubs = 0;
+    pNew->nRemoves = pNew->nImproves = pNew->nResubs = 0;
+    pNew->nNodesTried = pNew->nTotalDivs = pNew->nSatCalls = pNew->nTimeOuts = pNew->nMaxDivs = 0;
+    pNew->timeWin = pNew->timeDiv = pNew->timeCnf = pNew->timeSat = pNew->timeOther = pNew->timeTotal = 0;
+    return pNew;
+}
+void Sfm_NtkStopThread( Sfm_Ntk_t * p )
+{
+    ABC_FREE( p->vCounts.pArray );
+    ABC_FREE( p->vTravIds.pArray );
+    ABC_FREE( p->vTravIds2.pArray );
+    ABC_FREE( p->vId2Var.pArray );
+    ABC_FREE( p->vVar2Id.pArray );
+    Vec_IntFree( p->vCover );
+    Vec_IntFreeP( &p->vNodes );
+    Vec_IntFreeP( &p->vDivs  );
+    Vec_IntFreeP( &p->vRoots );
+    Vec_IntFreeP( &p->vTfo   );
+    Vec_WrdFreeP( &p->vDivCexes );
+    Vec_IntFreeP( &p->vOrder );
+    Vec_IntFreeP( &p->vDivVars );
+    Vec_IntFreeP( &p->vDivIds );
+    Vec_IntFreeP( &p->vLits  );
+    Vec_IntFreeP( &p->vValues );
+    Vec_WecFreeP( &p->vClauses );
+    Vec_IntFreeP( &p->vFaninMap );
+    if ( p->pSat  ) sat_solver_delete( p->pSat );
+    ABC_FREE( p->pPars );
+    ABC_FREE( p );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Performs resubstitution for the node.]
@@ -293,9 +368,13 @@ void Sfm_NtkDeleteObj_rec( Sfm_Ntk_t * p, int iNode )
     if ( Sfm_ObjFanoutNum(p, iNode) > 0 || Sfm_ObjIsPi(p, iNode) || Sfm_ObjIsFixed(p, iNode) )
         return;
     assert( Sfm_ObjIsNode(p, iNode) );
+    if ( p->vTouched )
+        Vec_IntPush( p->vTouched, iNode );
     Sfm_ObjForEachFanin( p, iNode, iFanin, i )
     {
         int RetValue = Vec_IntRemove( Sfm_ObjFoArray(p, iFanin), iNode );  assert( RetValue );
+        if ( p->vTouched )
+            Vec_IntPush( p->vTouched, iFanin );
         Sfm_NtkDeleteObj_rec( p, iFanin );
     }
     Vec_IntClear( Sfm_ObjFiArray(p, iNode) );
@@ -328,6 +407,14 @@ void Sfm_NtkUpdate( Sfm_Ntk_t * p, int iNode, int f, int iFaninNew, word uTruth,
     assert( Sfm_ObjIsNode(p, iNode) );
     assert( iFanin != iFaninNew );
     assert( Sfm_ObjFaninNum(p, iNode) <= SFM_FANIN_MAX );
+    // remember the objects whose fanins or fanouts are changed
+    if ( p->vTouched )
+    {
+        Vec_IntPush( p->vTouched, iNode );
+        Vec_IntAppend( p->vTouched, Sfm_ObjFiArray(p, iNode) );
+        if ( iFaninNew != -1 )
+            Vec_IntPush( p->vTouched, iFaninNew );
+    }
     if ( Abc_TtIsConst0(pTruth, nWords) || Abc_TtIsConst1(pTruth, nWords) )
     {
         Sfm_ObjForEachFanin( p, iNode, iFanin, f )
@@ -53,6 +53,7 @@ struct Cec_ParSat_t_
 //    int              fFirstStop;    // stop on the first sat output
     int              fLearnCls;     // perform clause learning
     int              fSaveCexes;    // saves counter-examples
+    int              fNoProgress;   // disables the progress bar
     int              fVerbose;      // verbose stats
 };
 
@@ -108,6 +109,7 @@ struct Cec_ParFra_t_
     int              nCallsRecycle; // calls to perform before recycling SAT solver
     int              nSatVarMax;    // the max number of SAT variables
     int              nGenIters;     // pattern generation iterations
+    int              nProcs;        // the number of concurrent threads
     int              fRewriting;    // enables AIG rewriting
     int              fCheckMiter;   // the circuit is the miter
 //    int              fFirstStop;    // stop on the first sat output
@@ -198,6 +200,20 @@ struct Cec_ParSeq_t_
     int              fVerbose;      // verbose stats
 };
 
+// portfolio model checking parameters
+typedef struct Cec_ParPmc_t_ Cec_ParPmc_t;
+struct Cec_ParPmc_t_
+{
+    int              nTimeOut;      // timeout in seconds
+    int              fUseBmc;       // runs bmc3
+    int              fUsePdr;       // runs pdr
+    int              fUseInt;       // runs interpolation
+    int              fUseScorr;     // runs pdr after scorr
+    int              fSolveAll;     // does not stop at the first SAT output
+    int              fVerbose;      // verbose stats
+    Vec_Int_t *      vOutMap;       // output statuses (0 = sat; 1 = unsat; -1 = undecided)
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                      MACRO DEFINITIONS                           ///
 ////////////////////////////////////////////////////////////////////////
@@ -227,6 +243,9 @@ extern void          Cec_ManChcSetDefaultParams( Cec_ParChc_t * p );
 extern Gia_Man_t *   Cec_ManSatSweeping( Gia_Man_t * pAig, Cec_ParFra_t * pPars, int fSilent );
 extern Gia_Man_t *   Cec_ManSatSolving( Gia_Man_t * pAig, Cec_ParSat_t * pPars, int f0Proved );
 extern void          Cec_ManSimulation( Gia_Man_t * pAig, Cec_ParSim_t * pPars );
+/*=== cecPmc.c ==========================================================*/
+extern void          Cec_ManPmcSetDefaultParams( Cec_ParPmc_t * p );
+extern int           Cec_ManPmcPerform( Gia_Man_t * p, Cec_ParPmc_t * pPars );
 /*=== cecSeq.c ==========================================================*/
 extern int           Cec_ManSeqResimulateCounter( Gia_Man_t * pAig, Cec_ParSim_t * pPars, Abc_Cex_t * pCex );
 extern int           Cec_ManSeqSemiformal( Gia_Man_t * pAig, Cec_ParSmf_t * pPars );
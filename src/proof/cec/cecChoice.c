@@ -412,11 +412,11 @@ Aig_Man_t * Cec_ComputeChoices( Gia_Man_t * pGia, Dch_Pars_t * pPars )
   SeeAlso     []
 
 ***********************************************************************/
-Aig_Man_t * Cec_ComputeChoicesNew( Gia_Man_t * pGia, int nConfs, int fVerbose )
+Aig_Man_t * Cec_ComputeChoicesNew( Gia_Man_t * pGia, int nConfs, int nProcs, int fVerbose )
 {
-    extern void Cec4_ManSimulateTest2( Gia_Man_t * p, int nConfs, int fVerbose );
+    extern void Cec4_ManSimulateTest2( Gia_Man_t * p, int nConfs, int nProcs, int fVerbose );
     Aig_Man_t * pAig;
-    Cec4_ManSimulateTest2( pGia, nConfs, fVerbose );
+    Cec4_ManSimulateTest2( pGia, nConfs, nProcs, fVerbose );
     pGia = Gia_ManEquivToChoices( pGia, 3 );
     pAig = Gia_ManToAig( pGia, 1 );
     Gia_ManStop( pGia );
@@ -20,6 +20,16 @@
 
 #include "cecInt.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 
@@ -27,6 +37,20 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define CEC_CORR_PROC_MAX 64
+
+// the outputs of the speculatively reduced model are divided into
+// contiguous groups solved by the threads on their own copies
+typedef struct Cec_CorrThData_t_ Cec_CorrThData_t;
+struct Cec_CorrThData_t_
+{
+    Gia_Man_t *      p;              // the outputs of this thread
+    Cec_ParCor_t *   pPars;          // correspondence parameters
+    Cec_ParSat_t *   pParsSat;       // SAT solver parameters
+    Vec_Int_t *      vCexStore;      // counter-examples
+    Vec_Str_t *      vStatus;        // the status of each output
+};
+
 static void Gia_ManCorrSpecReduce_rec( Gia_Man_t * pNew, Gia_Man_t * p, Gia_Obj_t * pObj, int f, int nPrefix );
 
 ////////////////////////////////////////////////////////////////////////
@@ -910,6 +934,110 @@ int Cec_ManLSCorrAnalyzeDependence( Gia_Man_t * p, Vec_Int_t * vEquivs, Vec_Str_
     return 0;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Solves the outputs of the speculatively reduced model.]
+
+  Description [With several threads, the outputs are divided into
+  contiguous groups, each group is copied with all the primary inputs
+  and solved by its own solver. The statuses and the counter-examples
+  are merged in the order of the outputs, so the result does not depend
+  on thread scheduling. It may depend on the number of threads because
+  the solvers and the counter-examples they return differ with the way
+  the outputs are grouped.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Cec_ManCorrSolveMiterOne( Cec_CorrThData_t * pTh )
+{
+    if ( pTh->pPars->fUseCSat )
+        pTh->vCexStore = Cbs_ManSolveMiterNc( pTh->p, pTh->pPars->nBTLimit, &pTh->vStatus, 0, 0 );
+    else
+        pTh->vCexStore = Cec_ManSatSolveMiter( pTh->p, pTh->pParsSat, &pTh->vStatus );
+}
+#ifdef ABC_USE_PTHREADS
+static void * Cec_ManCorrWorkerThread( void * pArg )
+{
+    Cec_ManCorrSolveMiterOne( (Cec_CorrThData_t *)pArg );
+    pthread_exit( NULL );
+    return NULL;
+}
+#endif
+Vec_Int_t * Cec_ManCorrSolveMiter( Gia_Man_t * pSrm, Cec_ParCor_t * pPars, Cec_ParSat_t * pParsSat, Vec_Str_t ** pvStatus )
+{
+    Cec_CorrThData_t ThData[CEC_CORR_PROC_MAX];
+    Cec_ParSat_t ParsSatTh;
+    Vec_Int_t * vCexStore, * vOuts;
+    Vec_Str_t * vStatus;
+    int nProcs = Abc_MinInt( pPars->nProcs, CEC_CORR_PROC_MAX );
+    int nOuts  = Gia_ManPoNum( pSrm );
+    int i, k, iStart, iStop, Entry, nLits;
+#ifndef ABC_USE_PTHREADS
+    nProcs = 1;
+#endif
+    if ( nProcs < 2 || nOuts < 4 * nProcs )
+    {
+        ThData[0].p        = pSrm;
+        ThData[0].pPars    = pPars;
+        ThData[0].pParsSat = pParsSat;
+        Cec_ManCorrSolveMiterOne( ThData );
+        *pvStatus = ThData[0].vStatus;
+        return ThData[0].vCexStore;
+    }
+    // the workers do not share the progress bar
+    ParsSatTh = *pParsSat;
+    ParsSatTh.fNoProgress = 1;
+    // divide the outputs
+    vOuts = Vec_IntStartNatural( nOuts );
+    for ( k = 0; k < nProcs; k++ )
+    {
+        iStart = k * nOuts / nProcs;
+        iStop  = (k + 1) * nOuts / nProcs;
+        ThData[k].p        = Gia_ManDupCones( pSrm, Vec_IntArray(vOuts) + iStart, iStop - iStart, 0 );
+        ThData[k].pPars    = pPars;
+        ThData[k].pParsSat = &ParsSatTh;
+        assert( Gia_ManPiNum(ThData[k].p) == Gia_ManPiNum(pSrm) );
+    }
+    Vec_IntFree( vOuts );
+#ifdef ABC_USE_PTHREADS
+    {
+        pthread_t WorkerThread[CEC_CORR_PROC_MAX];
+        for ( k = 0; k < nProcs; k++ )
+        {
+            int status = pthread_create( WorkerThread + k, NULL, Cec_ManCorrWorkerThread, (void *)(ThData + k) );
+            assert( status == 0 );
+        }
+        for ( k = 0; k < nProcs; k++ )
+            pthread_join( WorkerThread[k], NULL );
+    }
+#endif
+    // merge the results in the order of the outputs
+    vStatus   = Vec_StrAlloc( nOuts );
+    vCexStore = Vec_IntAlloc( 10000 );
+    for ( k = 0; k < nProcs; k++ )
+    {
+        iStart = k * nOuts / nProcs;
+        for ( i = 0; i < Vec_StrSize(ThData[k].vStatus); i++ )
+            Vec_StrPush( vStatus, Vec_StrEntry(ThData[k].vStatus, i) );
+        for ( i = 0; i < Vec_IntSize(ThData[k].vCexStore); )
+        {
+            Vec_IntPush( vCexStore, iStart + Vec_IntEntry(ThData[k].vCexStore, i++) );
+            Vec_IntPush( vCexStore, nLits = Vec_IntEntry(ThData[k].vCexStore, i++) );
+            for ( Entry = 0; Entry < nLits; Entry++ )
+                Vec_IntPush( vCexStore, Vec_IntEntry(ThData[k].vCexStore, i++) );
+        }
+        Vec_StrFree( ThData[k].vStatus );
+        Vec_IntFree( ThData[k].vCexStore );
+        Gia_ManStop( ThData[k].p );
+    }
+    assert( Vec_StrSize(vStatus) == nOuts );
+    *pvStatus = vStatus;
+    return vCexStore;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Internal procedure for register correspondence.]
@@ -1010,10 +1138,7 @@ int Cec_ManLSCorrespondenceClasses( Gia_Man_t * pAig, Cec_ParCor_t * pPars )
 //Gia_DumpAiger( pSrm, "corrsrm", r, 2 );
         // found counter-examples to speculation
         clk2 = Abc_Clock();
-        if ( pPars->fUseCSat )
-            vCexStore = Cbs_ManSolveMiterNc( pSrm, pPars->nBTLimit, &vStatus, 0, 0 );
-        else
-            vCexStore = Cec_ManSatSolveMiter( pSrm, pParsSat, &vStatus );
+        vCexStore = Cec_ManCorrSolveMiter( pSrm, pPars, pParsSat, &vStatus );
         Gia_ManStop( pSrm );
         clkSat += Abc_Clock() - clk2;
         if ( Vec_IntSize(vCexStore) == 0 )
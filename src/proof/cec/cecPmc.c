@@ -0,0 +1,482 @@
+/**CFile****************************************************************
+
+  FileName    [cecPmc.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Combinational equivalence checking.]
+
+  Synopsis    [Portfolio of concurrent model checking engines.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: cecPmc.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include "cecInt.h"
+#include "aig/gia/giaAig.h"
+#include "aig/saig/saig.h"
+#include "sat/bmc/bmc.h"
+#include "proof/pdr/pdr.h"
+#include "proof/int/int.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+#define PMC_ENGINE_NUM 4
+
+enum { PMC_BMC = 0, PMC_PDR, PMC_INT, PMC_SCORR };
+
+static char * s_PmcEngineNames[PMC_ENGINE_NUM] = { "bmc3", "pdr", "int", "scorr+pdr" };
+
+// shared state of the portfolio
+typedef struct Pmc_Man_t_ Pmc_Man_t;
+struct Pmc_Man_t_
+{
+    Gia_Man_t *      pGia;          // the design
+    Cec_ParPmc_t *   pPars;         // parameters
+    Vec_Int_t *      vStatus;       // output statuses (0 = sat; 1 = unsat; -1 = undecided)
+    Vec_Int_t *      vEngine;       // the engine that solved each output
+    Vec_Ptr_t *      vCexes;        // counter-examples of the failed outputs
+    int              nSolved;       // the number of solved outputs
+    volatile int     fStop;         // the engines should stop
+    abctime          clkStart;      // starting time
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_t  Mutex;         // mutex to control access to shared variables
+#endif
+};
+
+// information given to the thread
+typedef struct Pmc_ThData_t_
+{
+    Pmc_Man_t *      p;             // shared state
+    Aig_Man_t *      pAig;          // private copy of the design
+    Gia_Man_t *      pGia;          // private copy of the design (scorr only)
+    int              iEngine;       // the engine to run
+    int              nTimeOut;      // timeout in seconds
+    int              RetValue;      // the result
+} Pmc_ThData_t;
+
+// the portfolio of the engine running in this thread
+static ABC_THREAD_LOCAL Pmc_Man_t * s_pPmc = NULL;
+
+#ifdef ABC_USE_PTHREADS
+static inline void Pmc_ManLock( Pmc_Man_t * p )   { int status = pthread_mutex_lock(&p->Mutex);   assert( status == 0 ); (void)status; }
+static inline void Pmc_ManUnlock( Pmc_Man_t * p ) { int status = pthread_mutex_unlock(&p->Mutex); assert( status == 0 ); (void)status; }
+#else
+static inline void Pmc_ManLock( Pmc_Man_t * p )   {}
+static inline void Pmc_ManUnlock( Pmc_Man_t * p ) {}
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Exchanges the results between the engines.]
+
+  Description [An output solved by one engine is recorded once, under
+  the mutex, and is skipped by other engines using their callbacks.
+  Counter-examples are checked on the original design before they are
+  accepted. When all outputs are solved, or when an output fails and
+  not all outputs are to be solved, the stop flag is raised, which
+  cancels the remaining engines through their stop callbacks.
+  The callbacks take only integer arguments, so they find the portfolio
+  through a thread-local pointer set by the thread running the engine.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Pmc_ManRecordOutput( Pmc_Man_t * p, int iOut, int Status, Abc_Cex_t * pCex, int iEngine )
+{
+    int fRecorded = 0;
+    assert( Status == 0 || Status == 1 );
+    Pmc_ManLock( p );
+    if ( Vec_IntEntry(p->vStatus, iOut) == -1 )
+    {
+        if ( Status == 0 )
+        {
+            if ( pCex != NULL )
+            {
+                pCex = Abc_CexDup( pCex, -1 );
+                pCex->iPo = iOut;
+            }
+            if ( pCex != NULL && Gia_ManVerifyCex(p->pGia, pCex, 0) )
+                Vec_PtrWriteEntry( p->vCexes, iOut, pCex );
+            else
+            {
+                Abc_CexFreeP( &pCex );
+                Status = -1;
+            }
+        }
+        if ( Status >= 0 )
+        {
+            Vec_IntWriteEntry( p->vStatus, iOut, Status );
+            Vec_IntWriteEntry( p->vEngine, iOut, iEngine );
+            if ( p->pPars->fVerbose )
+            {
+                Abc_Print( 1, "Output %d was %s by %s.  ", iOut, Status ? "proved" : "disproved", s_PmcEngineNames[iEngine] );
+                Abc_PrintTime( 1, "Time", Abc_Clock() - p->clkStart );
+            }
+            if ( ++p->nSolved == Vec_IntSize(p->vStatus) || (Status == 0 && !p->pPars->fSolveAll) )
+                p->fStop = 1;
+            fRecorded = 1;
+        }
+    }
+    Pmc_ManUnlock( p );
+    return fRecorded;
+}
+int Pmc_ManCallBackToStop( int RunId )
+{
+    return s_pPmc->fStop;
+}
+int Pmc_ManCallBackIsSolved( int iOut )
+{
+    int Status;
+    Pmc_ManLock( s_pPmc );
+    Status = Vec_IntEntry( s_pPmc->vStatus, iOut );
+    Pmc_ManUnlock( s_pPmc );
+    return Status >= 0;
+}
+int Pmc_ManCallBackOnFailBmc( int iOut, Abc_Cex_t * pCex )
+{
+    Pmc_ManRecordOutput( s_pPmc, iOut, 0, pCex, PMC_BMC );
+    return 0;
+}
+int Pmc_ManCallBackOnFailPdr( int iOut, Abc_Cex_t * pCex )
+{
+    Pmc_ManRecordOutput( s_pPmc, iOut, 0, pCex, PMC_PDR );
+    return 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs one engine.]
+
+  Description [Each engine works on a private copy of the design.
+  For a single output, bmc3 also proves the property when all reachable
+  states of a small design are visited. In the multi-output mode, bmc3
+  and PDR report the failed outputs through the callbacks and skip the
+  outputs solved by other engines.
+  Interpolation works on one output at a time and skips the solved ones.
+  The scorr-based engine reduces the design using the inductive
+  equivalences and runs PDR on the result; since the reduced design
+  is only equivalent under reachable states, it contributes proofs
+  but not counter-examples.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Pmc_ManRunPdr( Pmc_ThData_t * pThData, Aig_Man_t * pAig, int fUseCexes, int nTimeOut )
+{
+    Pmc_Man_t * p = pThData->p;
+    Pdr_Par_t Pars, * pPars = &Pars;
+    int i, Status, RetValue, fMultiOut = Saig_ManPoNum(pAig) > 1;
+    Pdr_ManSetDefaultParams( pPars );
+    pPars->nTimeOut      = nTimeOut;
+    pPars->fSolveAll     = fMultiOut;
+    pPars->fStoreCex     = fUseCexes;
+    pPars->fSilent       = 1;
+    pPars->fNotVerbose   = 1;
+    pPars->fSkipSetInv   = 1;
+    pPars->pFuncStop     = Pmc_ManCallBackToStop;
+    pPars->pFuncIsSolved = fMultiOut ? Pmc_ManCallBackIsSolved : NULL;
+    pPars->pFuncOnFail   = fMultiOut && fUseCexes ? Pmc_ManCallBackOnFailPdr : NULL;
+    RetValue = Pdr_ManSolve( pAig, pPars );
+    if ( fMultiOut )
+    {
+        if ( pPars->vOutMap )
+            Vec_IntForEachEntry( pPars->vOutMap, Status, i )
+                if ( Status == 1 )
+                    Pmc_ManRecordOutput( p, i, 1, NULL, pThData->iEngine );
+        Vec_IntFreeP( &pPars->vOutMap );
+    }
+    else if ( RetValue == 1 )
+        Pmc_ManRecordOutput( p, 0, 1, NULL, pThData->iEngine );
+    else if ( RetValue == 0 && fUseCexes )
+        Pmc_ManRecordOutput( p, 0, 0, pAig->pSeqModel, pThData->iEngine );
+    return RetValue;
+}
+int Pmc_ManRunBmc( Pmc_ThData_t * pThData )
+{
+    Pmc_Man_t * p = pThData->p;
+    Aig_Man_t * pAig = pThData->pAig;
+    Saig_ParBmc_t Pars, * pPars = &Pars;
+    int RetValue, fMultiOut = Saig_ManPoNum(pAig) > 1;
+    Saig_ParBmcSetDefaultParams( pPars );
+    pPars->nTimeOut      = pThData->nTimeOut;
+    pPars->fSolveAll     = fMultiOut;
+    pPars->fStoreCex     = 1;
+    pPars->fSilent       = 1;
+    pPars->fNotVerbose   = 1;
+    pPars->pFuncStop     = Pmc_ManCallBackToStop;
+    pPars->pFuncIsSolved = fMultiOut ? Pmc_ManCallBackIsSolved : NULL;
+    pPars->pFuncOnFail   = fMultiOut ? Pmc_ManCallBackOnFailBmc : NULL;
+    RetValue = Saig_ManBmcScalable( pAig, pPars );
+    if ( !fMultiOut && RetValue == 0 )
+        Pmc_ManRecordOutput( p, 0, 0, pAig->pSeqModel, PMC_BMC );
+    else if ( !fMultiOut && RetValue == 1 ) // all reachable states are visited
+        Pmc_ManRecordOutput( p, 0, 1, NULL, PMC_BMC );
+    return RetValue;
+}
+int Pmc_ManRunInt( Pmc_ThData_t * pThData )
+{
+    Pmc_Man_t * p = pThData->p;
+    Inter_ManParams_t Pars, * pPars = &Pars;
+    Aig_Man_t * pAigOne;
+    int i, iFrame, RetValue = -1, nFails = 0, nProved = 0;
+    if ( Saig_ManPiNum(pThData->pAig) == 0 )
+        return -1;
+    for ( i = 0; i < Saig_ManPoNum(pThData->pAig); i++ )
+    {
+        if ( p->fStop )
+            break;
+        if ( Pmc_ManCallBackIsSolved(i) )
+            continue;
+        if ( pThData->nTimeOut && Abc_Clock() > p->clkStart + pThData->nTimeOut * CLOCKS_PER_SEC )
+            break;
+        Inter_ManSetDefaultParams( pPars );
+        pPars->nSecLimit = pThData->nTimeOut ? Abc_MaxInt( 1, pThData->nTimeOut - (int)((Abc_Clock() - p->clkStart) / CLOCKS_PER_SEC) ) : 0;
+        pPars->pFuncStop = Pmc_ManCallBackToStop;
+        pAigOne = Saig_ManPoNum(pThData->pAig) == 1 ? pThData->pAig : Aig_ManDupOneOutput( pThData->pAig, i, 1 );
+        RetValue = Inter_ManPerformInterpolation( pAigOne, pPars, &iFrame );
+        if ( RetValue == 1 )
+            nProved += Pmc_ManRecordOutput( p, i, 1, NULL, PMC_INT );
+        else if ( RetValue == 0 )
+            nFails += Pmc_ManRecordOutput( p, i, 0, pAigOne->pSeqModel, PMC_INT );
+        if ( pAigOne != pThData->pAig )
+            Aig_ManStop( pAigOne );
+    }
+    return nFails ? 0 : nProved == Saig_ManPoNum(pThData->pAig) ? 1 : -1;
+}
+int Pmc_ManRunScorr( Pmc_ThData_t * pThData )
+{
+    Pmc_Man_t * p = pThData->p;
+    Cec_ParCor_t Pars, * pPars = &Pars;
+    Gia_Man_t * pReduced;
+    Aig_Man_t * pAig;
+    int i, RetValue, nTimeLeft = 0, nProved = 0;
+    Cec_ManCorSetDefaultParams( pPars );
+    pReduced = Cec_ManLSCorrespondence( pThData->pGia, pPars );
+    if ( pReduced == NULL || p->fStop )
+    {
+        if ( pReduced ) Gia_ManStop( pReduced );
+        return -1;
+    }
+    if ( pThData->nTimeOut )
+    {
+        nTimeLeft = pThData->nTimeOut - (int)((Abc_Clock() - p->clkStart) / CLOCKS_PER_SEC);
+        if ( nTimeLeft <= 0 )
+        {
+            Gia_ManStop( pReduced );
+            return -1;
+        }
+    }
+    if ( p->pPars->fVerbose )
+    {
+        Abc_Print( 1, "Engine %s reduced the design from %d to %d flops and from %d to %d nodes.  ",
+            s_PmcEngineNames[PMC_SCORR], Gia_ManRegNum(pThData->pGia), Gia_ManRegNum(pReduced), Gia_ManAndNum(pThData->pGia), Gia_ManAndNum(pReduced) );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - p->clkStart );
+    }
+    // the outputs reduced to constant 0 are proved by scorr
+    for ( i = 0; i < Gia_ManPoNum(pReduced); i++ )
+        if ( Gia_ObjFaninLit0p(pReduced, Gia_ManPo(pReduced, i)) == 0 )
+            nProved += Pmc_ManRecordOutput( p, i, 1, NULL, PMC_SCORR );
+    if ( nProved == Gia_ManPoNum(pReduced) )
+    {
+        Gia_ManStop( pReduced );
+        return 1;
+    }
+    pAig = Gia_ManToAigSimple( pReduced );
+    Gia_ManStop( pReduced );
+    RetValue = Pmc_ManRunPdr( pThData, pAig, 0, nTimeLeft );
+    Aig_ManStop( pAig );
+    return RetValue;
+}
+void Pmc_ManRunEngine( Pmc_ThData_t * pThData )
+{
+    abctime clk = Abc_Clock();
+    s_pPmc = pThData->p;
+    if ( pThData->iEngine == PMC_BMC )
+        pThData->RetValue = Pmc_ManRunBmc( pThData );
+    else if ( pThData->iEngine == PMC_PDR )
+        pThData->RetValue = Pmc_ManRunPdr( pThData, pThData->pAig, 1, pThData->nTimeOut );
+    else if ( pThData->iEngine == PMC_INT )
+        pThData->RetValue = Pmc_ManRunInt( pThData );
+    else if ( pThData->iEngine == PMC_SCORR )
+        pThData->RetValue = Pmc_ManRunScorr( pThData );
+    else assert( 0 );
+    s_pPmc = NULL;
+    if ( pThData->p->pPars->fVerbose )
+    {
+        Abc_Print( 1, "Engine %-9s finished with status %2d.  ", s_PmcEngineNames[pThData->iEngine], pThData->RetValue );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    }
+}
+#ifdef ABC_USE_PTHREADS
+void * Pmc_ManWorkerThread( void * pArg )
+{
+    Pmc_ManRunEngine( (Pmc_ThData_t *)pArg );
+    pthread_exit( NULL );
+    assert( 0 );
+    return NULL;
+}
+#endif
+
+/**Function*************************************************************
+
+  Synopsis    [Runs the portfolio of model checking engines.]
+
+  Description [Returns 1 if all outputs are proved, 0 if an output
+  failed, and -1 if undecided. The per-output statuses are returned
+  in pPars->vOutMap. For a single-output design, the counter-example
+  is saved in p->pCexSeq; otherwise, the counter-examples of the failed
+  outputs are saved in p->vSeqModelVec. Without pthreads, the engines
+  are run one after another, each with the full timeout.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Cec_ManPmcSetDefaultParams( Cec_ParPmc_t * p )
+{
+    memset( p, 0, sizeof(Cec_ParPmc_t) );
+    p->nTimeOut       =       0;  // timeout in seconds
+    p->fUseBmc        =       1;  // runs bmc3
+    p->fUsePdr        =       1;  // runs pdr
+    p->fUseInt        =       1;  // runs interpolation
+    p->fUseScorr      =       1;  // runs pdr after scorr
+    p->fSolveAll      =       0;  // does not stop at the first SAT output
+    p->fVerbose       =       0;  // verbose stats
+}
+int Cec_ManPmcPerform( Gia_Man_t * pGia, Cec_ParPmc_t * pPars )
+{
+    Pmc_ThData_t ThData[PMC_ENGINE_NUM];
+    int fUseEngine[PMC_ENGINE_NUM] = { pPars->fUseBmc, pPars->fUsePdr, pPars->fUseInt, pPars->fUseScorr };
+    Pmc_Man_t Man, * p = &Man;
+    int i, nEngines = 0, RetValue = -1;
+    assert( Gia_ManRegNum(pGia) > 0 );
+    // interpolation does not support constraints
+    if ( Gia_ManConstrNum(pGia) )
+        fUseEngine[PMC_INT] = 0;
+    // start the shared state
+    memset( p, 0, sizeof(Pmc_Man_t) );
+    p->pGia     = pGia;
+    p->pPars    = pPars;
+    p->vStatus  = Vec_IntStartFull( Gia_ManPoNum(pGia) );
+    p->vEngine  = Vec_IntStartFull( Gia_ManPoNum(pGia) );
+    p->vCexes   = Vec_PtrStart( Gia_ManPoNum(pGia) );
+    p->clkStart = Abc_Clock();
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_init( &p->Mutex, NULL );
+#endif
+    // prepare private copies of the design
+    for ( i = 0; i < PMC_ENGINE_NUM; i++ )
+    {
+        if ( !fUseEngine[i] )
+            continue;
+        memset( ThData + nEngines, 0, sizeof(Pmc_ThData_t) );
+        ThData[nEngines].p        = p;
+        ThData[nEngines].iEngine  = i;
+        ThData[nEngines].nTimeOut = pPars->nTimeOut;
+        ThData[nEngines].RetValue = -1;
+        if ( i == PMC_SCORR )
+            ThData[nEngines].pGia = Gia_ManDup( pGia );
+        else
+        {
+            ThData[nEngines].pAig = Gia_ManToAigSimple( pGia );
+            ThData[nEngines].pAig->nConstrs = pGia->nConstrs;
+        }
+        nEngines++;
+    }
+    if ( pPars->fVerbose )
+    {
+        Abc_Print( 1, "Running %d engines (", nEngines );
+        for ( i = 0; i < nEngines; i++ )
+            Abc_Print( 1, "%s%s", i ? ", " : "", s_PmcEngineNames[ThData[i].iEngine] );
+        Abc_Print( 1, ") on %d outputs with timeout %d sec.\n", Gia_ManPoNum(pGia), pPars->nTimeOut );
+    }
+#ifdef ABC_USE_PTHREADS
+    if ( nEngines > 1 )
+    {
+        pthread_t WorkerThread[PMC_ENGINE_NUM];
+        for ( i = 0; i < nEngines; i++ )
+        {
+            int status = pthread_create( WorkerThread + i, NULL, Pmc_ManWorkerThread, (void *)(ThData + i) );
+            assert( status == 0 );
+        }
+        for ( i = 0; i < nEngines; i++ )
+            pthread_join( WorkerThread[i], NULL );
+    }
+    else
+#endif
+    for ( i = 0; i < nEngines; i++ )
+        if ( !p->fStop )
+            Pmc_ManRunEngine( ThData + i );
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_destroy( &p->Mutex );
+#endif
+    for ( i = 0; i < nEngines; i++ )
+    {
+        if ( ThData[i].pAig ) Aig_ManStop( ThData[i].pAig );
+        if ( ThData[i].pGia ) Gia_ManStop( ThData[i].pGia );
+    }
+    // derive the result
+    if ( Vec_IntFind(p->vStatus, 0) >= 0 )
+        RetValue = 0;
+    else if ( p->nSolved == Gia_ManPoNum(pGia) )
+        RetValue = 1;
+    Abc_CexFreeP( &pGia->pCexSeq );
+    if ( pGia->vSeqModelVec )
+        Vec_PtrFreeFree( pGia->vSeqModelVec ), pGia->vSeqModelVec = NULL;
+    if ( Gia_ManPoNum(pGia) == 1 )
+    {
+        pGia->pCexSeq = (Abc_Cex_t *)Vec_PtrEntry( p->vCexes, 0 );
+        Vec_PtrFree( p->vCexes );
+    }
+    else
+        pGia->vSeqModelVec = p->vCexes;
+    Vec_IntFreeP( &pPars->vOutMap );
+    pPars->vOutMap = p->vStatus;
+    if ( pPars->fVerbose )
+    {
+        Abc_Print( 1, "Solved outputs by engine:" );
+        for ( i = 0; i < PMC_ENGINE_NUM; i++ )
+            Abc_Print( 1, "  %s = %d", s_PmcEngineNames[i], Vec_IntCountEntry(p->vEngine, i) );
+        Abc_Print( 1, "\n" );
+    }
+    Vec_IntFree( p->vEngine );
+    return RetValue;
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
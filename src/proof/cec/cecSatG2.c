@@ -20,6 +20,8 @@
 
 #include "aig/gia/gia.h"
 #include "misc/util/utilTruth.h"
+#include "misc/util/utilSimd.h"
+#include "misc/vec/vecHash.h"
 #include "cec.h"
 
 #define USE_GLUCOSE2
@@ -74,6 +76,16 @@
 
 #endif
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 
@@ -81,6 +93,8 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define CEC4_PROC_MAX 100
+
 // SAT solving manager
 typedef struct Cec4_Man_t_ Cec4_Man_t;
 struct Cec4_Man_t_
@@ -102,6 +116,7 @@ struct Cec4_Man_t_
     Vec_Bit_t *      vFails;
     Vec_Bit_t *      vCoDrivers;
     Vec_Int_t *      vPairs;   
+    Vec_Int_t *      vProvedMt;      // class representatives proved by the threads
     int              iPosRead;       // candidate reading position
     int              iPosWrite;      // candidate writing position
     int              iLastConst;     // last const node proved
@@ -307,6 +322,7 @@ void Cec4_ManDestroy( Cec4_Man_t * p )
     Vec_IntFreeP( &p->vDisprPairs );
     Vec_BitFreeP( &p->vFails );
     Vec_IntFreeP( &p->vPairs );
+    Vec_IntFreeP( &p->vProvedMt );
     Vec_BitFreeP( &p->vCoDrivers );
     Vec_IntFreeP( &p->vRefClasses );
     Vec_IntFreeP( &p->vRefNodes );
@@ -846,7 +862,9 @@ static inline void Cec4_ObjSimAnd( Gia_Man_t * p, int iObj )
     word * pSim  = Cec4_ObjSim( p, iObj );
     word * pSim0 = Cec4_ObjSim( p, Gia_ObjFaninId0(pObj, iObj) );
     word * pSim1 = Cec4_ObjSim( p, Gia_ObjFaninId1(pObj, iObj) );
-    if ( Gia_ObjFaninC0(pObj) && Gia_ObjFaninC1(pObj) )
+    if ( p->nSimWords >= ABC_SIMD_WORDS_MIN )
+        Abc_SimdAnd( pSim, pSim0, pSim1, Gia_ObjFaninC0(pObj), Gia_ObjFaninC1(pObj), p->nSimWords );
+    else if ( Gia_ObjFaninC0(pObj) && Gia_ObjFaninC1(pObj) )
         for ( w = 0; w < p->nSimWords; w++ )
             pSim[w] = ~pSim0[w] & ~pSim1[w];
     else if ( Gia_ObjFaninC0(pObj) && !Gia_ObjFaninC1(pObj) )
@@ -866,7 +884,9 @@ static inline void Cec4_ObjSimXor( Gia_Man_t * p, int iObj )
     word * pSim  = Cec4_ObjSim( p, iObj );
     word * pSim0 = Cec4_ObjSim( p, Gia_ObjFaninId0(pObj, iObj) );
     word * pSim1 = Cec4_ObjSim( p, Gia_ObjFaninId1(pObj, iObj) );
-    if ( Gia_ObjFaninC0(pObj) ^ Gia_ObjFaninC1(pObj) )
+    if ( p->nSimWords >= ABC_SIMD_WORDS_MIN )
+        Abc_SimdXor( pSim, pSim0, pSim1, Gia_ObjFaninC0(pObj) ^ Gia_ObjFaninC1(pObj), p->nSimWords );
+    else if ( Gia_ObjFaninC0(pObj) ^ Gia_ObjFaninC1(pObj) )
         for ( w = 0; w < p->nSimWords; w++ )
             pSim[w] = ~pSim0[w] ^ pSim1[w];
     else
@@ -1712,6 +1732,401 @@ int Cec4_ManSweepNode( Cec4_Man_t * p, int iObj, int iRepr )
     }
     return RetValue;
 }
+
+/**Function*************************************************************
+
+  Synopsis    [Multi-threaded solving of candidate equivalences.]
+
+  Description [Before the main sweep, candidate pairs are solved level 
+  by level. The pairs of one level are grouped by class, and each class 
+  goes to one of several threads. Each thread owns a SAT solver and loads 
+  the structurally hashed cones of the user's AIG into it on demand. 
+  Nodes proved at lower levels are replaced by their representatives, 
+  so most pairs are resolved structurally and the windows stay small. 
+  The main thread merges the results in the thread 
+  order: proved pairs are recorded in vProvedMt and merged by the sweep 
+  without calling the solver, while counter-examples are added to the 
+  simulation info and used to refine the classes.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+typedef struct Cec4_ThData_t_ Cec4_ThData_t;
+struct Cec4_ThData_t_
+{
+    Gia_Man_t *      p;              // user's AIG (read-only while threads run)
+    Cec_ParFra_t *   pPars;          // parameters
+    Vec_Int_t *      vProved;        // representatives proved in earlier levels
+    sat_solver *     pSat;           // SAT solver of this thread
+    Hash_IntMan_t *  pHash;          // structural hashing of the window
+    Vec_Int_t *      vHashLits;      // SAT literals of the hashed gates
+    Vec_Int_t *      vSatLits;       // mapping of AIG objects into SAT literals
+    Vec_Int_t *      vWindow;        // AIG objects loaded into the solver
+    Vec_Int_t *      vStamps;        // traversal stamps
+    Vec_Int_t *      vPairs;         // candidate pairs (iRepr, iObj)
+    Vec_Int_t *      vStatus;        // solver status for each pair
+    Vec_Int_t *      vCexes;         // CI literals of counter-examples separated by -1
+    int              nStamp;         // current traversal stamp
+    int              nCallsSince;    // calls since the last recycling
+    int              nWindowMax;     // the number of gates triggering recycling
+};
+
+int Cec4_ThObjSatLit_rec( Cec4_ThData_t * pTh, int iObj )
+{
+    Gia_Obj_t * pObj;
+    int iLit = Vec_IntEntry( pTh->vSatLits, iObj ), iRepr, iLit0, iLit1, iVar;
+    if ( iLit >= 0 )
+        return iLit;
+    pObj  = Gia_ManObj( pTh->p, iObj );
+    iRepr = Vec_IntEntry( pTh->vProved, iObj );
+    if ( iRepr >= 0 ) // use the representative instead of the cone
+    {
+        iLit = Cec4_ThObjSatLit_rec( pTh, iRepr );
+        iLit = Abc_LitNotCond( iLit, pObj->fPhase ^ Gia_ManObj(pTh->p, iRepr)->fPhase );
+    }
+    else if ( Gia_ObjIsAnd(pObj) )
+    {
+        int fXor = Gia_ObjIsXor(pObj), fCompl = 0, iEntry;
+        iLit0 = Abc_LitNotCond( Cec4_ThObjSatLit_rec(pTh, Gia_ObjFaninId0(pObj, iObj)), Gia_ObjFaninC0(pObj) );
+        iLit1 = Abc_LitNotCond( Cec4_ThObjSatLit_rec(pTh, Gia_ObjFaninId1(pObj, iObj)), Gia_ObjFaninC1(pObj) );
+        // structurally hash the gates in the window
+        if ( fXor )
+        {
+            fCompl = Abc_LitIsCompl(iLit0) ^ Abc_LitIsCompl(iLit1);
+            iLit0  = Abc_LitRegular( iLit0 );
+            iLit1  = Abc_LitRegular( iLit1 );
+        }
+        if ( iLit0 > iLit1 )
+            iLit0 ^= iLit1, iLit1 ^= iLit0, iLit0 ^= iLit1;
+        iEntry = Hsh_Int3ManInsert( pTh->pHash, iLit0, iLit1, fXor );
+        if ( iEntry == Vec_IntSize(pTh->vHashLits) )
+        {
+            iVar = sat_solver_addvar( pTh->pSat );
+            if ( fXor )
+                sat_solver_add_xor( pTh->pSat, iVar, Abc_Lit2Var(iLit0), Abc_Lit2Var(iLit1), 0 );
+            else
+                sat_solver_add_and( pTh->pSat, iVar, Abc_Lit2Var(iLit0), Abc_Lit2Var(iLit1), Abc_LitIsCompl(iLit0), Abc_LitIsCompl(iLit1), 0 );
+            Vec_IntPush( pTh->vHashLits, Abc_Var2Lit(iVar, 0) );
+        }
+        iLit = Abc_LitNotCond( Vec_IntEntry(pTh->vHashLits, iEntry), fCompl );
+    }
+    else
+    {
+        assert( iObj == 0 || Gia_ObjIsCi(pObj) );
+        iLit = Abc_Var2Lit( sat_solver_addvar(pTh->pSat), 0 );
+        if ( iObj == 0 )
+        {
+            int Lit = Abc_LitNot( iLit );
+            sat_solver_addclause( pTh->pSat, &Lit, 1 );
+        }
+    }
+    Vec_IntWriteEntry( pTh->vSatLits, iObj, iLit );
+    Vec_IntPush( pTh->vWindow, iObj );
+    return iLit;
+}
+void Cec4_ThCollectCex_rec( Cec4_ThData_t * pTh, int iObj )
+{
+    Gia_Obj_t * pObj;
+    if ( Vec_IntEntry(pTh->vStamps, iObj) == pTh->nStamp )
+        return;
+    Vec_IntWriteEntry( pTh->vStamps, iObj, pTh->nStamp );
+    if ( Vec_IntEntry(pTh->vSatLits, iObj) < 0 ) // not in the window
+        return;
+    pObj = Gia_ManObj( pTh->p, iObj );
+    if ( Gia_ObjIsCi(pObj) )
+    {
+        int iLit = Vec_IntEntry( pTh->vSatLits, iObj );
+        int Value = sat_solver_read_cex_varvalue( pTh->pSat, Abc_Lit2Var(iLit) ) ^ Abc_LitIsCompl(iLit);
+        Vec_IntPush( pTh->vCexes, Abc_Var2Lit(iObj, Value) );
+        return;
+    }
+    if ( Vec_IntEntry(pTh->vProved, iObj) >= 0 )
+        Cec4_ThCollectCex_rec( pTh, Vec_IntEntry(pTh->vProved, iObj) );
+    if ( !Gia_ObjIsAnd(pObj) )
+        return;
+    Cec4_ThCollectCex_rec( pTh, Gia_ObjFaninId0(pObj, iObj) );
+    Cec4_ThCollectCex_rec( pTh, Gia_ObjFaninId1(pObj, iObj) );
+}
+void Cec4_ThSolverRecycle( Cec4_ThData_t * pTh )
+{
+    int i, iObj;
+    pTh->nCallsSince = 0;
+    sat_solver_reset( pTh->pSat );
+    Hash_IntManStop( pTh->pHash );
+    pTh->pHash = Hash_IntManStart( 1000 );
+    Vec_IntFill( pTh->vHashLits, 1, -1 );
+    Vec_IntForEachEntry( pTh->vWindow, iObj, i )
+        Vec_IntWriteEntry( pTh->vSatLits, iObj, -1 );
+    Vec_IntClear( pTh->vWindow );
+}
+int Cec4_ThObjFaninLit( Cec4_ThData_t * pTh, Gia_Obj_t * pObj, int iObj, int n )
+{
+    int iFan  = n ? Gia_ObjFaninId1(pObj, iObj) : Gia_ObjFaninId0(pObj, iObj);
+    int iLit  = Abc_Var2Lit( iFan, n ? Gia_ObjFaninC1(pObj) : Gia_ObjFaninC0(pObj) );
+    int iRepr = Vec_IntEntry( pTh->vProved, iFan );
+    if ( iRepr == -1 )
+        return iLit;
+    return Abc_Var2Lit( iRepr, Abc_LitIsCompl(iLit) ^ Gia_ManObj(pTh->p, iFan)->fPhase ^ Gia_ManObj(pTh->p, iRepr)->fPhase );
+}
+int Cec4_ThObjStructEqual( Cec4_ThData_t * pTh, int iRepr, int iObj )
+{
+    Gia_Obj_t * pObj  = Gia_ManObj( pTh->p, iObj );
+    Gia_Obj_t * pRepr = Gia_ManObj( pTh->p, iRepr );
+    int Lits0[2], Lits1[2];
+    if ( !Gia_ObjIsAnd(pObj) || !Gia_ObjIsAnd(pRepr) || Gia_ObjIsXor(pObj) != Gia_ObjIsXor(pRepr) )
+        return 0;
+    Lits0[0] = Cec4_ThObjFaninLit( pTh, pRepr, iRepr, 0 );
+    Lits0[1] = Cec4_ThObjFaninLit( pTh, pRepr, iRepr, 1 );
+    Lits1[0] = Cec4_ThObjFaninLit( pTh, pObj,  iObj,  0 );
+    Lits1[1] = Cec4_ThObjFaninLit( pTh, pObj,  iObj,  1 );
+    if ( Gia_ObjIsXor(pObj) )
+    {
+        int fCompl = Abc_LitIsCompl(Lits0[0]) ^ Abc_LitIsCompl(Lits0[1]) ^ Abc_LitIsCompl(Lits1[0]) ^ Abc_LitIsCompl(Lits1[1]);
+        if ( fCompl != (pObj->fPhase ^ pRepr->fPhase) )
+            return 0;
+        Lits0[0] = Abc_LitRegular(Lits0[0]), Lits0[1] = Abc_LitRegular(Lits0[1]);
+        Lits1[0] = Abc_LitRegular(Lits1[0]), Lits1[1] = Abc_LitRegular(Lits1[1]);
+    }
+    else if ( pObj->fPhase != pRepr->fPhase )
+        return 0;
+    return (Lits0[0] == Lits1[0] && Lits0[1] == Lits1[1]) || (Lits0[0] == Lits1[1] && Lits0[1] == Lits1[0]);
+}
+int Cec4_ThSolvePair( Cec4_ThData_t * pTh, int iRepr, int iObj )
+{
+    Gia_Obj_t * pObj  = Gia_ManObj( pTh->p, iObj );
+    Gia_Obj_t * pRepr = Gia_ManObj( pTh->p, iRepr );
+    int status, iLit0, iLit1, Lits[2];
+    assert( iRepr < iObj );
+    if ( Cec4_ThObjStructEqual(pTh, iRepr, iObj) )
+        return GLUCOSE_UNSAT;
+    if ( ++pTh->nCallsSince > pTh->pPars->nCallsRecycle && 
+         Vec_IntSize(pTh->vHashLits) > pTh->nWindowMax && pTh->pPars->nSatVarMax )
+        Cec4_ThSolverRecycle( pTh );
+    iLit0 = Cec4_ThObjSatLit_rec( pTh, iRepr );
+    iLit1 = Abc_LitNotCond( Cec4_ThObjSatLit_rec(pTh, iObj), pObj->fPhase ^ pRepr->fPhase );
+    if ( iLit0 == iLit1 )
+        return GLUCOSE_UNSAT;
+    Lits[0] = Abc_LitNot( iLit0 );
+    Lits[1] = iLit1;
+    sat_solver_set_conflict_budget( pTh->pSat, pTh->pPars->nBTLimit );
+    status = sat_solver_solve( pTh->pSat, Lits, 2 );
+    if ( status == GLUCOSE_UNSAT && iRepr > 0 )
+    {
+        Lits[0] = iLit0;
+        Lits[1] = Abc_LitNot( iLit1 );
+        sat_solver_set_conflict_budget( pTh->pSat, pTh->pPars->nBTLimit );
+        status = sat_solver_solve( pTh->pSat, Lits, 2 );
+    }
+    if ( status == GLUCOSE_UNSAT && iRepr > 0 ) // record the equivalence for the later calls
+    {
+        Lits[0] = Abc_LitNot( iLit0 ); 
+        Lits[1] = iLit1;
+        sat_solver_addclause( pTh->pSat, Lits, 2 );
+        Lits[0] = iLit0; 
+        Lits[1] = Abc_LitNot( iLit1 );
+        sat_solver_addclause( pTh->pSat, Lits, 2 );
+    }
+    else if ( status == GLUCOSE_SAT )
+    {
+        pTh->nStamp++;
+        Cec4_ThCollectCex_rec( pTh, iRepr );
+        Cec4_ThCollectCex_rec( pTh, iObj );
+        Vec_IntPush( pTh->vCexes, -1 );
+    }
+    return status;
+}
+void Cec4_ThSolvePairs( Cec4_ThData_t * pTh )
+{
+    int i, iRepr, iObj;
+    Vec_IntClear( pTh->vStatus );
+    Vec_IntClear( pTh->vCexes );
+    Vec_IntForEachEntryDouble( pTh->vPairs, iRepr, iObj, i )
+        Vec_IntPush( pTh->vStatus, Cec4_ThSolvePair(pTh, iRepr, iObj) );
+}
+#ifdef ABC_USE_PTHREADS
+void * Cec4_WorkerThread( void * pArg )
+{
+    Cec4_ThSolvePairs( (Cec4_ThData_t *)pArg );
+    pthread_exit( NULL );
+    return NULL;
+}
+#endif
+void Cec4_ManResimulate( Gia_Man_t * p, Cec4_Man_t * pMan )
+{
+    abctime clk = Abc_Clock();
+    Cec4_ManSimulate( p, pMan );
+    Vec_IntFill( pMan->vCexStamps, Gia_ManObjNum(p), 0 );
+    p->iPatsPi = 0;
+    Vec_WrdFill( p->vSimsPi, Vec_WrdSize(p->vSimsPi), 0 );
+    pMan->timeResimGlo += Abc_Clock() - clk;
+}
+int Cec4_ManSolveClassesMt( Gia_Man_t * p, Cec4_Man_t * pMan )
+{
+    Cec_ParFra_t * pPars = pMan->pPars;
+    Cec4_ThData_t ThData[CEC4_PROC_MAX];
+    Vec_Bit_t * vUndec   = Vec_BitStart( Gia_ManObjNum(p) );
+    Vec_Int_t * vThreads = Vec_IntStartFull( Gia_ManObjNum(p) );
+    Vec_Wec_t * vLevels  = Vec_WecStart( Gia_ManLevelNum(p) + 1 );
+    int nProcs = Abc_MinInt( pPars->nProcs, CEC4_PROC_MAX );
+    int i, k, r, iRepr, iObj, iLit, Level, Status, RetValue = 1;
+    int nRounds = 0, nPairsAll = 0, nProvedAll = 0, nCexesAll = 0, nUndecAll = 0;
+    abctime clk = Abc_Clock(), clkSat;
+    Vec_Int_t * vLevel;
+    assert( nProcs > 1 );
+    assert( p->iPatsPi == 0 );
+    pMan->vProvedMt = Vec_IntStartFull( Gia_ManObjNum(p) );
+    for ( k = 0; k < nProcs; k++ )
+    {
+        memset( ThData + k, 0, sizeof(Cec4_ThData_t) );
+        ThData[k].p        = p;
+        ThData[k].pPars    = pPars;
+        ThData[k].vProved  = pMan->vProvedMt;
+        ThData[k].nWindowMax = Abc_MaxInt( pPars->nSatVarMax, Gia_ManAndNum(p) / nProcs );
+        ThData[k].pSat     = sat_solver_start();
+        ThData[k].pHash    = Hash_IntManStart( 1000 );
+        ThData[k].vHashLits = Vec_IntStartFull( 1 );
+        ThData[k].vSatLits = Vec_IntStartFull( Gia_ManObjNum(p) );
+        ThData[k].vWindow  = Vec_IntAlloc( 1000 );
+        ThData[k].vStamps  = Vec_IntStart( Gia_ManObjNum(p) );
+        ThData[k].vPairs   = Vec_IntAlloc( 1000 );
+        ThData[k].vStatus  = Vec_IntAlloc( 1000 );
+        ThData[k].vCexes   = Vec_IntAlloc( 1000 );
+        sat_solver_set_jftr( ThData[k].pSat, 0 );
+    }
+    // collect the candidates by level (refinement never adds new ones)
+    Gia_ManForEachClass( p, iRepr )
+        Gia_ClassForEachObj1( p, iRepr, iObj )
+            if ( !pPars->nLevelMax || Gia_ObjLevelId(p, iObj) <= pPars->nLevelMax )
+                Vec_WecPush( vLevels, Gia_ObjLevelId(p, iObj), iObj );
+    Vec_WecForEachLevel( vLevels, vLevel, Level )
+    {
+        for ( r = 0; r < pPars->nItersMax && Vec_IntSize(vLevel) > 0; r++ )
+        {
+            int nPairs = 0, nCexes = 0, nThreads;
+            // assign each class to the thread with the fewest pairs
+            for ( k = 0; k < nProcs; k++ )
+                Vec_IntClear( ThData[k].vPairs );
+            Vec_IntForEachEntry( vLevel, iObj, i )
+                if ( Gia_ObjHasRepr(p, iObj) && !Vec_BitEntry(vUndec, iObj) && Vec_IntEntry(pMan->vProvedMt, iObj) == -1 )
+                    nPairs++;
+            if ( nPairs == 0 )
+                break;
+            nThreads = nPairs < 2 * nProcs ? 1 : nProcs;
+            Vec_IntForEachEntry( vLevel, iObj, i )
+            {
+                if ( !Gia_ObjHasRepr(p, iObj) || Vec_BitEntry(vUndec, iObj) || Vec_IntEntry(pMan->vProvedMt, iObj) >= 0 )
+                    continue;
+                iRepr = Gia_ObjRepr( p, iObj );
+                if ( Vec_IntEntry(vThreads, iRepr) == -1 || Vec_IntEntry(vThreads, iRepr) >= nThreads )
+                {
+                    int iBest = 0;
+                    for ( k = 1; k < nThreads; k++ )
+                        if ( Vec_IntSize(ThData[k].vPairs) < Vec_IntSize(ThData[iBest].vPairs) )
+                            iBest = k;
+                    Vec_IntWriteEntry( vThreads, iRepr, iBest );
+                }
+                Vec_IntPushTwo( ThData[Vec_IntEntry(vThreads, iRepr)].vPairs, iRepr, iObj );
+            }
+            Vec_IntForEachEntry( vLevel, iObj, i )
+                if ( Gia_ObjHasRepr(p, iObj) )
+                    Vec_IntWriteEntry( vThreads, Gia_ObjRepr(p, iObj), -1 );
+            // solve the pairs
+            clkSat = Abc_Clock();
+    #ifdef ABC_USE_PTHREADS
+            if ( nThreads > 1 )
+            {
+                pthread_t WorkerThread[CEC4_PROC_MAX];
+                for ( k = 0; k < nThreads; k++ )
+                {
+                    int status = pthread_create( WorkerThread + k, NULL, Cec4_WorkerThread, (void *)(ThData + k) );  
+                    assert( status == 0 );
+                }
+                for ( k = 0; k < nThreads; k++ )
+                    pthread_join( WorkerThread[k], NULL );
+            }
+            else
+    #endif
+            for ( k = 0; k < nThreads; k++ )
+                Cec4_ThSolvePairs( ThData + k );
+            pMan->timeSatUnsat += Abc_Clock() - clkSat;
+            // merge the results in the thread order
+            for ( k = 0; k < nThreads; k++ )
+            {
+                Vec_IntForEachEntryDouble( ThData[k].vPairs, iRepr, iObj, i )
+                {
+                    Status = Vec_IntEntry( ThData[k].vStatus, i/2 );
+                    if ( Status == GLUCOSE_UNSAT )
+                        Vec_IntWriteEntry( pMan->vProvedMt, iObj, iRepr ), nProvedAll++;
+                    else if ( Status == GLUCOSE_SAT )
+                        nCexes++;
+                    else
+                        Vec_BitWriteEntry( vUndec, iObj, 1 ), nUndecAll++;
+                }
+                Vec_IntForEachEntry( ThData[k].vCexes, iLit, i )
+                {
+                    assert( p->iPatsPi >= 0 && p->iPatsPi < 64 * p->nSimWords - 1 );
+                    p->iPatsPi++;
+                    for ( ; (iLit = Vec_IntEntry(ThData[k].vCexes, i)) != -1; i++ )
+                        Cec4_ObjSimSetInputBit( p, Abc_Lit2Var(iLit), Abc_LitIsCompl(iLit) );
+                    if ( p->iPatsPi == 64 * p->nSimWords - 2 )
+                        Cec4_ManResimulate( p, pMan );
+                }
+            }
+            if ( p->iPatsPi > 0 )
+                Cec4_ManResimulate( p, pMan );
+            nRounds++;
+            nPairsAll += nPairs;
+            nCexesAll += nCexes;
+            if ( nCexes == 0 )
+                break;
+            if ( pPars->fCheckMiter && !Cec4_ManSimulateCos(p) ) // cex detected
+            {
+                RetValue = 0;
+                break;
+            }
+        }
+        if ( RetValue == 0 )
+            break;
+    }
+    pMan->nSatUnsat += nProvedAll;
+    pMan->nSatSat   += nCexesAll;
+    pMan->nPatterns += nCexesAll;
+    if ( pPars->fVerbose )
+    {
+        printf( "Threads = %d. Rounds = %d. Pairs = %d.  P = %d  D = %d  F = %d   ", nProcs, nRounds, nPairsAll, nProvedAll, nCexesAll, nUndecAll );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    }
+    for ( k = 0; k < nProcs; k++ )
+    {
+        sat_solver_stop( ThData[k].pSat );
+        Hash_IntManStop( ThData[k].pHash );
+        Vec_IntFree( ThData[k].vHashLits );
+        Vec_IntFree( ThData[k].vSatLits );
+        Vec_IntFree( ThData[k].vWindow );
+        Vec_IntFree( ThData[k].vStamps );
+        Vec_IntFree( ThData[k].vPairs );
+        Vec_IntFree( ThData[k].vStatus );
+        Vec_IntFree( ThData[k].vCexes );
+    }
+    Vec_WecFree( vLevels );
+    Vec_IntFree( vThreads );
+    Vec_BitFree( vUndec );
+    return RetValue;
+}
+
+/**Function*************************************************************
+
+  Synopsis    []
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
 Gia_Obj_t * Cec4_ManFindRepr( Gia_Man_t * p, Cec4_Man_t * pMan, int iObj )
 {
     abctime clk = Abc_Clock();
@@ -1850,6 +2265,8 @@ int Cec4_ManPerformSweeping( Gia_Man_t * p, Cec_ParFra_t * pPars, Gia_Man_t ** p
     p->iPatsPi = 0;
     Vec_WrdFill( p->vSimsPi, Vec_WrdSize(p->vSimsPi), 0 );
     pMan->nSatSat = 0;
+    if ( pPars->nProcs > 1 && !Cec4_ManSolveClassesMt( p, pMan ) ) // cex detected
+        goto finalize;
     pMan->pNew = Cec4_ManStartNew( p );
     Gia_ManForEachAnd( p, pObj, i )
     {
@@ -1872,6 +2289,14 @@ int Cec4_ManPerformSweeping( Gia_Man_t * p, Cec_ParFra_t * pPars, Gia_Man_t ** p
         pRepr = Gia_ObjReprObj( p, i );
         if ( pRepr == NULL )
             continue;
+        if ( pMan->vProvedMt && Vec_IntEntry(pMan->vProvedMt, i) == Gia_ObjId(p, pRepr) ) // proved by the threads
+        {
+            pObj->Value = Abc_LitNotCond( pRepr->Value, pObj->fPhase ^ pRepr->fPhase );
+            Gia_ObjSetProved( p, i );
+            if ( Gia_ObjId(p, pRepr) == 0 )
+                pMan->iLastConst = i;
+            continue;
+        }
         if ( 1 ) // select representative based on recent counter-examples
         {
             pRepr = Cec4_ManFindRepr( p, pMan, i );
@@ -1939,13 +2364,14 @@ Gia_Man_t * Cec4_ManSimulateTest( Gia_Man_t * p, Cec_ParFra_t * pPars )
     Cec4_ManPerformSweeping( p, pPars, &pNew, 0 );
     return pNew;
 }
-void Cec4_ManSimulateTest2( Gia_Man_t * p, int nConfs, int fVerbose )
+void Cec4_ManSimulateTest2( Gia_Man_t * p, int nConfs, int nProcs, int fVerbose )
 {
     abctime clk = Abc_Clock();
     Cec_ParFra_t ParsFra, * pPars = &ParsFra;
     Cec4_ManSetParams( pPars );
     pPars->fVerbose = fVerbose;
     pPars->nBTLimit = nConfs;
+    pPars->nProcs   = nProcs;
     Cec4_ManPerformSweeping( p, pPars, NULL, 0 );
     if ( fVerbose )
         Abc_PrintTime( 1, "New choice computation time", Abc_Clock() - clk );
@@ -1085,7 +1085,8 @@ Vec_Int_t * Cec_ManSatSolveMiter( Gia_Man_t * pAig, Cec_ParSat_t * pPars, Vec_St
     vCexStore = Vec_IntAlloc( 10000 );
     // perform solving
     p = Cec_ManSatCreate( pAig, pPars );
-    pProgress = Bar_ProgressStart( stdout, Gia_ManPoNum(pAig) );
+    if ( !pPars->fNoProgress )
+        pProgress = Bar_ProgressStart( stdout, Gia_ManPoNum(pAig) );
     Gia_ManForEachCo( pAig, pObj, i )
     {
         Vec_IntClear( p->vCex );
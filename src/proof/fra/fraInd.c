@@ -355,6 +355,7 @@ Aig_Man_t * Fra_FraigInduction( Aig_Man_t * pManAig, Fra_Ssw_t * pParams )
     Fra_Par_t Pars, * pPars = &Pars; 
     Aig_Obj_t * pObj;
     Cnf_Dat_t * pCnf;
+    Cnf_FastMan_t * pCnfMan = NULL;
     Aig_Man_t * pManAigNew = NULL;
     int nNodesBeg, nRegsBeg;
     int nIter = -1; // Suppress "might be used uninitialized"
@@ -469,6 +470,8 @@ ABC_PRT( "Time", Abc_Clock() - clk );
 //    Aig_ManStop( pManAigNew );
  
     // iterate the inductive case
+    // (the CNF manager keeps the cut ISOPs and the unchanged cuts between the iterations)
+    pCnfMan = Cnf_FastManStart();
     p->pCla->fRefinement = 1;
     for ( nIter = 0; p->pCla->fRefinement; nIter++ )
     {
@@ -500,7 +503,7 @@ p->timeTrav += Abc_Clock() - clk2;
         if ( fUseSimpleCnf || pPars->fUseImps )
             pCnf = Cnf_DeriveSimple( p->pManFraig, Aig_ManRegNum(p->pManFraig) );
         else
-            pCnf = Cnf_Derive( p->pManFraig, Aig_ManRegNum(p->pManFraig) );
+            pCnf = Cnf_DeriveFastWithMan( pCnfMan, p->pManFraig, Aig_ManRegNum(p->pManFraig) );
 //        Cnf_DataTranformPolarity( pCnf, 0 );
 //Cnf_DataWriteIntoFile( pCnf, "temp.cnf", 1 );
 
@@ -638,6 +641,8 @@ p->timeTotal = Abc_Clock() - clk;
     p->nRegsEnd  = Aig_ManRegNum(pManAigNew);
     // free the manager
 finish:
+    if ( pCnfMan )
+        Cnf_FastManStop( pCnfMan );
     Fra_ManStop( p );
     // check the output
 //    if ( Aig_ManCoNum(pManAigNew) - Aig_ManRegNum(pManAigNew) == 1 )
@@ -50,6 +50,7 @@ struct Pdr_Par_t_
     int nTimeOutGap;      // approximate timeout in seconds since the last change
     int nTimeOutOne;      // approximate timeout in seconds per one output
     int nRandomSeed;      // value to seed the SAT solver with
+    int nProcs;           // the number of worker threads sharing clauses
     int fTwoRounds;       // use two rounds for generalization
     int fMonoCnf;         // monolythic CNF
     int fNewXSim;         // updated X-valued simulation
@@ -75,6 +76,7 @@ struct Pdr_Par_t_
     int fAnytime;         // enable anytime scheduling
     int fUseBridge;       // use bridge interface
     int fUsePropOut;      // use property output
+    int fSkipSetInv;      // do not save the invariant in the ABC frame (when running in a thread)
     int nFailOuts;        // the number of failed outputs
     int nDropOuts;        // the number of timed out outputs
     int nProveOuts;       // the number of proved outputs
@@ -82,6 +84,7 @@ struct Pdr_Par_t_
     int RunId;            // PDR id in this run 
     int(*pFuncStop)(int); // callback to terminate
     int(*pFuncOnFail)(int,Abc_Cex_t*); // called for a failed output in MO mode
+    int(*pFuncIsSolved)(int); // called to skip an output solved by another engine
     abctime timeLastSolved; // the time when the last output was solved
     Vec_Int_t * vOutMap;  // in the multi-output mode, contains status for each PO (0 = sat; 1 = unsat; negative = undecided)
     char * pInvFileName;  // invariable file name
@@ -59,6 +59,7 @@ void Pdr_ManSetDefaultParams( Pdr_Par_t * pPars )
     pPars->nConfGenLimit  =       0;  // limit on SAT solver conflicts during generalization
     pPars->nRestLimit     =       0;  // limit on the number of proof-obligations
     pPars->nRandomSeed   = 91648253;  // value to seed the SAT solver with
+    pPars->nProcs         =       1;  // the number of worker threads sharing clauses
     pPars->fTwoRounds     =       0;  // use two rounds for generalization
     pPars->fMonoCnf       =       0;  // monolythic CNF
     pPars->fNewXSim       =       0;  // updated X-valued simulation
@@ -1057,7 +1058,7 @@ int Pdr_ManBlockCube( Pdr_Man_t * p, Pdr_Set_t * pCube )
     while ( !Pdr_QueueIsEmpty(p) )
     {
         Counter++;
-        if (Counter % 100 == 0) {
+        if (Counter % 100 == 0 && !p->pPars->fSilent) {
             Pdr_ManPrintProgress( p, 1, Abc_Clock() - p->tStart );
         }
         pThis = Pdr_QueueHead( p );
@@ -1145,6 +1146,9 @@ int Pdr_ManBlockCube( Pdr_Man_t * p, Pdr_Set_t * pCube )
             // add clause
             for ( i = 1; i <= k; i++ )
                 Pdr_ManSolverAddClause( p, i, pCubeMin );
+            // publish the clause to other workers
+            if ( p->pShr )
+                Pdr_ManShrExport( p, k, pCubeMin );
             // schedule proof obligation
             if ( (k < kMax || p->pPars->fReuseProofOblig) && !p->pPars->fShortest )
             {
@@ -1287,6 +1291,9 @@ int Pdr_ManSolveInt( Pdr_Man_t * p )
             // skip otuput that was already solved
             if ( p->pPars->vOutMap && Vec_IntEntry( p->pPars->vOutMap, p->iOutCur ) == 1 )
                 continue;
+            // skip output solved by another engine
+            if ( p->pPars->pFuncIsSolved && p->pPars->pFuncIsSolved(p->iOutCur) )
+                continue;
             // skip output whose time has run out
             if ( p->pTime4Outs && p->pTime4Outs[p->iOutCur] == 0 )
                 continue;
@@ -1347,6 +1354,9 @@ int Pdr_ManSolveInt( Pdr_Man_t * p )
                     p->pPars->iFrame = iFrame;
                     return -1;
                 }
+                // import clauses published by other workers
+                if ( p->pShr )
+                    Pdr_ManShrImport( p );
                 RetValue = Pdr_ManCheckCube( p, iFrame, NULL, &pCube, p->pPars->nConfLimit, 0, 1 );
                 if ( RetValue == 1 )
                     break;
@@ -1548,6 +1558,9 @@ int Pdr_ManSolveInt( Pdr_Man_t * p )
                 for ( i = 0; i < Saig_ManPoNum(p->pAig); i++ )
                     if ( Vec_IntEntry(p->pPars->vOutMap, i) == -2 ) // unknown
                     {
+                        // outputs skipped because another engine solved them are not covered by the invariant
+                        if ( p->pPars->pFuncIsSolved && p->pPars->pFuncIsSolved(i) )
+                            continue;
                         Vec_IntWriteEntry( p->pPars->vOutMap, i, 1 ); // unsat
                         Abc_Print( 1, "Proved output %d in frame %d (converged).\n", i );
                         p->pPars->nProveOuts++;
@@ -1687,6 +1700,7 @@ void Pdr_ManResetReuseInvariant( Pdr_Man_t * p )
 ***********************************************************************/
 int Pdr_ManSolve( Aig_Man_t * pAig, Pdr_Par_t * pPars )
 {
+    Aig_Man_t * pAigUsed;
     Pdr_Man_t * p;
     int k, RetValue, nTimeOutU;
     abctime clk = Abc_Clock();
@@ -1717,18 +1731,23 @@ int Pdr_ManSolve( Aig_Man_t * pAig, Pdr_Par_t * pPars )
             pPars->fSolveAll ?    "yes" : "no" );
     }
     ABC_FREE( pAig->pSeqModel );
-    p = Pdr_ManStart( pAig, pPars, NULL );
-
-    while (1) {
-
-        RetValue = Pdr_ManSolveInt( p );
-        if ( RetValue == -1 && Saig_ManPoNum(p->pAig) == pPars->nProveOuts + pPars->nFailOuts )
-            RetValue = pPars->nFailOuts == 0;
-        if ( RetValue == -1 && pPars->fAnytime )
-            Pdr_ManResetReuseInvariant( p );
-        else
-            break;
+    if ( pPars->nProcs > 1 && !pPars->fSolveAll && !pPars->fAnytime && !pPars->fUseAbs )
+        p = Pdr_ManSolveMt( pAig, pPars, &RetValue ); // the winner working on a copy of pAig
+    else
+    {
+        p = Pdr_ManStart( pAig, pPars, NULL );
+        while (1) {
+
+            RetValue = Pdr_ManSolveInt( p );
+            if ( RetValue == -1 && Saig_ManPoNum(p->pAig) == pPars->nProveOuts + pPars->nFailOuts )
+                RetValue = pPars->nFailOuts == 0;
+            if ( RetValue == -1 && pPars->fAnytime )
+                Pdr_ManResetReuseInvariant( p );
+            else
+                break;
+        }
     }
+    pAigUsed = p->pAig;
     if ( RetValue == 0 )
         assert( pAig->pSeqModel != NULL || p->vCexes != NULL );
     if ( p->vCexes )
@@ -1740,14 +1759,17 @@ int Pdr_ManSolve( Aig_Man_t * pAig, Pdr_Par_t * pPars )
     if ( p->pPars->fDumpInv )
     {
         char * pFileName = pPars->pInvFileName ? pPars->pInvFileName : Extra_FileNameGenericAppend(p->pAig->pName, "_inv.pla");
-        Abc_FrameSetInv( Pdr_ManDeriveInfinityClauses( p, RetValue!=1 ) );
+        if ( !pPars->fSkipSetInv )
+            Abc_FrameSetInv( Pdr_ManDeriveInfinityClauses( p, RetValue!=1 ) );
         Pdr_ManDumpClauses( p, pFileName, RetValue==1 );
         printf( "Dumped inductive invariant in file \"%s\".\n", pFileName );
     }
-    else if ( RetValue == 1 )
+    else if ( RetValue == 1 && !pPars->fSkipSetInv )
         Abc_FrameSetInv( Pdr_ManDeriveInfinityClauses( p, RetValue!=1 ) );
     p->tTotal += Abc_Clock() - clk;
     Pdr_ManStop( p );
+    if ( pAigUsed != pAig )
+        Aig_ManStop( pAigUsed );
     pPars->iFrame--;
     // convert all -2 (unknown) entries into -1 (undec)
     if ( pPars->vOutMap )
@@ -72,6 +72,7 @@ ABC_NAMESPACE_HEADER_START
 
 typedef struct Txs_Man_t_  Txs_Man_t;
 typedef struct Txs3_Man_t_ Txs3_Man_t;
+typedef struct Pdr_Shr_t_ Pdr_Shr_t;
 
 typedef struct Pdr_Set_t_ Pdr_Set_t;
 struct Pdr_Set_t_
@@ -143,6 +144,10 @@ struct Pdr_Man_t_
     Vec_Int_t * vRes;      // final result
     abctime *   pTime4Outs;// timeout per output
     Vec_Ptr_t * vInfCubes; // infinity clauses/cubes
+    // clause sharing
+    Pdr_Shr_t * pShr;      // clauses shared by the worker threads
+    int         iWorker;   // the number of this worker
+    Vec_Ptr_t * vShrSeen;  // for each frame, the last shared clause seen
     // statistics
     int         nBlocks;   // the number of times blockState was called
     int         nObligs;   // the number of proof obligations derived
@@ -164,6 +169,8 @@ struct Pdr_Man_t_
     int         nXsimLits;
     int         nInfClauses;
     int         fNewInfClauses;
+    int         nShrExport;// the number of clauses published
+    int         nShrImport;// the number of clauses imported
     // runtime
     abctime     timeToStop;
     abctime     timeToStopOne;
@@ -209,6 +216,7 @@ extern int             Pdr_ManFreeVar( Pdr_Man_t * p, int k );
 extern sat_solver *    Pdr_ManNewSolver( sat_solver * pSat, Pdr_Man_t * p, int k, int fInit );
 /*=== pdrCore.c ==========================================================*/
 extern int             Pdr_ManCheckContainment( Pdr_Man_t * p, int k, Pdr_Set_t * pSet );
+extern int             Pdr_ManSolveInt( Pdr_Man_t * p );
 /*=== pdrInv.c ==========================================================*/
 extern Vec_Int_t *     Pdr_ManCountFlopsInv( Pdr_Man_t * p );
 extern void            Pdr_ManPrintProgress( Pdr_Man_t * p, int fClose, abctime Time );
@@ -223,6 +231,10 @@ extern Pdr_Man_t *     Pdr_ManStart( Aig_Man_t * pAig, Pdr_Par_t * pPars, Vec_In
 extern void            Pdr_ManStop( Pdr_Man_t * p );
 extern Abc_Cex_t *     Pdr_ManDeriveCex( Pdr_Man_t * p );
 extern Abc_Cex_t *     Pdr_ManDeriveCexAbs( Pdr_Man_t * p );
+/*=== pdrMt.c ==========================================================*/
+extern void            Pdr_ManShrExport( Pdr_Man_t * p, int k, Pdr_Set_t * pCube );
+extern int             Pdr_ManShrImport( Pdr_Man_t * p );
+extern Pdr_Man_t *     Pdr_ManSolveMt( Aig_Man_t * pAig, Pdr_Par_t * pPars, int * pRetValue );
 /*=== pdrSat.c ==========================================================*/
 extern sat_solver *    Pdr_ManCreateSolver( Pdr_Man_t * p, int k );
 extern sat_solver *    Pdr_ManFetchSolver( Pdr_Man_t * p, int k );
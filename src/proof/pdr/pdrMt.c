@@ -0,0 +1,445 @@
+/**CFile****************************************************************
+
+  FileName    [pdrMt.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Property driven reachability.]
+
+  Synopsis    [Multi-threaded PDR with shared frame clauses.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - November 20, 2010.]
+
+  Revision    [$Id: pdrMt.c,v 1.00 2010/11/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include "pdrInt.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+#define PDR_MT_MAX     100    // the largest number of workers
+#define PDR_SHR_FRAMES 10000  // the number of frames when there is no frame limit
+
+// the workers run PDR on their own copies of the AIG and publish each
+// clause added by Pdr_ManBlockCube() into a per-frame list of the shared
+// store; the lists are only pushed to (using compare-and-swap), so the
+// readers can walk them without locking; an importing worker checks each
+// clause for relative inductiveness w.r.t. its own frames before using it,
+// which keeps its frames over-approximating the reachable states
+
+typedef struct Pdr_Cla_t_ Pdr_Cla_t;
+struct Pdr_Cla_t_
+{
+    Pdr_Cla_t *       pNext;          // the previously published clause
+    Pdr_Set_t *       pCube;          // the cube (private copy)
+    int               iWorker;        // the worker that published it
+};
+
+struct Pdr_Shr_t_
+{
+    int               nWorkers;       // the number of workers
+    int               nFrames;        // the number of frames in the store
+    Pdr_Cla_t * volatile * pHeads;    // for each frame, the last published clause
+    volatile int      iWinner;        // the worker that finished first
+    int(*pFuncStop)(int);             // the user's callback to terminate
+    int               RunIdUser;      // the user's run ID
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_t   Mutex;          // the lock (used without atomics)
+#endif
+};
+
+typedef struct Pdr_MtThData_t_
+{
+    Pdr_Shr_t *       pShr;           // the shared store
+    Pdr_Man_t *       p;              // the worker
+    int               iWorker;        // the number of this worker
+    int               RetValue;       // the result
+} Pdr_MtThData_t;
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Starts and stops the shared clause store.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Pdr_Shr_t * Pdr_ShrStart( int nWorkers, int nFrames )
+{
+    Pdr_Shr_t * p = ABC_CALLOC( Pdr_Shr_t, 1 );
+    p->nWorkers = nWorkers;
+    p->nFrames  = nFrames;
+    p->pHeads   = ABC_CALLOC( Pdr_Cla_t *, nFrames );
+    p->iWinner  = -1;
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_init( &p->Mutex, NULL );
+#endif
+    return p;
+}
+void Pdr_ShrStop( Pdr_Shr_t * p )
+{
+    Pdr_Cla_t * pCla, * pNext;
+    int k;
+    for ( k = 0; k < p->nFrames; k++ )
+        for ( pCla = p->pHeads[k]; pCla; pCla = pNext )
+        {
+            pNext = pCla->pNext;
+            Pdr_SetDeref( pCla->pCube );
+            ABC_FREE( pCla );
+        }
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_destroy( &p->Mutex );
+#endif
+    ABC_FREE( p->pHeads );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Adds and reads the clauses of the given frame.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Pdr_ShrPush( Pdr_Shr_t * p, int k, Pdr_Cla_t * pCla )
+{
+#if defined(ABC_USE_PTHREADS) && !defined(__GNUC__)
+    pthread_mutex_lock( &p->Mutex );
+    pCla->pNext = p->pHeads[k];
+    p->pHeads[k] = pCla;
+    pthread_mutex_unlock( &p->Mutex );
+#elif defined(__GNUC__)
+    do {
+        pCla->pNext = p->pHeads[k];
+    } while ( !__sync_bool_compare_and_swap( &p->pHeads[k], pCla->pNext, pCla ) );
+#else
+    pCla->pNext = p->pHeads[k];
+    p->pHeads[k] = pCla;
+#endif
+}
+static inline Pdr_Cla_t * Pdr_ShrHead( Pdr_Shr_t * p, int k )
+{
+    Pdr_Cla_t * pHead;
+#if defined(ABC_USE_PTHREADS) && !defined(__GNUC__)
+    pthread_mutex_lock( &p->Mutex );
+    pHead = p->pHeads[k];
+    pthread_mutex_unlock( &p->Mutex );
+#elif defined(__GNUC__)
+    pHead = p->pHeads[k];
+    __sync_synchronize();
+#else
+    pHead = p->pHeads[k];
+#endif
+    return pHead;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Publishes the clause blocked by this worker in frame k.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Pdr_ManShrExport( Pdr_Man_t * p, int k, Pdr_Set_t * pCube )
+{
+    Pdr_Cla_t * pCla;
+    if ( k >= p->pShr->nFrames )
+        return;
+    pCla = ABC_ALLOC( Pdr_Cla_t, 1 );
+    pCla->pCube   = Pdr_SetDup( pCube );
+    pCla->iWorker = p->iWorker;
+    Pdr_ShrPush( p->pShr, k, pCla );
+    p->nShrExport++;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Imports the clauses published by other workers.]
+
+  Description [A clause published for frame k is added to frame k of
+  this worker if it does not contain the init state and is inductive
+  relative to frame k-1 of this worker. Clauses of the frames not yet
+  opened by this worker are imported when these frames are opened.
+  If the resource limit is reached, the clauses of the frame are 
+  visited again by the next call (those already imported are skipped
+  by the containment check). Returns the number of imported clauses.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Pdr_ManShrImport( Pdr_Man_t * p )
+{
+    Pdr_Cla_t * pHead, * pSeen, * pCla;
+    Pdr_Set_t * pCube;
+    int i, k, RetValue, nImported = 0;
+    int kMax = Abc_MinInt( Vec_PtrSize(p->vSolvers)-1, p->pShr->nFrames-1 );
+    if ( p->vShrSeen == NULL )
+        p->vShrSeen = Vec_PtrAlloc( 100 );
+    Vec_PtrFillExtra( p->vShrSeen, kMax + 1, NULL );
+    for ( k = 1; k <= kMax; k++ )
+    {
+        pHead = Pdr_ShrHead( p->pShr, k );
+        pSeen = (Pdr_Cla_t *)Vec_PtrEntry( p->vShrSeen, k );
+        if ( pHead == pSeen )
+            continue;
+        for ( pCla = pHead; pCla != pSeen; pCla = pCla->pNext )
+        {
+            if ( pCla->iWorker == p->iWorker )
+                continue;
+            if ( Pdr_SetIsInit(pCla->pCube, -1) )
+                continue;
+            if ( Pdr_ManCheckContainment( p, k, pCla->pCube ) )
+                continue;
+            RetValue = Pdr_ManCheckCube( p, k-1, pCla->pCube, NULL, 0, 0, 1 );
+            if ( RetValue == -1 ) // resource limit is reached
+                break;
+            if ( RetValue == 0 ) // not inductive relative to this worker's frames
+                continue;
+            pCube = Pdr_SetDup( pCla->pCube );
+            pCube->iBound = k;
+            Vec_VecPush( p->vClauses, k, pCube );   // consume ref
+            for ( i = 1; i <= k; i++ )
+                Pdr_ManSolverAddClause( p, i, pCube );
+            nImported++;
+        }
+        if ( pCla != pSeen )
+            break;
+        // all clauses up to the head are processed
+        Vec_PtrWriteEntry( p->vShrSeen, k, pHead );
+    }
+    p->nShrImport += nImported;
+    return nImported;
+}
+
+#ifndef ABC_USE_PTHREADS
+
+Pdr_Man_t * Pdr_ManSolveMt( Aig_Man_t * pAig, Pdr_Par_t * pPars, int * pRetValue )
+{
+    Pdr_Man_t * p = Pdr_ManStart( pAig, pPars, NULL );
+    *pRetValue = Pdr_ManSolveInt( p );
+    return p;
+}
+
+#else // pthreads are used
+
+// the shared store of the run of the current worker thread
+static ABC_THREAD_LOCAL Pdr_Shr_t * s_pPdrShr = NULL;
+int Pdr_ManMtCallBackToStop( int RunId )
+{
+    Pdr_Shr_t * pShr = s_pPdrShr;
+    assert( pShr != NULL );
+    return pShr->iWinner != -1 || (pShr->pFuncStop && pShr->pFuncStop(pShr->RunIdUser));
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Varies the parameters of the workers.]
+
+  Description [The first worker uses the user's parameters. Other
+  workers change the SAT solver seed, the flop order and the effort
+  used during generalization, which makes them block different cubes.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Pdr_ManMtSetWorkerParams( Pdr_Par_t * pPars, int iWorker )
+{
+    pPars->nProcs      = 1;
+    pPars->fSilent     = 1;
+    pPars->fDumpInv    = 0;
+    if ( iWorker == 0 )
+        return;
+    pPars->nRandomSeed += 7919 * iWorker;
+    if ( iWorker & 1 )
+        pPars->fFlopOrder ^= 1;
+    if ( iWorker & 2 )
+        pPars->fTwoRounds ^= 1;
+    if ( iWorker & 4 )
+        pPars->fSkipDown  ^= 1;
+    // only the first worker enforces the time limits and prints progress
+    pPars->nTimeOut     = 0;
+    pPars->nTimeOutGap  = 0;
+    pPars->fVerbose     = 0;
+    pPars->fVeryVerbose = 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs one worker.]
+
+  Description [The first worker to prove or disprove the property, or the
+  first worker to give up, cancels the others.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void * Pdr_ManMtWorkerThread( void * pArg )
+{
+    Pdr_MtThData_t * pThData = (Pdr_MtThData_t *)pArg;
+    Pdr_Shr_t * pShr = pThData->pShr;
+    s_pPdrShr = pShr;
+    pThData->RetValue = Pdr_ManSolveInt( pThData->p );
+    pthread_mutex_lock( &pShr->Mutex );
+    if ( pShr->iWinner == -1 && (pThData->RetValue != -1 || pThData->iWorker == 0) )
+        pShr->iWinner = pThData->iWorker;
+    pthread_mutex_unlock( &pShr->Mutex );
+    pthread_exit( NULL );
+    assert( 0 );
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs several PDR workers sharing the blocked clauses.]
+
+  Description [Returns the manager of the winning worker, which works on
+  a copy of pAig and uses pPars. The counter-example, if any, is
+  transferred to pAig.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Pdr_Man_t * Pdr_ManSolveMt( Aig_Man_t * pAig, Pdr_Par_t * pPars, int * pRetValue )
+{
+    Pdr_MtThData_t ThData[PDR_MT_MAX];
+    pthread_t WorkerThread[PDR_MT_MAX];
+    Pdr_Shr_t * pShr;
+    Pdr_Par_t * pParsW;
+    Pdr_Man_t * p;
+    Aig_Man_t * pAigW;
+    abctime clkStart = Abc_Clock();
+    int i, status, iWinner, nProcs = Abc_MinInt( pPars->nProcs, PDR_MT_MAX );
+    pShr = Pdr_ShrStart( nProcs, pPars->nFrameMax ? pPars->nFrameMax + 2 : PDR_SHR_FRAMES );
+    pShr->pFuncStop = pPars->pFuncStop;
+    pShr->RunIdUser = pPars->RunId;
+    for ( i = 0; i < nProcs; i++ )
+    {
+        pParsW = ABC_ALLOC( Pdr_Par_t, 1 );
+        memcpy( pParsW, pPars, sizeof(Pdr_Par_t) );
+        Pdr_ManMtSetWorkerParams( pParsW, i );
+        pParsW->pFuncStop = Pdr_ManMtCallBackToStop;
+        p = Pdr_ManStart( Aig_ManDupSimple(pAig), pParsW, NULL );
+        p->pShr    = pShr;
+        p->iWorker = i;
+        ThData[i].pShr     = pShr;
+        ThData[i].p        = p;
+        ThData[i].iWorker  = i;
+        ThData[i].RetValue = -1;
+        status = pthread_create( WorkerThread + i, NULL, Pdr_ManMtWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
+    }
+    for ( i = 0; i < nProcs; i++ )
+    {
+        status = pthread_join( WorkerThread[i], NULL );
+        assert( status == 0 );
+    }
+    iWinner = pShr->iWinner >= 0 ? pShr->iWinner : 0;
+    *pRetValue = ThData[iWinner].RetValue;
+    if ( pPars->fVerbose )
+    {
+        for ( i = 0; i < nProcs; i++ )
+        {
+            p = ThData[i].p;
+            Abc_Print( 1, "Worker %2d :  Frame =%4d  Clause =%6d  Exported =%6d  Imported =%6d  %s\n",
+                i, Vec_PtrSize(p->vSolvers)-1, p->nCubes, p->nShrExport, p->nShrImport,
+                i != iWinner ? "" : (*pRetValue == 1 ? "proved" : (*pRetValue == 0 ? "disproved" : "undecided")) );
+        }
+    }
+    // stop other workers
+    for ( i = 0; i < nProcs; i++ )
+    {
+        if ( i == iWinner )
+            continue;
+        p      = ThData[i].p;
+        pAigW  = p->pAig;
+        pParsW = p->pPars;
+        pParsW->fVerbose = 0;
+        Pdr_ManStop( p );
+        Aig_ManStop( pAigW );
+        ABC_FREE( pParsW );
+    }
+    // transfer the results of the winner
+    p = ThData[iWinner].p;
+    pPars->iFrame     = p->pPars->iFrame;
+    pPars->nFailOuts  = p->pPars->nFailOuts;
+    pPars->nDropOuts  = p->pPars->nDropOuts;
+    pPars->nProveOuts = p->pPars->nProveOuts;
+    ABC_FREE( p->pPars );
+    p->pPars = pPars;
+    p->pShr  = NULL;
+    if ( *pRetValue == 0 )
+    {
+        pAig->pSeqModel = p->pAig->pSeqModel;
+        p->pAig->pSeqModel = NULL;
+    }
+    if ( !pPars->fSilent )
+    {
+        if ( *pRetValue == 1 )
+        {
+            Pdr_ManReportInvariant( p );
+            Pdr_ManVerifyInvariant( p );
+        }
+        else if ( *pRetValue == -1 )
+        {
+            if ( pPars->nTimeOut && Abc_Clock() > clkStart + pPars->nTimeOut * CLOCKS_PER_SEC )
+                Abc_Print( 1, "Reached timeout (%d seconds) in frame %d.\n",  pPars->nTimeOut, pPars->iFrame );
+            else if ( pPars->nFrameMax && pPars->iFrame >= pPars->nFrameMax )
+                Abc_Print( 1, "Reached limit on the number of timeframes (%d).\n", pPars->nFrameMax );
+            else if ( pPars->nConfLimit )
+                Abc_Print( 1, "Reached conflict limit (%d) in frame %d.\n",  pPars->nConfLimit, pPars->iFrame );
+        }
+    }
+    Pdr_ShrStop( pShr );
+    return p;
+}
+
+#endif // pthreads are used
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
@@ -98,6 +98,7 @@ struct Ssw_RarPars_t_
     int              nRounds;
     int              nRestart;
     int              nRandSeed;
+    int              nProcs;
     int              TimeOut;
     int              TimeOutGap;
     int              fSolveAll;
@@ -140,6 +141,7 @@ extern int           Ssw_SecWithSimilarity( Aig_Man_t * p0, Aig_Man_t * p1, Ssw_
 /*=== sswMiter.c ===================================================*/
 /*=== sswPart.c ==========================================================*/
 extern Aig_Man_t *   Ssw_SignalCorrespondencePart( Aig_Man_t * pAig, Ssw_Pars_t * pPars );
+extern Aig_Man_t *   Ssw_SignalCorrespondencePart2( Aig_Man_t * pAig, Ssw_Pars_t * pPars );
 /*=== sswPairs.c ===================================================*/
 extern int           Ssw_MiterStatus( Aig_Man_t * p, int fVerbose );
 extern int           Ssw_SecWithPairs( Aig_Man_t * pAig1, Aig_Man_t * pAig2, Vec_Int_t * vIds1, Vec_Int_t * vIds2, Ssw_Pars_t * pPars );
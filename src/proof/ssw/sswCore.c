@@ -466,6 +466,8 @@ Aig_Man_t * Ssw_SignalCorrespondence( Aig_Man_t * pAig, Ssw_Pars_t * pPars )
     {
         assert( pPars->nFramesK > 0 );
         // perform partitioning
+        if ( pPars->nProcs > 1 && pPars->nPartSize > 0 && pPars->nPartSize < Aig_ManRegNum(pAig) && pPars->nFramesK == 1 && !pPars->fConstrs )
+            return Ssw_SignalCorrespondencePart2( pAig, pPars );
         if ( (pPars->nPartSize > 0 && pPars->nPartSize < Aig_ManRegNum(pAig))
              || (pAig->vClockDoms && Vec_VecSize(pAig->vClockDoms) > 0)  )
             return Ssw_SignalCorrespondencePart( pAig, pPars );
@@ -22,6 +22,17 @@
 #include "aig/gia/giaAig.h"
 #include "base/main/main.h"
 #include "sat/bmc/bmc.h"
+#include "misc/util/utilTruth.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
 
 ABC_NAMESPACE_IMPL_START
 
@@ -30,7 +41,21 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define SSW_RAR_PROC_MAX 64
+
 typedef struct Ssw_RarMan_t_ Ssw_RarMan_t;
+typedef struct Ssw_RarTh_t_  Ssw_RarTh_t;
+
+// the simulation words are divided among the threads, which
+// simulate the same objects of the compact AIG on their own words
+struct Ssw_RarTh_t_
+{
+    Ssw_RarMan_t * p;            // the rarity manager
+    volatile int   iStart;       // the first word (-1 to stop)
+    volatile int   iStop;        // the last word + 1
+    volatile int   fWorking;     // the thread is busy
+};
+
 struct Ssw_RarMan_t_
 {
     // parameters
@@ -42,6 +67,8 @@ struct Ssw_RarMan_t_
     Ssw_Cla_t *    ppClasses;    // equivalence classes
     Vec_Int_t *    vInits;       // initial state
     // simulation data
+    Gia_Man_t *    pGia;         // compact AIG used for simulation
+    int *          pObj2Sim;     // simulation info of each AIG object
     word *         pObjData;     // simulation info for each obj
     word *         pPatData;     // pattern data for each reg
     // candidates to update
@@ -56,6 +83,12 @@ struct Ssw_RarMan_t_
     int            iFailPat;     // failed pattern
     // counter-examples
     Vec_Ptr_t *    vCexes;
+    // concurrent simulation
+    int            nProcs;       // the number of threads
+    Ssw_RarTh_t    ThData[SSW_RAR_PROC_MAX];
+#ifdef ABC_USE_PTHREADS
+    pthread_t      WorkerThread[SSW_RAR_PROC_MAX];
+#endif
 };
 
 
@@ -80,7 +113,9 @@ static inline void Ssw_RarAddToBinPat( Ssw_RarMan_t * p, int iBin, int iPat )
 
 static inline int    Ssw_RarBitWordNum( int nBits )             { return (nBits>>6) + ((nBits&63) > 0);  }
 
-static inline word * Ssw_RarObjSim( Ssw_RarMan_t * p, int Id )  { assert( Id < Aig_ManObjNumMax(p->pAig) ); return p->pObjData + p->pPars->nWords * Id;    }
+static inline word * Ssw_RarObjSim( Ssw_RarMan_t * p, int Id )  { assert( Id < Aig_ManObjNumMax(p->pAig) ); return p->pObjData + p->pPars->nWords * p->pObj2Sim[Id]; }
+static inline int    Ssw_RarObjLit( Ssw_RarMan_t * p, Aig_Obj_t * pObj, int fCompl ) { return Aig_ObjIsConst1(pObj) ? !fCompl : Abc_Var2Lit( p->pObj2Sim[Aig_ObjId(pObj)], fCompl ); }
+static inline word * Ssw_RarGiaSim( Ssw_RarMan_t * p, int Id )  { assert( Id < Gia_ManObjNum(p->pGia) );     return p->pObjData + p->pPars->nWords * Id;    }
 static inline word * Ssw_RarPatSim( Ssw_RarMan_t * p, int Id )  { assert( Id < 64 * p->pPars->nWords );     return p->pPatData + p->nWordsReg * Id;        }
 
 
@@ -108,6 +143,7 @@ void Ssw_RarSetDefaultParams( Ssw_RarPars_t * p )
     p->nRounds       =   0;
     p->nRestart      =   0;
     p->nRandSeed     =   0;
+    p->nProcs        =   1;
     p->TimeOut       =   0;
     p->TimeOutGap    =   0;
     p->fSolveAll     =   0;
@@ -637,6 +673,89 @@ int Ssw_RarManCheckNonConstOutputs( Ssw_RarMan_t * p, int iFrame, abctime Time )
         return 0;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Simulates the given range of words.]
+
+  Description [The internal nodes and the combinational outputs of the
+  compact AIG are simulated for words in [iStart; iStop).]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Ssw_RarManSimulateRange( Ssw_RarMan_t * p, int iStart, int iStop )
+{
+    Gia_Obj_t * pObj;
+    int i, nWords = iStop - iStart;
+    Gia_ManForEachAnd( p->pGia, pObj, i )
+        Abc_TtAndCompl( Ssw_RarGiaSim(p, i) + iStart, 
+            Ssw_RarGiaSim(p, Gia_ObjFaninId0(pObj, i)) + iStart, Gia_ObjFaninC0(pObj), 
+            Ssw_RarGiaSim(p, Gia_ObjFaninId1(pObj, i)) + iStart, Gia_ObjFaninC1(pObj), nWords );
+    Gia_ManForEachCo( p->pGia, pObj, i )
+        Abc_TtCopy( Ssw_RarGiaSim(p, Gia_ObjId(p->pGia, pObj)) + iStart, 
+            Ssw_RarGiaSim(p, Gia_ObjFaninId0p(p->pGia, pObj)) + iStart, nWords, Gia_ObjFaninC0(pObj) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Simulates all words using the worker threads.]
+
+  Description [The current thread simulates the first range of words.
+  The ranges are aligned to cache lines, so that the threads do not
+  write into the same lines. The result does not depend on the number
+  of threads.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifdef ABC_USE_PTHREADS
+static void * Ssw_RarWorkerThread( void * pArg )
+{
+    Ssw_RarTh_t * pThData = (Ssw_RarTh_t *)pArg;
+    volatile int * pPlace = &pThData->fWorking;
+    while ( 1 )
+    {
+        while ( *pPlace == 0 );
+        assert( pThData->fWorking );
+        if ( pThData->iStart == -1 )
+        {
+            pthread_exit( NULL );
+            assert( 0 );
+            return NULL;
+        }
+        Ssw_RarManSimulateRange( pThData->p, pThData->iStart, pThData->iStop );
+        pThData->fWorking = 0;
+    }
+    assert( 0 );
+    return NULL;
+}
+#endif
+static void Ssw_RarManSimulateWords( Ssw_RarMan_t * p )
+{
+    int i, nWords = p->pPars->nWords;
+    int nStep = ((nWords + p->nProcs - 1) / p->nProcs + 7) & ~7;
+    if ( p->nProcs < 2 )
+    {
+        Ssw_RarManSimulateRange( p, 0, nWords );
+        return;
+    }
+    for ( i = 1; i < p->nProcs; i++ )
+    {
+        p->ThData[i].iStart   = Abc_MinInt( i * nStep, nWords );
+        p->ThData[i].iStop    = Abc_MinInt( (i + 1) * nStep, nWords );
+        p->ThData[i].fWorking = 1;
+    }
+    Ssw_RarManSimulateRange( p, 0, Abc_MinInt(nStep, nWords) );
+    // wait till threads finish
+    for ( i = 1; i < p->nProcs; i++ )
+        if ( p->ThData[i].fWorking )
+            i = 0;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Performs one round of simulation.]
@@ -651,9 +770,7 @@ int Ssw_RarManCheckNonConstOutputs( Ssw_RarMan_t * p, int iFrame, abctime Time )
 void Ssw_RarManSimulate( Ssw_RarMan_t * p, Vec_Int_t * vInit, int fUpdate, int fFirst )
 {
     Aig_Obj_t * pObj, * pRepr;
-    word * pSim, * pSim0, * pSim1;
-    word Flip, Flip0, Flip1;
-    int w, i;
+    int i;
     // initialize
     Ssw_RarManInitialize( p, vInit );
     Vec_PtrClear( p->vUpdConst );
@@ -678,46 +795,27 @@ void Ssw_RarManSimulate( Ssw_RarMan_t * p, Vec_Int_t * vInit, int fUpdate, int f
         }
     }
     // simulate
-    Aig_ManForEachNode( p->pAig, pObj, i )
+    Ssw_RarManSimulateWords( p );
+    // refine classes
+    if ( fUpdate )
     {
-        pSim  = Ssw_RarObjSim( p, Aig_ObjId(pObj) );
-        pSim0 = Ssw_RarObjSim( p, Aig_ObjFaninId0(pObj) );
-        pSim1 = Ssw_RarObjSim( p, Aig_ObjFaninId1(pObj) );
-        Flip0 = Aig_ObjFaninC0(pObj) ? ~(word)0 : 0;
-        Flip1 = Aig_ObjFaninC1(pObj) ? ~(word)0 : 0;
-        for ( w = 0; w < p->pPars->nWords; w++ )
-            pSim[w] = (Flip0 ^ pSim0[w]) & (Flip1 ^ pSim1[w]);
-
-
-        if ( !fUpdate )
-            continue;
         // check classes
-        pRepr = Aig_ObjRepr(p->pAig, pObj);
-        if ( pRepr == NULL || Aig_ObjIsTravIdCurrent( p->pAig, pRepr ) )
-            continue;
-        if ( Ssw_RarManObjsAreEqual( p, pObj, pRepr ) )
-            continue;
-        // save for update
-        if ( pRepr == Aig_ManConst1(p->pAig) )
-            Vec_PtrPush( p->vUpdConst, pObj );
-        else
+        Aig_ManForEachNode( p->pAig, pObj, i )
         {
-            Vec_PtrPush( p->vUpdClass, pRepr );
-            Aig_ObjSetTravIdCurrent( p->pAig, pRepr );
+            pRepr = Aig_ObjRepr(p->pAig, pObj);
+            if ( pRepr == NULL || Aig_ObjIsTravIdCurrent( p->pAig, pRepr ) )
+                continue;
+            if ( Ssw_RarManObjsAreEqual( p, pObj, pRepr ) )
+                continue;
+            // save for update
+            if ( pRepr == Aig_ManConst1(p->pAig) )
+                Vec_PtrPush( p->vUpdConst, pObj );
+            else
+            {
+                Vec_PtrPush( p->vUpdClass, pRepr );
+                Aig_ObjSetTravIdCurrent( p->pAig, pRepr );
+            }
         }
-    }
-    // transfer to POs
-    Aig_ManForEachCo( p->pAig, pObj, i )
-    {
-        pSim  = Ssw_RarObjSim( p, Aig_ObjId(pObj) );
-        pSim0 = Ssw_RarObjSim( p, Aig_ObjFaninId0(pObj) );
-        Flip  = Aig_ObjFaninC0(pObj) ? ~(word)0 : 0;
-        for ( w = 0; w < p->pPars->nWords; w++ )
-            pSim[w] = Flip ^ pSim0[w];
-    }
-    // refine classes
-    if ( fUpdate )
-    {
         if ( fFirst )
         {
             Vec_Ptr_t * vCands = Vec_PtrAlloc( 1000 );
@@ -751,6 +849,8 @@ void Ssw_RarManSimulate( Ssw_RarMan_t * p, Vec_Int_t * vInit, int fUpdate, int f
 static Ssw_RarMan_t * Ssw_RarManStart( Aig_Man_t * pAig, Ssw_RarPars_t * pPars )
 {
     Ssw_RarMan_t * p;
+    Aig_Obj_t * pObj;
+    int i, iLit0, iLit1;
 //    if ( Aig_ManRegNum(pAig) < nBinSize || nBinSize <= 0 )
 //        return NULL;
     p = ABC_CALLOC( Ssw_RarMan_t, 1 );
@@ -760,11 +860,45 @@ static Ssw_RarMan_t * Ssw_RarManStart( Aig_Man_t * pAig, Ssw_RarPars_t * pPars )
     p->pRarity   = ABC_CALLOC( int, (1 << pPars->nBinSize) * p->nGroups );
     p->pPatCosts = ABC_CALLOC( double, p->pPars->nWords * 64 );
     p->nWordsReg = Ssw_RarBitWordNum( Aig_ManRegNum(pAig) );
-    p->pObjData  = ABC_ALLOC( word, Aig_ManObjNumMax(pAig) * p->pPars->nWords );
+    // derive the compact AIG (the constant 1 of the AIG is stored after the last object)
+    p->pGia      = Gia_ManStart( Aig_ManObjNum(pAig) );
+    p->pObj2Sim  = ABC_FALLOC( int, Aig_ManObjNumMax(pAig) );
+    Aig_ManForEachObj( pAig, pObj, i )
+    {
+        if ( Aig_ObjIsAnd(pObj) )
+        {
+            iLit0 = Ssw_RarObjLit( p, Aig_ObjFanin0(pObj), Aig_ObjFaninC0(pObj) );
+            iLit1 = Ssw_RarObjLit( p, Aig_ObjFanin1(pObj), Aig_ObjFaninC1(pObj) );
+            p->pObj2Sim[i] = Abc_Lit2Var( Gia_ManAppendAnd( p->pGia, iLit0, iLit1 ) );
+        }
+        else if ( Aig_ObjIsCi(pObj) )
+            p->pObj2Sim[i] = Abc_Lit2Var( Gia_ManAppendCi( p->pGia ) );
+        else if ( Aig_ObjIsCo(pObj) )
+            p->pObj2Sim[i] = Abc_Lit2Var( Gia_ManAppendCo( p->pGia, Ssw_RarObjLit(p, Aig_ObjFanin0(pObj), Aig_ObjFaninC0(pObj)) ) );
+    }
+    p->pObj2Sim[0] = Gia_ManObjNum(p->pGia);
+    Gia_ManSetRegNum( p->pGia, Aig_ManRegNum(pAig) );
+    p->pObjData  = ABC_CALLOC( word, (Gia_ManObjNum(p->pGia) + 1) * p->pPars->nWords );
     p->pPatData  = ABC_ALLOC( word, 64 * p->pPars->nWords * p->nWordsReg );
     p->vUpdConst = Vec_PtrAlloc( 100 );
     p->vUpdClass = Vec_PtrAlloc( 100 );
     p->vPatBests = Vec_IntAlloc( 100 );
+    // start the threads
+    p->nProcs    = Abc_MinInt( Abc_MinInt(pPars->nProcs, SSW_RAR_PROC_MAX), (pPars->nWords + 7) / 8 );
+#ifdef ABC_USE_PTHREADS
+    for ( i = 1; i < p->nProcs; i++ )
+    {
+        int status;
+        p->ThData[i].p        = p;
+        p->ThData[i].iStart   = -1;
+        p->ThData[i].fWorking = 0;
+        status = pthread_create( p->WorkerThread + i, NULL, Ssw_RarWorkerThread, (void *)(p->ThData + i) );  assert( status == 0 );
+    }
+#else
+    if ( p->nProcs > 1 )
+        printf( "Multi-threading is not enabled; the simulation is performed in one thread.\n" );
+    p->nProcs    = 1;
+#endif
     return p;
 }
 
@@ -781,6 +915,20 @@ static Ssw_RarMan_t * Ssw_RarManStart( Aig_Man_t * pAig, Ssw_RarPars_t * pPars )
 ***********************************************************************/
 static void Ssw_RarManStop( Ssw_RarMan_t * p )
 {
+#ifdef ABC_USE_PTHREADS
+    int i, status;
+    for ( i = 1; i < p->nProcs; i++ )
+    {
+        assert( !p->ThData[i].fWorking );
+        p->ThData[i].iStart   = -1;
+        p->ThData[i].fWorking = 1;
+    }
+    for ( i = 1; i < p->nProcs; i++ )
+    {
+        status = pthread_join( p->WorkerThread[i], NULL );
+        assert( status == 0 );
+    }
+#endif
 //    Vec_PtrFreeP( &p->vCexes );
     if ( p->vCexes )
     {
@@ -793,6 +941,8 @@ static void Ssw_RarManStop( Ssw_RarMan_t * p )
     Vec_IntFreeP( &p->vPatBests );
     Vec_PtrFreeP( &p->vUpdConst );
     Vec_PtrFreeP( &p->vUpdClass );
+    Gia_ManStop( p->pGia );
+    ABC_FREE( p->pObj2Sim );
     ABC_FREE( p->pObjData );
     ABC_FREE( p->pPatData );
     ABC_FREE( p->pPatCosts );
@@ -117,6 +117,7 @@ struct Saig_ParBmc_t_
     int         nLearnedStart;  // starting learned clause limit
     int         nLearnedDelta;  // delta of learned clause limit
     int         nLearnedPerce;  // ratio of learned clause limit
+    int         nProcs;         // the number of threads in the multi-output mode
     int         fVerbose;       // verbose 
     int         fNotVerbose;    // skip line-by-line print-out 
     char *      pLogFileName;   // log file name
@@ -128,6 +129,7 @@ struct Saig_ParBmc_t_
     int(*pFuncOnFail)(int,Abc_Cex_t*); // called for a failed output in MO mode
     int         RunId;          // BMC id in this run 
     int(*pFuncStop)(int);       // callback to terminate
+    int(*pFuncIsSolved)(int);   // called to skip an output solved by another engine
 };
 
  
@@ -221,6 +223,8 @@ extern int               Saig_BmcPerform( Aig_Man_t * pAig, int nStart, int nFra
 /*=== bmcBmc3.c ==========================================================*/
 extern void              Saig_ParBmcSetDefaultParams( Saig_ParBmc_t * p );
 extern int               Saig_ManBmcScalable( Aig_Man_t * pAig, Saig_ParBmc_t * pPars );
+/*=== bmcBmc3Mt.c ========================================================*/
+extern int               Saig_ManBmcScalableMt( Aig_Man_t * pAig, Saig_ParBmc_t * pPars );
 /*=== bmcBmcAnd.c ==========================================================*/
 extern int               Gia_ManBmcPerform( Gia_Man_t * p, Bmc_AndPar_t * pPars );
 /*=== bmcCexCare.c ==========================================================*/
@@ -1347,6 +1347,7 @@ void Saig_ParBmcSetDefaultParams( Saig_ParBmc_t * p )
     p->nLearnedStart  = 10000;    // starting learned clause limit
     p->nLearnedDelta  =  2000;    // delta of learned clause limit
     p->nLearnedPerce  =    80;    // ratio of learned clause limit
+    p->nProcs         =     1;    // the number of threads
     p->fVerbose       =     0;    // verbose 
     p->fNotVerbose    =     0;    // skip line-by-line print-out 
     p->iFrame         =    -1;    // explored up to this frame
@@ -1471,6 +1472,14 @@ int Saig_ManBmcScalable( Aig_Man_t * pAig, Saig_ParBmc_t * pPars )
     abctime clk, clk2, clkSatRun, clkOther = 0, clkTotal = Abc_Clock();
     abctime nTimeUnsat = 0, nTimeSat = 0, nTimeUndec = 0, clkOne = 0;
     abctime nTimeToStopNG, nTimeToStop;
+    if ( pPars->nProcs > 1 && pPars->fSolveAll && Saig_ManPoNum(pAig) > 1 && Saig_ManConstrNum(pAig) == 0 )
+    {
+        // the log file and the bridge output are written by the serial engine
+        if ( pPars->pLogFileName == NULL && !pPars->fUseBridge )
+            return Saig_ManBmcScalableMt( pAig, pPars );
+        if ( !pPars->fUseBridge && !pPars->fSilent )
+            Abc_Print( 0, "The log file is written by one thread. Ignoring the number of threads (%d).\n", pPars->nProcs );
+    }
     if ( pPars->pLogFileName )
         pLogFile = fopen( pPars->pLogFileName, "wb" );
     if ( pPars->nTimeOutOne && pPars->nTimeOut == 0 )
@@ -1531,7 +1540,8 @@ int Saig_ManBmcScalable( Aig_Man_t * pAig, Saig_ParBmc_t * pPars )
         // stop BMC after exploring all reachable states
         if ( !pPars->nFramesJump && Aig_ManRegNum(pAig) < 30 && f == (1 << Aig_ManRegNum(pAig)) )
         {
-            Abc_Print( 1, "Stopping BMC because all 2^%d reachable states are visited.\n", Aig_ManRegNum(pAig) );
+            if ( !pPars->fSilent )
+                Abc_Print( 1, "Stopping BMC because all 2^%d reachable states are visited.\n", Aig_ManRegNum(pAig) );
             if ( p->pPars->fUseBridge )
                 Saig_ManForEachPo( pAig, pObj, i )
                     if ( !(p->vCexes && Vec_PtrEntry(p->vCexes, i)) && !(p->pTime4Outs && p->pTime4Outs[i] == 0) ) // not SAT and not timed out
@@ -1542,7 +1552,8 @@ int Saig_ManBmcScalable( Aig_Man_t * pAig, Saig_ParBmc_t * pPars )
         // stop BMC if all targets are solved
         if ( pPars->fSolveAll && pPars->nFailOuts + pPars->nDropOuts >= Saig_ManPoNum(pAig) )
         {
-            Abc_Print( 1, "Stopping BMC because all targets are disproved or timed out.\n" );
+            if ( !pPars->fSilent )
+                Abc_Print( 1, "Stopping BMC because all targets are disproved or timed out.\n" );
             RetValue = pPars->nFailOuts ? 0 : 1;
             goto finish;
         }
@@ -1635,6 +1646,9 @@ clkOther += Abc_Clock() - clk2;
             // skip solved outputs
             if ( p->vCexes && Vec_PtrEntry(p->vCexes, i) )
                 continue;
+            // skip outputs solved by another engine
+            if ( pPars->pFuncIsSolved && pPars->pFuncIsSolved(i) )
+                continue;
             // skip output whose time has run out
             if ( p->pTime4Outs && p->pTime4Outs[i] == 0 )
                 continue;
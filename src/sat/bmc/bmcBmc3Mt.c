@@ -0,0 +1,463 @@
+/**CFile****************************************************************
+
+  FileName    [bmcBmc3Mt.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [SAT-based bounded model checking.]
+
+  Synopsis    [Multi-threaded BMC solving groups of outputs in parallel.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: bmcBmc3Mt.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include "aig/saig/saig.h"
+#include "bmc.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+#define BMC3_MT_MAX  100    // the largest number of threads
+
+// the outputs are grouped by the overlap of their supports and the groups
+// are distributed among the threads; each thread runs the regular bmc3 on
+// the cone of its outputs, which keeps all the primary inputs of the AIG
+// (so that the counter-examples can be reused without remapping the inputs)
+// and the flops in the sequential cone of influence of the outputs
+
+typedef struct Bmc3_MtMan_t_ Bmc3_MtMan_t;
+struct Bmc3_MtMan_t_
+{
+    Aig_Man_t *       pAig;           // the user's AIG
+    Saig_ParBmc_t *   pPars;          // the user's parameters
+    Vec_Ptr_t *       vCexes;         // the status of each output
+    int               nFailOuts;      // the number of failed outputs
+    int               nOutDigits;     // the number of digits in the output number
+    volatile int      fStop;          // the threads should stop
+    int(*pFuncStop)(int);             // the user's callback to terminate
+    int               RunIdUser;      // the user's run ID
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_t   Mutex;          // the lock
+#endif
+};
+
+typedef struct Bmc3_MtThData_t_
+{
+    Bmc3_MtMan_t *    p;              // the shared data
+    Aig_Man_t *       pAig;           // the cone of this thread
+    Vec_Int_t *       vOuts;          // the original numbers of the outputs
+    Saig_ParBmc_t     Pars;           // the parameters of this thread
+    int               RetValue;       // the result
+} Bmc3_MtThData_t;
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Groups the outputs for the given number of threads.]
+
+  Description [Returns the array of groups, each containing the numbers
+  of the primary outputs. The partitions derived by the smart partitioning
+  are assigned to the groups, starting from the largest partitions and
+  always adding to the group with the smallest total support.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Ptr_t * Saig_ManBmcMtGroupOutputs( Aig_Man_t * pAig, int nGroups )
+{
+    Vec_Ptr_t * vParts, * vPartSupps, * vGroups;
+    Vec_Int_t * vPart, * vSupp, * vGroup;
+    int i, k, iCo, iBest, nPos, * pCosts, * pOrder, * pWeights;
+    // keep the partitions small enough to be balanced among the groups
+    int nSuppSizeLimit = Abc_MaxInt( 2, Aig_ManCiNum(pAig) / (4 * nGroups) );
+    vParts = Aig_ManPartitionSmart( pAig, nSuppSizeLimit, 0, &vPartSupps );
+    // the support computation overwrites the CI/CO numbers
+    Aig_ManSetCioIds( pAig );
+    // the compaction does not shrink the array of supports
+    pCosts = ABC_CALLOC( int, Vec_PtrSize(vParts) );
+    Vec_PtrForEachEntryStop( Vec_Int_t *, vPartSupps, vSupp, i, Vec_PtrSize(vParts) )
+        pCosts[i] = -Vec_IntSize(vSupp);
+    pOrder = Abc_MergeSortCost( pCosts, Vec_PtrSize(vParts) );
+    // distribute the partitions
+    vGroups = Vec_PtrAlloc( nGroups );
+    for ( i = 0; i < nGroups; i++ )
+        Vec_PtrPush( vGroups, Vec_IntAlloc(0) );
+    pWeights = ABC_CALLOC( int, nGroups );
+    for ( i = 0; i < Vec_PtrSize(vParts); i++ )
+    {
+        vPart = (Vec_Int_t *)Vec_PtrEntry( vParts, pOrder[i] );
+        iBest = 0;
+        for ( k = 1; k < nGroups; k++ )
+            if ( pWeights[iBest] > pWeights[k] )
+                iBest = k;
+        vGroup = (Vec_Int_t *)Vec_PtrEntry( vGroups, iBest );
+        nPos = Vec_IntSize( vGroup );
+        Vec_IntForEachEntry( vPart, iCo, k )
+            if ( iCo < Saig_ManPoNum(pAig) )
+                Vec_IntPush( vGroup, iCo );
+        // the partitions containing only flop inputs are skipped
+        if ( Vec_IntSize(vGroup) > nPos )
+            pWeights[iBest] -= pCosts[pOrder[i]];
+    }
+    ABC_FREE( pWeights );
+    ABC_FREE( pOrder );
+    ABC_FREE( pCosts );
+    // remove empty groups and sort the outputs
+    k = 0;
+    Vec_PtrForEachEntry( Vec_Int_t *, vGroups, vGroup, i )
+        if ( Vec_IntSize(vGroup) == 0 )
+            Vec_IntFree( vGroup );
+        else
+        {
+            Vec_IntSort( vGroup, 0 );
+            Vec_PtrWriteEntry( vGroups, k++, vGroup );
+        }
+    Vec_PtrShrink( vGroups, k );
+    Vec_VecFree( (Vec_Vec_t *)vParts );
+    Vec_VecFree( (Vec_Vec_t *)vPartSupps );
+    return vGroups;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the cone of the given outputs.]
+
+  Description [Similar to Saig_ManDupCones() but keeps all PIs in the
+  original order, so that the counter-examples of the cone are also
+  the counter-examples of the original AIG.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Aig_Man_t * Saig_ManBmcMtDupCone( Aig_Man_t * pAig, Vec_Int_t * vOuts )
+{
+    extern void Saig_ManDupCones_rec( Aig_Man_t * p, Aig_Obj_t * pObj, Vec_Ptr_t * vLeaves, Vec_Ptr_t * vNodes, Vec_Ptr_t * vRoots );
+    Aig_Man_t * pAigNew;
+    Vec_Ptr_t * vLeaves, * vNodes, * vRoots;
+    Aig_Obj_t * pObj;
+    int i, iOut;
+    // collect the cone
+    vLeaves = Vec_PtrAlloc( 100 );
+    vNodes  = Vec_PtrAlloc( 100 );
+    vRoots  = Vec_PtrAlloc( 100 );
+    Vec_IntForEachEntry( vOuts, iOut, i )
+        Vec_PtrPush( vRoots, Aig_ManCo(pAig, iOut) );
+    Aig_ManIncrementTravId( pAig );
+    Aig_ObjSetTravIdCurrent( pAig, Aig_ManConst1(pAig) );
+    Vec_PtrForEachEntry( Aig_Obj_t *, vRoots, pObj, i )
+        Saig_ManDupCones_rec( pAig, pObj, vLeaves, vNodes, vRoots );
+    // start the new manager
+    pAigNew = Aig_ManStart( Vec_PtrSize(vNodes) );
+    pAigNew->pName = Abc_UtilStrsav( pAig->pName );
+    Aig_ManConst1(pAig)->pData = Aig_ManConst1( pAigNew );
+    Saig_ManForEachPi( pAig, pObj, i )
+        pObj->pData = Aig_ObjCreateCi( pAigNew );
+    Vec_PtrForEachEntryStart( Aig_Obj_t *, vRoots, pObj, i, Vec_IntSize(vOuts) )
+        Saig_ObjLiToLo(pAig, pObj)->pData = Aig_ObjCreateCi( pAigNew );
+    Vec_PtrForEachEntry( Aig_Obj_t *, vNodes, pObj, i )
+        pObj->pData = Aig_And( pAigNew, Aig_ObjChild0Copy(pObj), Aig_ObjChild1Copy(pObj) );
+    Vec_PtrForEachEntry( Aig_Obj_t *, vRoots, pObj, i )
+        Aig_ObjCreateCo( pAigNew, Aig_ObjChild0Copy(pObj) );
+    Aig_ManSetRegNum( pAigNew, Vec_PtrSize(vRoots) - Vec_IntSize(vOuts) );
+    Vec_PtrFree( vLeaves );
+    Vec_PtrFree( vNodes );
+    Vec_PtrFree( vRoots );
+    return pAigNew;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Records the failed output of the original AIG.]
+
+  Description [Returns 1 if the output is recorded for the first time.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Saig_ManBmcMtRecord( Bmc3_MtMan_t * p, int iOut, Abc_Cex_t * pCex )
+{
+    Abc_Cex_t * pCexNew;
+    if ( Vec_PtrEntry(p->vCexes, iOut) )
+        return 0;
+    pCexNew = pCex ? Abc_CexDup( pCex, Saig_ManRegNum(p->pAig) ) : (Abc_Cex_t *)(ABC_PTRINT_T)1;
+    if ( pCexNew != (Abc_Cex_t *)(ABC_PTRINT_T)1 )
+        pCexNew->iPo = iOut;
+    Vec_PtrWriteEntry( p->vCexes, iOut, pCexNew );
+    p->nFailOuts++;
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Collects the results of the threads.]
+
+  Description [Adds the outputs failed by the same counter-examples,
+  which were not reported through the callback, and updates the user's
+  parameters.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Saig_ManBmcMtCollect( Bmc3_MtMan_t * p, Bmc3_MtThData_t * pThData, int nThreads )
+{
+    Saig_ParBmc_t * pPars = p->pPars;
+    Abc_Cex_t * pCex;
+    int i, k, iFrameMin = ABC_INFINITY, iFrameMax = -1, nProved = 0, RetValue;
+    pPars->nDropOuts = 0;
+    for ( i = 0; i < nThreads; i++ )
+    {
+        Bmc3_MtThData_t * pTh = pThData + i;
+        if ( pTh->pAig->vSeqModelVec )
+        Vec_PtrForEachEntry( Abc_Cex_t *, pTh->pAig->vSeqModelVec, pCex, k )
+            if ( pCex && Saig_ManBmcMtRecord( p, Vec_IntEntry(pTh->vOuts, k), pCex == (Abc_Cex_t *)(ABC_PTRINT_T)1 ? NULL : pCex ) && !pPars->fNotVerbose )
+                Abc_Print( 1, "Output %*d was asserted in frame %2d (solved %*d out of %*d outputs).\n",
+                    p->nOutDigits, Vec_IntEntry(pTh->vOuts, k), pTh->Pars.iFrame+1, p->nOutDigits, p->nFailOuts, p->nOutDigits, Saig_ManPoNum(p->pAig) );
+        pPars->nDropOuts += pTh->Pars.nDropOuts;
+        pPars->timeLastSolved = Abc_MaxInt( pPars->timeLastSolved, pTh->Pars.timeLastSolved );
+        nProved += (pTh->RetValue == 1);
+        iFrameMax = Abc_MaxInt( iFrameMax, pTh->Pars.iFrame );
+        // the depth is limited by the threads with unsolved outputs
+        if ( pTh->Pars.nFailOuts + pTh->Pars.nDropOuts < Saig_ManPoNum(pTh->pAig) )
+            iFrameMin = Abc_MinInt( iFrameMin, pTh->Pars.iFrame );
+    }
+    pPars->nFailOuts = p->nFailOuts;
+    pPars->iFrame    = iFrameMin < ABC_INFINITY ? iFrameMin : iFrameMax;
+    RetValue = p->nFailOuts ? 0 : (nProved == nThreads ? 1 : -1);
+    assert( p->pAig->vSeqModelVec == NULL );
+    p->pAig->vSeqModelVec = p->vCexes;
+    p->vCexes = NULL;
+    return RetValue;
+}
+
+#ifndef ABC_USE_PTHREADS
+
+int Saig_ManBmcScalableMt( Aig_Man_t * pAig, Saig_ParBmc_t * pPars )
+{
+    Saig_ParBmc_t Pars = *pPars;
+    Pars.nProcs = 1;
+    return Saig_ManBmcScalable( pAig, &Pars );
+}
+
+#else // pthreads are used
+
+static ABC_THREAD_LOCAL Bmc3_MtThData_t * s_pBmc3ThData = NULL; // the data of this thread
+
+/**Function*************************************************************
+
+  Synopsis    [Callbacks used by the threads.]
+
+  Description [Translate the outputs of the cone into the outputs
+  of the original AIG before calling the user's callbacks.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Saig_ManBmcMtCallBackToStop( int RunId )
+{
+    Bmc3_MtMan_t * p = s_pBmc3ThData->p;
+    return p->fStop || (p->pFuncStop && p->pFuncStop(p->RunIdUser));
+}
+int Saig_ManBmcMtCallBackIsSolved( int iOut )
+{
+    Bmc3_MtThData_t * pTh = s_pBmc3ThData;
+    return pTh->p->pPars->pFuncIsSolved( Vec_IntEntry(pTh->vOuts, iOut) );
+}
+int Saig_ManBmcMtCallBackOnFail( int iOut, Abc_Cex_t * pCex )
+{
+    Bmc3_MtThData_t * pTh = s_pBmc3ThData;
+    Bmc3_MtMan_t * p = pTh->p;
+    Abc_Cex_t * pCexUser;
+    int iOutUser = Vec_IntEntry( pTh->vOuts, iOut ), fStop = 0;
+    pthread_mutex_lock( &p->Mutex );
+    if ( Saig_ManBmcMtRecord( p, iOutUser, pCex ) )
+    {
+        if ( !p->pPars->fNotVerbose )
+            Abc_Print( 1, "Output %*d was asserted in frame %2d (solved %*d out of %*d outputs).\n",
+                p->nOutDigits, iOutUser, pTh->Pars.iFrame+1, p->nOutDigits, p->nFailOuts, p->nOutDigits, Saig_ManPoNum(p->pAig) );
+        pCexUser = (Abc_Cex_t *)Vec_PtrEntry( p->vCexes, iOutUser );
+        if ( p->pPars->pFuncOnFail && p->pPars->pFuncOnFail(iOutUser, pCex ? pCexUser : NULL) )
+        {
+            fStop = 1;
+            p->fStop = 1;
+        }
+    }
+    pthread_mutex_unlock( &p->Mutex );
+    return fStop;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs one thread.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void * Saig_ManBmcMtWorkerThread( void * pArg )
+{
+    Bmc3_MtThData_t * pThData = (Bmc3_MtThData_t *)pArg;
+    s_pBmc3ThData = pThData;
+    pThData->RetValue = Saig_ManBmcScalable( pThData->pAig, &pThData->Pars );
+    s_pBmc3ThData = NULL;
+    pthread_exit( NULL );
+    assert( 0 );
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs BMC on groups of outputs in parallel.]
+
+  Description [Used with the multi-output mode (-a). The outputs are
+  divided into groups with overlapping supports, and each group is solved
+  by the regular bmc3 in its own thread and its own SAT solver. The failed
+  outputs are reported through the callback as soon as they are found, and
+  the counter-examples are collected in pAig->vSeqModelVec.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Saig_ManBmcScalableMt( Aig_Man_t * pAig, Saig_ParBmc_t * pPars )
+{
+    Bmc3_MtThData_t ThData[BMC3_MT_MAX];
+    pthread_t WorkerThread[BMC3_MT_MAX];
+    Bmc3_MtMan_t * p;
+    Vec_Ptr_t * vGroups;
+    Vec_Int_t * vOuts;
+    Abc_Cex_t * pCex;
+    abctime clkTotal = Abc_Clock();
+    int i, status, RetValue, nThreads;
+    assert( pPars->fSolveAll );
+    if ( pPars->nTimeOutOne && pPars->nTimeOut == 0 )
+        pPars->nTimeOut = pPars->nTimeOutOne * Saig_ManPoNum(pAig) / 1000 + 1;
+    vGroups = Saig_ManBmcMtGroupOutputs( pAig, Abc_MinInt(pPars->nProcs, BMC3_MT_MAX) );
+    if ( Vec_PtrSize(vGroups) < 2 )
+    {
+        Saig_ParBmc_t Pars = *pPars;
+        Vec_VecFree( (Vec_Vec_t *)vGroups );
+        if ( pPars->fVerbose )
+            Abc_Print( 1, "The outputs cannot be divided among the threads. Running one thread.\n" );
+        Pars.nProcs = 1;
+        RetValue = Saig_ManBmcScalable( pAig, &Pars );
+        pPars->iFrame    = Pars.iFrame;
+        pPars->nFailOuts = Pars.nFailOuts;
+        pPars->nDropOuts = Pars.nDropOuts;
+        pPars->timeLastSolved = Pars.timeLastSolved;
+        return RetValue;
+    }
+    nThreads = Vec_PtrSize(vGroups);
+    p = ABC_CALLOC( Bmc3_MtMan_t, 1 );
+    p->pAig       = pAig;
+    p->pPars      = pPars;
+    p->vCexes     = Vec_PtrStart( Saig_ManPoNum(pAig) );
+    p->nOutDigits = Abc_Base10Log( Saig_ManPoNum(pAig) );
+    pthread_mutex_init( &p->Mutex, NULL );
+    p->pFuncStop  = pPars->pFuncStop;
+    p->RunIdUser  = pPars->RunId;
+    if ( pPars->fVerbose )
+        Abc_Print( 1, "Running \"bmc3\" with %d threads. PI/PO/Reg = %d/%d/%d. And =%7d.\n",
+            nThreads, Saig_ManPiNum(pAig), Saig_ManPoNum(pAig), Saig_ManRegNum(pAig), Aig_ManNodeNum(pAig) );
+    Vec_PtrForEachEntry( Vec_Int_t *, vGroups, vOuts, i )
+    {
+        ThData[i].p        = p;
+        ThData[i].pAig     = Saig_ManBmcMtDupCone( pAig, vOuts );
+        ThData[i].vOuts    = vOuts;
+        ThData[i].Pars     = *pPars;
+        ThData[i].RetValue = -1;
+        ThData[i].Pars.nProcs         = 1;
+        ThData[i].Pars.fVerbose       = 0;
+        ThData[i].Pars.fNotVerbose    = 1;
+        ThData[i].Pars.fSilent        = 1;
+        ThData[i].Pars.fUseBridge     = 0;
+        ThData[i].Pars.pLogFileName   = NULL;
+        ThData[i].Pars.pFuncStop      = Saig_ManBmcMtCallBackToStop;
+        ThData[i].Pars.pFuncOnFail    = Saig_ManBmcMtCallBackOnFail;
+        ThData[i].Pars.pFuncIsSolved  = pPars->pFuncIsSolved ? Saig_ManBmcMtCallBackIsSolved : NULL;
+        if ( pPars->fVerbose )
+            Abc_Print( 1, "Thread %2d :  PO =%6d  Reg =%7d  And =%8d\n", i,
+                Saig_ManPoNum(ThData[i].pAig), Saig_ManRegNum(ThData[i].pAig), Aig_ManNodeNum(ThData[i].pAig) );
+    }
+    for ( i = 0; i < nThreads; i++ )
+    {
+        status = pthread_create( WorkerThread + i, NULL, Saig_ManBmcMtWorkerThread, (void *)(ThData + i) );
+        assert( status == 0 );
+    }
+    for ( i = 0; i < nThreads; i++ )
+    {
+        status = pthread_join( WorkerThread[i], NULL );
+        assert( status == 0 );
+    }
+    RetValue = Saig_ManBmcMtCollect( p, ThData, nThreads );
+    if ( pPars->fVerbose )
+    {
+        for ( i = 0; i < nThreads; i++ )
+            Abc_Print( 1, "Thread %2d :  Frame =%5d  CEX =%6d  T/O =%6d  %s\n", i, ThData[i].Pars.iFrame+1,
+                ThData[i].Pars.nFailOuts, ThData[i].Pars.nDropOuts, ThData[i].RetValue == 1 ? "proved" : (ThData[i].RetValue == 0 ? "disproved" : "undecided") );
+        Abc_PrintTime( 1, "Total time", Abc_Clock() - clkTotal );
+    }
+    for ( i = 0; i < nThreads; i++ )
+    {
+        if ( ThData[i].pAig->vSeqModelVec )
+        {
+            Vec_PtrForEachEntry( Abc_Cex_t *, ThData[i].pAig->vSeqModelVec, pCex, status )
+                if ( pCex != (Abc_Cex_t *)(ABC_PTRINT_T)1 )
+                    ABC_FREE( pCex );
+            Vec_PtrFree( ThData[i].pAig->vSeqModelVec );
+            ThData[i].pAig->vSeqModelVec = NULL;
+        }
+        Aig_ManStop( ThData[i].pAig );
+    }
+    pthread_mutex_destroy( &p->Mutex );
+    ABC_FREE( p );
+    Vec_VecFree( (Vec_Vec_t *)vGroups );
+    fflush( stdout );
+    return RetValue;
+}
+
+#endif // pthreads are used
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
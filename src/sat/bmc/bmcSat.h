@@ -0,0 +1,324 @@
+/**CFile****************************************************************
+
+  FileName    [bmcSat.h]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [SAT-based bounded model checking.]
+
+  Synopsis    [Uniform interface to the incremental SAT solvers.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: bmcSat.h,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#ifndef ABC___sat_bmc_BMC_SAT_h
+#define ABC___sat_bmc_BMC_SAT_h
+
+
+////////////////////////////////////////////////////////////////////////
+///                          INCLUDES                                ///
+////////////////////////////////////////////////////////////////////////
+
+#include "misc/vec/vec.h"
+#include "sat/bsat/satSolver.h"
+#include "sat/satoko/satoko.h"
+#include "sat/glucose2/AbcGlucose2.h"
+
+////////////////////////////////////////////////////////////////////////
+///                         PARAMETERS                               ///
+////////////////////////////////////////////////////////////////////////
+
+ABC_NAMESPACE_HEADER_START
+
+// the engines written against this interface select the back-end
+// at run time instead of being duplicated for each solver (compare
+// bmcBmcS.c and bmcBmcG.c); the calls are dispatched by inline switches,
+// so there is no overhead beyond one branch per call
+
+// the literals and the results follow the conventions of ABC:
+// literal = 2 * var + compl, the result is 1 (SAT), -1 (UNSAT) or 0 (undecided);
+// the final conflict is the clause of the negated assumption literals
+
+// the clause groups are implemented using activation variables:
+// the clauses added after Bmc_SatPush() get the negative literal of
+// the activation variable of the group, which is assumed in each call
+// while the group is active; Bmc_SatPop() adds this literal as a unit
+
+typedef enum {
+    BMC_SAT_BSAT = 0,                  // 0: MiniSat-based solver in "sat/bsat"
+    BMC_SAT_SATOKO,                    // 1: Satoko
+    BMC_SAT_GLUCOSE2,                  // 2: Glucose in "sat/glucose2"
+    BMC_SAT_NONE                       // 3: not used
+} Bmc_SatType_t;
+
+typedef struct Bmc_Sat_t_ Bmc_Sat_t;
+struct Bmc_Sat_t_
+{
+    Bmc_SatType_t     Type;            // the back-end
+    void *            pSat;            // the solver
+    ABC_INT64_T       nConfLimit;      // conflict limit for one call (0 = no limit)
+    ABC_INT64_T       nPropLimit;      // propagation limit for one call (0 = no limit)
+    Vec_Int_t         vActs;           // activation variables of the active groups
+    Vec_Int_t         vLits;           // clause/assumption literals
+    Vec_Int_t         vFinal;          // the final conflict without activation literals
+    // statistics
+    int               nCalls;          // the number of calls
+    int               nCallsSat;       // the number of satisfiable calls
+    int               nCallsUnsat;     // the number of unsatisfiable calls
+    int               nCallsUndec;     // the number of undecided calls
+};
+
+////////////////////////////////////////////////////////////////////////
+///                       MACRO DEFINITIONS                          ///
+////////////////////////////////////////////////////////////////////////
+
+static inline char * Bmc_SatTypeName( Bmc_SatType_t Type )
+{
+    if ( Type == BMC_SAT_BSAT )     return "bsat";
+    if ( Type == BMC_SAT_SATOKO )   return "satoko";
+    if ( Type == BMC_SAT_GLUCOSE2 ) return "glucose2";
+    return NULL;
+}
+static inline Bmc_SatType_t Bmc_SatTypeFromName( char * pName )
+{
+    int Type;
+    for ( Type = 0; Type < BMC_SAT_NONE; Type++ )
+        if ( !strcmp(pName, Bmc_SatTypeName((Bmc_SatType_t)Type)) )
+            return (Bmc_SatType_t)Type;
+    return BMC_SAT_NONE;
+}
+
+static inline Bmc_Sat_t * Bmc_SatStart( Bmc_SatType_t Type )
+{
+    Bmc_Sat_t * p = ABC_CALLOC( Bmc_Sat_t, 1 );
+    p->Type = Type;
+    if ( Type == BMC_SAT_BSAT )
+        p->pSat = sat_solver_new();
+    else if ( Type == BMC_SAT_SATOKO )
+        p->pSat = satoko_create();
+    else if ( Type == BMC_SAT_GLUCOSE2 )
+        p->pSat = bmcg2_sat_solver_start();
+    else assert( 0 );
+    return p;
+}
+static inline void Bmc_SatStop( Bmc_Sat_t * p )
+{
+    if ( p->Type == BMC_SAT_BSAT )
+        sat_solver_delete( (sat_solver *)p->pSat );
+    else if ( p->Type == BMC_SAT_SATOKO )
+        satoko_destroy( (satoko_t *)p->pSat );
+    else if ( p->Type == BMC_SAT_GLUCOSE2 )
+        bmcg2_sat_solver_stop( (bmcg2_sat_solver *)p->pSat );
+    Vec_IntErase( &p->vActs );
+    Vec_IntErase( &p->vLits );
+    Vec_IntErase( &p->vFinal );
+    ABC_FREE( p );
+}
+
+// variables
+static inline int Bmc_SatAddVar( Bmc_Sat_t * p )
+{
+    if ( p->Type == BMC_SAT_BSAT )
+        return sat_solver_addvar( (sat_solver *)p->pSat );
+    if ( p->Type == BMC_SAT_SATOKO )
+        return satoko_add_variable( (satoko_t *)p->pSat, 0 );
+    return bmcg2_sat_solver_addvar( (bmcg2_sat_solver *)p->pSat );
+}
+static inline void Bmc_SatSetNVars( Bmc_Sat_t * p, int nVars )
+{
+    if ( p->Type == BMC_SAT_BSAT )
+        sat_solver_setnvars( (sat_solver *)p->pSat, nVars );
+    else if ( p->Type == BMC_SAT_SATOKO )
+        satoko_setnvars( (satoko_t *)p->pSat, nVars );
+    else
+        bmcg2_sat_solver_set_nvars( (bmcg2_sat_solver *)p->pSat, nVars );
+}
+
+// clauses (return 0 if the problem is trivially UNSAT)
+static inline int Bmc_SatAddClauseInt( Bmc_Sat_t * p, int * pLits, int nLits )
+{
+    if ( p->Type == BMC_SAT_BSAT )
+        return sat_solver_addclause( (sat_solver *)p->pSat, pLits, pLits + nLits );
+    if ( p->Type == BMC_SAT_SATOKO )
+        return satoko_add_clause( (satoko_t *)p->pSat, pLits, nLits );
+    return bmcg2_sat_solver_addclause( (bmcg2_sat_solver *)p->pSat, pLits, nLits );
+}
+static inline int Bmc_SatAddClause( Bmc_Sat_t * p, int * pLits, int nLits )
+{
+    if ( Vec_IntSize(&p->vActs) == 0 )
+        return Bmc_SatAddClauseInt( p, pLits, nLits );
+    Vec_IntClear( &p->vLits );
+    Vec_IntPushArray( &p->vLits, pLits, nLits );
+    Vec_IntPush( &p->vLits, Abc_Var2Lit(Vec_IntEntryLast(&p->vActs), 1) );
+    return Bmc_SatAddClauseInt( p, Vec_IntArray(&p->vLits), Vec_IntSize(&p->vLits) );
+}
+
+// clause groups
+static inline int Bmc_SatPush( Bmc_Sat_t * p )
+{
+    Vec_IntPush( &p->vActs, Bmc_SatAddVar(p) );
+    return Vec_IntSize( &p->vActs );
+}
+static inline int Bmc_SatPop( Bmc_Sat_t * p )
+{
+    int Lit = Abc_Var2Lit( Vec_IntPop(&p->vActs), 1 );
+    return Bmc_SatAddClauseInt( p, &Lit, 1 );
+}
+static inline int Bmc_SatGroupNum( Bmc_Sat_t * p )
+{
+    return Vec_IntSize( &p->vActs );
+}
+
+// resource limits (the limits apply to each call; 0 means no limit)
+static inline void Bmc_SatSetConfLimit( Bmc_Sat_t * p, ABC_INT64_T nConfLimit )
+{
+    p->nConfLimit = nConfLimit;
+}
+static inline void Bmc_SatSetPropLimit( Bmc_Sat_t * p, ABC_INT64_T nPropLimit )
+{
+    p->nPropLimit = nPropLimit;
+}
+static inline abctime Bmc_SatSetRuntimeLimit( Bmc_Sat_t * p, abctime Limit )
+{
+    if ( p->Type == BMC_SAT_BSAT )
+        return sat_solver_set_runtime_limit( (sat_solver *)p->pSat, Limit );
+    if ( p->Type == BMC_SAT_SATOKO )
+        return satoko_set_runtime_limit( (satoko_t *)p->pSat, Limit );
+    return bmcg2_sat_solver_set_runtime_limit( (bmcg2_sat_solver *)p->pSat, Limit );
+}
+
+// solving under assumptions
+static inline int Bmc_SatSolveInt( Bmc_Sat_t * p, int * pLits, int nLits )
+{
+    if ( p->Type == BMC_SAT_BSAT )
+        return sat_solver_solve( (sat_solver *)p->pSat, pLits, pLits + nLits, p->nConfLimit, p->nPropLimit, 0, 0 );
+    if ( p->Type == BMC_SAT_SATOKO )
+    {
+        satoko_t * pSat = (satoko_t *)p->pSat;
+        satoko_opts_t * pOpts = satoko_options( pSat );
+        // Satoko resets the statistics of the current call before solving
+        pOpts->conf_limit = (long)p->nConfLimit;
+        pOpts->prop_limit = (long)p->nPropLimit;
+        return satoko_solve_assumptions( pSat, pLits, nLits );
+    }
+    else
+    {
+        bmcg2_sat_solver * pSat = (bmcg2_sat_solver *)p->pSat;
+        bmcg2_sat_solver_set_conflict_budget( pSat, (int)p->nConfLimit );
+        bmcg2_sat_solver_set_prop_budget( pSat, p->nPropLimit );
+        return bmcg2_sat_solver_solve( pSat, pLits, nLits );
+    }
+}
+static inline int Bmc_SatSolve( Bmc_Sat_t * p, int * pLits, int nLits )
+{
+    int i, iVar, RetValue;
+    if ( Vec_IntSize(&p->vActs) == 0 )
+        RetValue = Bmc_SatSolveInt( p, pLits, nLits );
+    else
+    {
+        Vec_IntClear( &p->vLits );
+        Vec_IntForEachEntry( &p->vActs, iVar, i )
+            Vec_IntPush( &p->vLits, Abc_Var2Lit(iVar, 0) );
+        Vec_IntPushArray( &p->vLits, pLits, nLits );
+        RetValue = Bmc_SatSolveInt( p, Vec_IntArray(&p->vLits), Vec_IntSize(&p->vLits) );
+    }
+    p->nCalls++;
+    p->nCallsSat   += (RetValue ==  1);
+    p->nCallsUnsat += (RetValue == -1);
+    p->nCallsUndec += (RetValue ==  0);
+    return RetValue;
+}
+
+// results of the last call
+static inline int Bmc_SatVarValue( Bmc_Sat_t * p, int iVar )
+{
+    if ( p->Type == BMC_SAT_BSAT )
+        return sat_solver_var_value( (sat_solver *)p->pSat, iVar );
+    if ( p->Type == BMC_SAT_SATOKO )
+        return satoko_read_cex_varvalue( (satoko_t *)p->pSat, iVar );
+    return bmcg2_sat_solver_read_cex_varvalue( (bmcg2_sat_solver *)p->pSat, iVar );
+}
+static inline int Bmc_SatFinal( Bmc_Sat_t * p, int ** ppLits )
+{
+    int i, nLits;
+    if ( p->Type == BMC_SAT_BSAT )
+        nLits = sat_solver_final( (sat_solver *)p->pSat, ppLits );
+    else if ( p->Type == BMC_SAT_SATOKO )
+        nLits = satoko_final_conflict( (satoko_t *)p->pSat, ppLits );
+    else
+        nLits = bmcg2_sat_solver_final( (bmcg2_sat_solver *)p->pSat, ppLits );
+    if ( Vec_IntSize(&p->vActs) == 0 )
+        return nLits;
+    // remove the literals of the activation variables
+    Vec_IntClear( &p->vFinal );
+    for ( i = 0; i < nLits; i++ )
+        if ( Vec_IntFind(&p->vActs, Abc_Lit2Var((*ppLits)[i])) == -1 )
+            Vec_IntPush( &p->vFinal, (*ppLits)[i] );
+    *ppLits = Vec_IntArray( &p->vFinal );
+    return Vec_IntSize( &p->vFinal );
+}
+
+// statistics
+static inline int Bmc_SatVarNum( Bmc_Sat_t * p )
+{
+    if ( p->Type == BMC_SAT_BSAT )
+        return sat_solver_nvars( (sat_solver *)p->pSat );
+    if ( p->Type == BMC_SAT_SATOKO )
+        return satoko_varnum( (satoko_t *)p->pSat );
+    return bmcg2_sat_solver_varnum( (bmcg2_sat_solver *)p->pSat );
+}
+static inline int Bmc_SatClauseNum( Bmc_Sat_t * p )
+{
+    if ( p->Type == BMC_SAT_BSAT )
+        return sat_solver_nclauses( (sat_solver *)p->pSat );
+    if ( p->Type == BMC_SAT_SATOKO )
+        return satoko_clausenum( (satoko_t *)p->pSat );
+    return bmcg2_sat_solver_clausenum( (bmcg2_sat_solver *)p->pSat );
+}
+static inline ABC_INT64_T Bmc_SatConfNum( Bmc_Sat_t * p )
+{
+    if ( p->Type == BMC_SAT_BSAT )
+        return ((sat_solver *)p->pSat)->stats.conflicts;
+    if ( p->Type == BMC_SAT_SATOKO )
+        return satoko_stats( (satoko_t *)p->pSat )->n_conflicts_all;
+    return bmcg2_sat_solver_conflictnum( (bmcg2_sat_solver *)p->pSat );
+}
+static inline ABC_INT64_T Bmc_SatPropNum( Bmc_Sat_t * p )
+{
+    if ( p->Type == BMC_SAT_BSAT )
+        return ((sat_solver *)p->pSat)->stats.propagations;
+    if ( p->Type == BMC_SAT_SATOKO )
+        return satoko_stats( (satoko_t *)p->pSat )->n_propagations_all;
+    return bmcg2_sat_solver_propagationnum( (bmcg2_sat_solver *)p->pSat );
+}
+static inline void Bmc_SatPrintStats( Bmc_Sat_t * p )
+{
+    printf( "%-8s : ", Bmc_SatTypeName(p->Type) );
+    printf( "Var =%9d  ",  Bmc_SatVarNum(p) );
+    printf( "Cla =%9d  ",  Bmc_SatClauseNum(p) );
+    printf( "Conf =%10.0f  ", (double)Bmc_SatConfNum(p) );
+    printf( "Prop =%12.0f  ", (double)Bmc_SatPropNum(p) );
+    printf( "Calls =%7d (Sat =%7d  Unsat =%7d  Undec =%5d)\n", p->nCalls, p->nCallsSat, p->nCallsUnsat, p->nCallsUndec );
+}
+
+////////////////////////////////////////////////////////////////////////
+///                    FUNCTION DECLARATIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+ABC_NAMESPACE_HEADER_END
+
+
+
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
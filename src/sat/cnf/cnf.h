@@ -51,6 +51,7 @@ ABC_NAMESPACE_HEADER_START
 typedef struct Cnf_Man_t_            Cnf_Man_t;
 typedef struct Cnf_Dat_t_            Cnf_Dat_t;
 typedef struct Cnf_Cut_t_            Cnf_Cut_t;
+typedef struct Cnf_FastMan_t_        Cnf_FastMan_t;
 
 // the CNF asserting outputs of AIG to be 1
 struct Cnf_Dat_t_
@@ -93,6 +94,21 @@ struct Cnf_Man_t_
     abctime         timeSave;
 };
 
+// the incremental fast CNF computation manager
+struct Cnf_FastMan_t_
+{
+    Vec_Mem_t *     vTtMem;          // hashed truth tables of the cuts (with the number of leaves)
+    Vec_Wec_t *     vTtIsops;        // for each truth table, the onset cube count, onset and offset cubes
+    Vec_Wec_t *     vObjCuts;        // for each node, the truth table ID (or -1 for AND, -2 for const) and leaves
+    Vec_Int_t *     vObjSigs;        // for each object, its fanins and the mark used in the last call
+    Vec_Str_t *     vObjFlags;       // for each object, 1 if changed, 2 if its cone changed
+    Vec_Ptr_t *     vLeaves;         // temporary leaves
+    Vec_Ptr_t *     vNodes;          // temporary nodes
+    Vec_Int_t *     vCover;          // temporary cover
+    int             nCutsReused;     // the number of cuts reused
+    int             nCutsDerived;    // the number of cuts derived
+    int             nIsopsReused;    // the number of ISOPs found in the cache
+};
 
 static inline Dar_Cut_t *  Dar_ObjBestCut( Aig_Obj_t * pObj ) { Dar_Cut_t * pCut; int i; Dar_ObjForEachCut( pObj, pCut, i ) if ( pCut->fBest ) return pCut; return NULL; }
 
@@ -148,6 +164,9 @@ extern void            Cnf_ComputeClauses( Aig_Man_t * p, Aig_Obj_t * pRoot, Vec
                            Vec_Ptr_t * vNodes, Vec_Int_t * vMap, Vec_Int_t * vCover, Vec_Int_t * vClauses );
 extern void            Cnf_DeriveFastMark( Aig_Man_t * p );
 extern Cnf_Dat_t *     Cnf_DeriveFast( Aig_Man_t * p, int nOutputs );
+extern Cnf_FastMan_t * Cnf_FastManStart();
+extern void            Cnf_FastManStop( Cnf_FastMan_t * p );
+extern Cnf_Dat_t *     Cnf_DeriveFastWithMan( Cnf_FastMan_t * p, Aig_Man_t * pAig, int nOutputs );
 /*=== cnfMan.c ========================================================*/
 extern Cnf_Man_t *     Cnf_ManStart();
 extern void            Cnf_ManStop( Cnf_Man_t * p );
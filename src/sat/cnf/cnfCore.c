@@ -20,6 +20,16 @@
 
 #include "cnf.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 
@@ -27,16 +37,31 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#ifdef ABC_USE_PTHREADS
+// each thread uses its own manager, which is stopped when the thread exits
+static pthread_key_t  s_CnfKey;
+static pthread_once_t s_CnfKeyOnce = PTHREAD_ONCE_INIT;
+static void Cnf_ManKeyStop( void * p )                   { Cnf_ManStop( (Cnf_Man_t *)p );                                                                  }
+static void Cnf_ManKeyStart()                            { int status = pthread_key_create( &s_CnfKey, Cnf_ManKeyStop ); assert( status == 0 ); (void)status; }
+static inline Cnf_Man_t * Cnf_ManCur()                   { pthread_once( &s_CnfKeyOnce, Cnf_ManKeyStart ); return (Cnf_Man_t *)pthread_getspecific( s_CnfKey ); }
+static inline void        Cnf_ManSetCur( Cnf_Man_t * p ) { pthread_once( &s_CnfKeyOnce, Cnf_ManKeyStart ); pthread_setspecific( s_CnfKey, p );               }
+#else
 static Cnf_Man_t * s_pManCnf = NULL;
+static inline Cnf_Man_t * Cnf_ManCur()                   { return s_pManCnf;                                                                               }
+static inline void        Cnf_ManSetCur( Cnf_Man_t * p ) { s_pManCnf = p;                                                                                  }
+#endif
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Returns the CNF manager of the calling thread.]
 
-  Description []
+  Description [The manager keeps scratch data of the last call and is
+  therefore private to each thread. Cnf_ManFree() stops the manager
+  of the calling thread; with pthreads, the managers of other threads
+  are stopped when these threads exit.]
                
   SideEffects []
 
@@ -45,22 +70,22 @@ static Cnf_Man_t * s_pManCnf = NULL;
 ***********************************************************************/
 void Cnf_ManPrepare()
 {
-    if ( s_pManCnf == NULL )
+    if ( Cnf_ManCur() == NULL )
     {
 //        printf( "\n\nCreating CNF manager!!!!!\n\n" );
-        s_pManCnf = Cnf_ManStart();
+        Cnf_ManSetCur( Cnf_ManStart() );
     }
 }
 Cnf_Man_t * Cnf_ManRead()
 {
-    return s_pManCnf;
+    return Cnf_ManCur();
 }
 void Cnf_ManFree()
 {
-    if ( s_pManCnf == NULL )
+    if ( Cnf_ManCur() == NULL )
         return;
-    Cnf_ManStop( s_pManCnf );
-    s_pManCnf = NULL;
+    Cnf_ManStop( Cnf_ManCur() );
+    Cnf_ManSetCur( NULL );
 }
 
 
@@ -165,7 +190,7 @@ p->timeSave = Abc_Clock() - clk;
 Cnf_Dat_t * Cnf_Derive( Aig_Man_t * pAig, int nOutputs )
 {
     Cnf_ManPrepare();
-    return Cnf_DeriveWithMan( s_pManCnf, pAig, nOutputs );
+    return Cnf_DeriveWithMan( Cnf_ManCur(), pAig, nOutputs );
 }
  
 /**Function*************************************************************
@@ -219,7 +244,7 @@ p->timeSave = Abc_Clock() - clk;
 Cnf_Dat_t * Cnf_DeriveOther( Aig_Man_t * pAig, int fSkipTtMin )
 {
     Cnf_ManPrepare();
-    return Cnf_DeriveOtherWithMan( s_pManCnf, pAig, fSkipTtMin );
+    return Cnf_DeriveOtherWithMan( Cnf_ManCur(), pAig, fSkipTtMin );
 }
 
 #if 0
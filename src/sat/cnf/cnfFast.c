@@ -530,6 +530,276 @@ int Cnf_CountCnfSize( Aig_Man_t * p )
     return nClauses;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Starts and stops the incremental fast CNF manager.]
+
+  Description [The manager caches the ISOPs of cut functions, which do
+  not depend on the AIG, and the cuts of marked nodes, which are reused
+  in the next call if the cone of the node did not change.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Cnf_FastMan_t * Cnf_FastManStart()
+{
+    Cnf_FastMan_t * p;
+    p = ABC_CALLOC( Cnf_FastMan_t, 1 );
+    p->vTtMem    = Vec_MemAlloc( 2, 12 );
+    Vec_MemHashAlloc( p->vTtMem, 10000 );
+    p->vTtIsops  = Vec_WecAlloc( 1000 );
+    p->vObjCuts  = Vec_WecAlloc( 1000 );
+    p->vObjSigs  = Vec_IntAlloc( 3000 );
+    p->vObjFlags = Vec_StrAlloc( 1000 );
+    p->vLeaves   = Vec_PtrAlloc( 100 );
+    p->vNodes    = Vec_PtrAlloc( 100 );
+    p->vCover    = Vec_IntAlloc( 1 << 16 );
+    return p;
+}
+void Cnf_FastManStop( Cnf_FastMan_t * p )
+{
+    Vec_MemHashFree( p->vTtMem );
+    Vec_MemFree( p->vTtMem );
+    Vec_WecFree( p->vTtIsops );
+    Vec_WecFree( p->vObjCuts );
+    Vec_IntFree( p->vObjSigs );
+    Vec_StrFree( p->vObjFlags );
+    Vec_PtrFree( p->vLeaves );
+    Vec_PtrFree( p->vNodes );
+    Vec_IntFree( p->vCover );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Finds the objects whose cones changed since the last call.]
+
+  Description [The object is changed if it is new, or if its fanins or
+  its mark are different. The cone of a marked node is the same if the
+  node, its leaves, and the unmarked nodes inside the cone are not changed.
+  Marks should be computed before calling this procedure.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Cnf_FastManObjFlags( Cnf_FastMan_t * p, Aig_Obj_t * pObj ) { return Vec_StrEntry( p->vObjFlags, Aig_ObjId(pObj) ); }
+int Cnf_FastManConeChanged_rec( Cnf_FastMan_t * p, Aig_Obj_t * pObj )
+{
+    Aig_Obj_t * pFanin;
+    int k, Flags = Cnf_FastManObjFlags( p, pObj );
+    if ( Flags & 4 ) // already computed
+        return (Flags & 2) > 0;
+    assert( Aig_ObjIsNode(pObj) );
+    for ( k = 0; k < 2; k++ )
+    {
+        pFanin = k ? Aig_ObjFanin1(pObj) : Aig_ObjFanin0(pObj);
+        if ( pFanin->fMarkA ? (Cnf_FastManObjFlags(p, pFanin) & 1) : Cnf_FastManConeChanged_rec(p, pFanin) )
+            Flags |= 2;
+    }
+    if ( Flags & 1 )
+        Flags |= 2;
+    Vec_StrWriteEntry( p->vObjFlags, Aig_ObjId(pObj), (char)(Flags | 4) );
+    return (Flags & 2) > 0;
+}
+void Cnf_FastManUpdate( Cnf_FastMan_t * p, Aig_Man_t * pAig )
+{
+    Aig_Obj_t * pObj;
+    int i, Sig0, Sig1, * pSig, nObjs = Aig_ManObjNumMax(pAig);
+    // the signatures are structural, so they can be compared against another AIG,
+    // for example, the next one derived by the caller; start from scratch if it is smaller
+    if ( 3 * nObjs < Vec_IntSize(p->vObjSigs) )
+    {
+        Vec_WecClear( p->vObjCuts );
+        Vec_IntClear( p->vObjSigs );
+    }
+    Vec_WecInit( p->vObjCuts, nObjs );
+    Vec_IntFillExtra( p->vObjSigs, 3 * nObjs, -1 );
+    Vec_StrFill( p->vObjFlags, nObjs, 0 );
+    // find changed objects and record their signatures
+    for ( i = 0; i < nObjs; i++ )
+    {
+        pObj = Aig_ManObj( pAig, i );
+        pSig = Vec_IntEntryP( p->vObjSigs, 3 * i );
+        if ( pObj == NULL )
+        {
+            pSig[0] = pSig[1] = pSig[2] = -1;
+            continue;
+        }
+        Sig0 = Aig_ObjIsNode(pObj) ? Abc_Var2Lit( Aig_ObjFaninId0(pObj), Aig_ObjFaninC0(pObj) ) : -2 - (int)Aig_ObjIsCi(pObj);
+        Sig1 = Aig_ObjIsNode(pObj) ? Abc_Var2Lit( Aig_ObjFaninId1(pObj), Aig_ObjFaninC1(pObj) ) : -2;
+        if ( pSig[0] != Sig0 || pSig[1] != Sig1 || pSig[2] != (int)pObj->fMarkA )
+            Vec_StrWriteEntry( p->vObjFlags, i, 1 );
+        if ( !Aig_ObjIsNode(pObj) ) // the cone of a non-node is the object itself
+            Vec_StrWriteEntry( p->vObjFlags, i, (char)(Vec_StrEntry(p->vObjFlags, i) ? 7 : 4) );
+        pSig[0] = Sig0;
+        pSig[1] = Sig1;
+        pSig[2] = (int)pObj->fMarkA;
+    }
+    // find marked nodes whose cones changed
+    Aig_ManForEachNode( pAig, pObj, i )
+        if ( pObj->fMarkA )
+            Cnf_FastManConeChanged_rec( p, pObj );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the ID of the ISOPs of the cut function.]
+
+  Description [The ISOPs are computed only for the functions not seen before.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Cnf_FastManIsopId( Cnf_FastMan_t * p, word Truth, int nLeaves )
+{
+    word Key[2] = { Truth, (word)nLeaves };
+    Vec_Int_t * vIsop;
+    int i, RetValue, iTruth, nEntries = Vec_MemEntryNum( p->vTtMem );
+    iTruth = Vec_MemHashInsert( p->vTtMem, Key );
+    if ( iTruth < nEntries )
+    {
+        p->nIsopsReused++;
+        return iTruth;
+    }
+    assert( iTruth == Vec_WecSize(p->vTtIsops) );
+    vIsop = Vec_WecPushLevel( p->vTtIsops );
+    for ( i = 0; i < 2; i++, Truth = ~Truth )
+    {
+        RetValue = Kit_TruthIsop( (unsigned *)&Truth, nLeaves, p->vCover, 0 );
+        assert( RetValue >= 0 );
+        if ( i == 0 )
+            Vec_IntPush( vIsop, Vec_IntSize(p->vCover) );
+        Vec_IntAppend( vIsop, p->vCover );
+    }
+    return iTruth;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the cut of the marked node.]
+
+  Description [Similar to Cnf_ComputeClauses() but records the cut instead
+  of the clauses: the first entry is the ISOP ID (followed by the leaf IDs),
+  or -1 for the multi-input AND (followed by the leaf literals), or -2 for
+  the constant (followed by its value).]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Cnf_FastManDeriveCut( Cnf_FastMan_t * p, Aig_Man_t * pAig, Aig_Obj_t * pRoot, Vec_Int_t * vCut )
+{
+    Aig_Obj_t * pLeaf;
+    word Truth;
+    int k;
+    assert( pRoot->fMarkA );
+    Vec_IntClear( vCut );
+    // detect cone
+    Cnf_CollectLeaves( pRoot, p->vLeaves, 0 );
+    Cnf_CollectVolume( pAig, pRoot, p->vLeaves, p->vNodes );
+    assert( pRoot == Vec_PtrEntryLast(p->vNodes) );
+    // check if this is an AND-gate
+    Vec_PtrForEachEntry( Aig_Obj_t *, p->vNodes, pLeaf, k )
+    {
+        if ( Aig_ObjFaninC0(pLeaf) && !Aig_ObjFanin0(pLeaf)->fMarkA )
+            break;
+        if ( Aig_ObjFaninC1(pLeaf) && !Aig_ObjFanin1(pLeaf)->fMarkA )
+            break;
+    }
+    if ( k == Vec_PtrSize(p->vNodes) )
+    {
+        Cnf_CollectLeaves( pRoot, p->vLeaves, 1 );
+        Vec_IntPush( vCut, -1 );
+        Vec_PtrForEachEntry( Aig_Obj_t *, p->vLeaves, pLeaf, k )
+            Vec_IntPush( vCut, Abc_Var2Lit(Aig_ObjId(Aig_Regular(pLeaf)), Aig_IsComplement(pLeaf)) );
+        return;
+    }
+    if ( Vec_PtrSize(p->vLeaves) > 6 )
+        printf( "FastCnfGeneration:  Internal error!!!\n" );
+    assert( Vec_PtrSize(p->vLeaves) <= 6 );
+    Truth = Cnf_CutDeriveTruth( pAig, p->vLeaves, p->vNodes );
+    if ( Truth == 0 || Truth == ~(word)0 )
+    {
+        Vec_IntPush( vCut, -2 );
+        Vec_IntPush( vCut, Truth != 0 );
+        return;
+    }
+    Vec_IntPush( vCut, Cnf_FastManIsopId(p, Truth, Vec_PtrSize(p->vLeaves)) );
+    Vec_PtrForEachEntry( Aig_Obj_t *, p->vLeaves, pLeaf, k )
+        Vec_IntPush( vCut, Aig_ObjId(pLeaf) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives clauses of the marked node using the cached cut.]
+
+  Description [Produces the same clauses as Cnf_ComputeClauses().]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Cnf_FastManComputeClauses( Cnf_FastMan_t * p, Aig_Man_t * pAig, Aig_Obj_t * pRoot, Vec_Int_t * vMap, Vec_Int_t * vClauses )
+{
+    Vec_Int_t * vCut = Vec_WecEntry( p->vObjCuts, Aig_ObjId(pRoot) );
+    Vec_Int_t * vIsop;
+    int c, k, Cube, Entry, OutLit, nLeaves, nCubes0;
+    if ( Vec_IntSize(vCut) == 0 || (Cnf_FastManObjFlags(p, pRoot) & 2) )
+    {
+        Cnf_FastManDeriveCut( p, pAig, pRoot, vCut );
+        p->nCutsDerived++;
+    }
+    else
+        p->nCutsReused++;
+    Vec_IntClear( vClauses );
+    OutLit  = Cnf_ObjGetLit( vMap, pRoot, 0 );
+    nLeaves = Vec_IntSize(vCut) - 1;
+    if ( Vec_IntEntry(vCut, 0) == -1 ) // multi-input AND
+    {
+        // write big clause
+        Vec_IntPush( vClauses, 0 );
+        Vec_IntPush( vClauses, OutLit );
+        Vec_IntForEachEntryStart( vCut, Entry, k, 1 )
+            Vec_IntPush( vClauses, Cnf_ObjGetLit(vMap, Aig_ManObj(pAig, Abc_Lit2Var(Entry)), !Abc_LitIsCompl(Entry)) );
+        // write small clauses
+        Vec_IntForEachEntryStart( vCut, Entry, k, 1 )
+        {
+            Vec_IntPush( vClauses, 0 );
+            Vec_IntPush( vClauses, OutLit ^ 1 );
+            Vec_IntPush( vClauses, Cnf_ObjGetLit(vMap, Aig_ManObj(pAig, Abc_Lit2Var(Entry)), Abc_LitIsCompl(Entry)) );
+        }
+        return;
+    }
+    if ( Vec_IntEntry(vCut, 0) == -2 ) // constant
+    {
+        Vec_IntPush( vClauses, 0 );
+        Vec_IntPush( vClauses, Vec_IntEntry(vCut, 1) ? OutLit : (OutLit ^ 1) );
+        return;
+    }
+    vIsop   = Vec_WecEntry( p->vTtIsops, Vec_IntEntry(vCut, 0) );
+    nCubes0 = Vec_IntEntry( vIsop, 0 );
+    Vec_IntForEachEntryStart( vIsop, Cube, c, 1 )
+    {
+        Vec_IntPush( vClauses, 0 );
+        Vec_IntPush( vClauses, c <= nCubes0 ? OutLit : (OutLit ^ 1) );
+        for ( k = 0; k < nLeaves; k++, Cube >>= 2 )
+        {
+            if ( (Cube & 3) == 0 )
+                continue;
+            assert( (Cube & 3) != 3 );
+            Vec_IntPush( vClauses, Cnf_ObjGetLit(vMap, Aig_ManObj(pAig, Vec_IntEntry(vCut, k+1)), (Cube&3)!=1) );
+        }
+    }
+}
+
 /**Function*************************************************************
 
   Synopsis    [Derives CNF from the marked AIG.]
@@ -542,7 +812,7 @@ int Cnf_CountCnfSize( Aig_Man_t * p )
   SeeAlso     []
 
 ***********************************************************************/
-Cnf_Dat_t * Cnf_DeriveFastClauses( Aig_Man_t * p, int nOutputs )
+Cnf_Dat_t * Cnf_DeriveFastClausesInt( Cnf_FastMan_t * pMan, Aig_Man_t * p, int nOutputs )
 {
     Cnf_Dat_t * pCnf;
     Vec_Int_t * vLits, * vClas, * vMap, * vTemp;
@@ -586,11 +856,16 @@ Cnf_Dat_t * Cnf_DeriveFastClauses( Aig_Man_t * p, int nOutputs )
     vNodes  = Vec_PtrAlloc( 100 );
     vCover  = Vec_IntAlloc( 1 << 16 );
     vTemp   = Vec_IntAlloc( 100 );
+    if ( pMan )
+        Cnf_FastManUpdate( pMan, p );
     Aig_ManForEachNodeReverse( p, pObj, i )
     {
         if ( !pObj->fMarkA )
             continue;
-        Cnf_ComputeClauses( p, pObj, vLeaves, vNodes, vMap, vCover, vTemp );
+        if ( pMan )
+            Cnf_FastManComputeClauses( pMan, p, pObj, vMap, vTemp );
+        else
+            Cnf_ComputeClauses( p, pObj, vLeaves, vNodes, vMap, vCover, vTemp );
         Vec_IntForEachEntry( vTemp, Entry, k )
         {
             if ( Entry == 0 )
@@ -651,6 +926,10 @@ Cnf_Dat_t * Cnf_DeriveFastClauses( Aig_Man_t * p, int nOutputs )
     Vec_IntFree( vMap );
     return pCnf;
 }
+Cnf_Dat_t * Cnf_DeriveFastClauses( Aig_Man_t * p, int nOutputs )
+{
+    return Cnf_DeriveFastClausesInt( NULL, p, nOutputs );
+}
 
 /**Function*************************************************************
 
@@ -688,6 +967,30 @@ Cnf_Dat_t * Cnf_DeriveFast( Aig_Man_t * p, int nOutputs )
     return pCnf;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Fast CNF computation using the incremental manager.]
+
+  Description [Same as Cnf_DeriveFast() but reuses the ISOPs computed
+  in the previous calls, as well as the cuts of the nodes whose cones did
+  not change since the previous call. The cones are compared by object
+  IDs and fanins, so the AIG may be a new one derived the same way.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Cnf_Dat_t * Cnf_DeriveFastWithMan( Cnf_FastMan_t * p, Aig_Man_t * pAig, int nOutputs )
+{
+    Cnf_Dat_t * pCnf;
+    Aig_ManCleanMarkAB( pAig );
+    Cnf_DeriveFastMark( pAig );
+    pCnf = Cnf_DeriveFastClausesInt( p, pAig, nOutputs );
+    Aig_ManCleanMarkA( pAig );
+    return pCnf;
+}
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
@@ -252,6 +252,14 @@ void bmcg2_sat_solver_set_conflict_budget(bmcg2_sat_solver* s, int Limit)
         ((Gluco2::SimpSolver*)s)->budgetOff();
 }
 
+void bmcg2_sat_solver_set_prop_budget(bmcg2_sat_solver* s, ABC_INT64_T Limit)
+{
+    if ( Limit > 0 ) 
+        ((Gluco2::SimpSolver*)s)->setPropBudget( (int64_t)Limit );
+    else 
+        ((Gluco2::SimpSolver*)s)->propBudgetOff();
+}
+
 int bmcg2_sat_solver_varnum(bmcg2_sat_solver* s)
 {
     return ((Gluco2::SimpSolver*)s)->nVars();
@@ -268,6 +276,10 @@ int bmcg2_sat_solver_conflictnum(bmcg2_sat_solver* s)
 {
     return ((Gluco2::SimpSolver*)s)->conflicts;
 }
+ABC_INT64_T bmcg2_sat_solver_propagationnum(bmcg2_sat_solver* s)
+{
+    return (ABC_INT64_T)((Gluco2::SimpSolver*)s)->propagations;
+}
 
 int bmcg2_sat_solver_minimize_assumptions( bmcg2_sat_solver * s, int * plits, int nlits, int pivot )
 {
@@ -604,6 +616,14 @@ void bmcg2_sat_solver_set_conflict_budget(bmcg2_sat_solver* s, int Limit)
         ((Gluco2::Solver*)s)->budgetOff();
 }
 
+void bmcg2_sat_solver_set_prop_budget(bmcg2_sat_solver* s, ABC_INT64_T Limit)
+{
+    if ( Limit > 0 ) 
+        ((Gluco2::Solver*)s)->setPropBudget( (int64_t)Limit );
+    else 
+        ((Gluco2::Solver*)s)->propBudgetOff();
+}
+
 int bmcg2_sat_solver_varnum(bmcg2_sat_solver* s)
 {
     return ((Gluco2::Solver*)s)->nVars();
@@ -620,6 +640,10 @@ int bmcg2_sat_solver_conflictnum(bmcg2_sat_solver* s)
 {
     return ((Gluco2::Solver*)s)->conflicts;
 }
+ABC_INT64_T bmcg2_sat_solver_propagationnum(bmcg2_sat_solver* s)
+{
+    return (ABC_INT64_T)((Gluco2::Solver*)s)->propagations;
+}
 
 int bmcg2_sat_solver_minimize_assumptions( bmcg2_sat_solver * s, int * plits, int nlits, int pivot )
 {
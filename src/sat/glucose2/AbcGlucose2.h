@@ -89,10 +89,12 @@ extern void              bmcg2_sat_solver_set_stop( bmcg2_sat_solver* s, int * p
 extern void              bmcg2_sat_solver_markapprox(bmcg2_sat_solver* s, int v0, int v1, int nlim);
 extern abctime           bmcg2_sat_solver_set_runtime_limit( bmcg2_sat_solver* s, abctime Limit );
 extern void              bmcg2_sat_solver_set_conflict_budget( bmcg2_sat_solver* s, int Limit );
+extern void              bmcg2_sat_solver_set_prop_budget( bmcg2_sat_solver* s, ABC_INT64_T Limit );
 extern int               bmcg2_sat_solver_varnum( bmcg2_sat_solver* s );
 extern int               bmcg2_sat_solver_clausenum( bmcg2_sat_solver* s );
 extern int               bmcg2_sat_solver_learntnum( bmcg2_sat_solver* s );
 extern int               bmcg2_sat_solver_conflictnum( bmcg2_sat_solver* s );
+extern ABC_INT64_T       bmcg2_sat_solver_propagationnum( bmcg2_sat_solver* s );
 extern int               bmcg2_sat_solver_minimize_assumptions( bmcg2_sat_solver * s, int * plits, int nlits, int pivot );
 extern int               bmcg2_sat_solver_add_and( bmcg2_sat_solver * s, int iVar, int iVar0, int iVar1, int fCompl0, int fCompl1, int fCompl );
 extern int               bmcg2_sat_solver_add_xor( bmcg2_sat_solver * s, int iVarA, int iVarB, int iVarC, int fCompl );
@@ -24,6 +24,13 @@ ABC_NAMESPACE_IMPL_START
 //===------------------------------------------------------------------------===
 // Lit funtions
 //===------------------------------------------------------------------------===
+/** Returns the value of a literal given the assignment array (used in the
+ *  propagation loop, which reads the array directly) */
+static inline char lit_value_fast(const char *assigns, unsigned lit)
+{
+    return lit_polarity(lit) ^ assigns[lit2var(lit)];
+}
+
 /**
  *  A literal is said to be redundant in a given clause if and only if all
  *  variables in its reason are either present in that clause or (recursevely)
@@ -533,6 +540,12 @@ void solver_cancel_until(solver_t *s, unsigned level)
 
 unsigned solver_propagate(solver_t *s)
 {
+    /* The assignment array is not reallocated during propagation, so it is
+     * read directly; the watchers of binary clauses are kept at the beginning
+     * of each watch list and their blocker is the other literal, so they are
+     * processed without touching the clause database. */
+    char *assigns = vec_char_data(s->assigns);
+    int has_marks = solver_has_marks(s);
     unsigned conf_cref = UNDEF;
     unsigned *lits;
     unsigned neg_lit;
@@ -540,33 +553,35 @@ unsigned solver_propagate(solver_t *s)
 
     while (s->i_qhead < vec_uint_size(s->trail)) {
         unsigned p = vec_uint_at(s->trail, s->i_qhead++);
-        struct watch_list *ws;
-        struct watcher *begin;
-        struct watcher *end;
+        struct watch_list *ws = vec_wl_at(s->watches, p);
+        struct watcher *begin = watch_list_array(ws);
+        struct watcher *end = begin + ws->n_bin;
         struct watcher *i, *j;
 
         n_propagations++;
-        watch_list_foreach_bin(s->watches, i, p) {
-            if (solver_has_marks(s) && !var_mark(s, lit2var(i->blocker)))
+        for (i = begin; i < end; i++) {
+            unsigned blocker = i->blocker;
+            char value = assigns[lit2var(blocker)];
+            if (has_marks && !var_mark(s, lit2var(blocker)))
                 continue;
-            if (var_value(s, lit2var(i->blocker)) == SATOKO_VAR_UNASSING)
-                solver_enqueue(s, i->blocker, i->cref);
-            else if (lit_value(s, i->blocker) == SATOKO_LIT_FALSE)
+            if (value == SATOKO_VAR_UNASSING)
+                solver_enqueue(s, blocker, i->cref);
+            else if ((lit_polarity(blocker) ^ value) == SATOKO_LIT_FALSE)
                 return i->cref;
         }
 
-        ws = vec_wl_at(s->watches, p);
-        begin = watch_list_array(ws);
+        neg_lit = lit_compl(p);
         end = begin + watch_list_size(ws);
         for (i = j = begin + ws->n_bin; i < end;) {
             struct clause *clause;
             struct watcher w;
+            unsigned k, size;
 
-            if (solver_has_marks(s) && !var_mark(s, lit2var(i->blocker))) {
+            if (has_marks && !var_mark(s, lit2var(i->blocker))) {
                 *j++ = *i++;
                 continue;
             }
-            if (lit_value(s, i->blocker) == SATOKO_LIT_TRUE) {
+            if (lit_value_fast(assigns, i->blocker) == SATOKO_LIT_TRUE) {
                 *j++ = *i++;
                 continue;
             }
@@ -575,7 +590,6 @@ unsigned solver_propagate(solver_t *s)
             lits = &(clause->data[0].lit);
 
             // Make sure the false literal is data[1]:
-            neg_lit = lit_compl(p);
             if (lits[0] == neg_lit)
                 stk_swap(unsigned, lits[0], lits[1]);
             assert(lits[1] == neg_lit);
@@ -584,13 +598,13 @@ unsigned solver_propagate(solver_t *s)
             w.blocker = lits[0];
 
             /* If 0th watch is true, then clause is already satisfied. */
-            if (lits[0] != i->blocker && lit_value(s, lits[0]) == SATOKO_LIT_TRUE)
+            if (lits[0] != i->blocker && lit_value_fast(assigns, lits[0]) == SATOKO_LIT_TRUE)
                 *j++ = w;
             else {
                 /* Look for new watch */
-                unsigned k;
-                for (k = 2; k < clause->size; k++) {
-                    if (lit_value(s, lits[k]) != SATOKO_LIT_FALSE) {
+                size = clause->size;
+                for (k = 2; k < size; k++) {
+                    if (lit_value_fast(assigns, lits[k]) != SATOKO_LIT_FALSE) {
                         lits[1] = lits[k];
                         lits[k] = neg_lit;
                         watch_list_push(vec_wl_at(s->watches, lit_compl(lits[1])), w, 0);
@@ -601,7 +615,7 @@ unsigned solver_propagate(solver_t *s)
                 *j++ = w;
 
                 /* Clause becomes unit under this assignment */
-                if (lit_value(s, lits[0]) == SATOKO_LIT_FALSE) {
+                if (lit_value_fast(assigns, lits[0]) == SATOKO_LIT_FALSE) {
                     conf_cref = i->cref;
                     s->i_qhead = vec_uint_size(s->trail);
                     i++;